@@ -939,140 +939,8 @@ const bitmap_128_t tetris_bitmap_def_field_layer = {
 };
 
 //======================================================
-// bitmap定数定義・テトリミノ&ボックス
+// bitmap定数定義・テトリミノ
 //======================================================
-// 演算用テトリミノ
-const bitmap_128_t tetris_bitmap_def_mino = {
-    {0x0404800000000000, 0x0000000000000000},
-    {0x0404800000000000, 0x0000000000000000},
-    {0xF4F4800000000000, 0x0000000000000000},
-    {0x0404800000000000, 0x0000000000000000},
-    {0x0000400000000000, 0x0000000000000000},
-    {0x86E4400000000000, 0x0000000000000000},
-    {0xE424400000000000, 0x0000000000000000},
-    {0x040C400000000000, 0x0000000000000000},
-    {0x0000200000000000, 0x0000000000000000},
-    {0x24EC200000000000, 0x0000000000000000},
-    {0xE484200000000000, 0x0000000000000000},
-    {0x0604200000000000, 0x0000000000000000},
-    {0x0000100000000000, 0x0000000000000000},
-    {0x6666100000000000, 0x0000000000000000},
-    {0x6666100000000000, 0x0000000000000000},
-    {0x0000100000000000, 0x0000000000000000},
-    {0x0808080000000000, 0x0000000000000000},
-    {0x6C6C080000000000, 0x0000000000000000},
-    {0xC4C4080000000000, 0x0000000000000000},
-    {0x0000080000000000, 0x0000000000000000},
-    {0x0000040000000000, 0x0000000000000000},
-    {0x4404040000000000, 0x0000000000000000},
-    {0xE6EC040000000000, 0x0000000000000000},
-    {0x0444040000000000, 0x0000000000000000},
-    {0x0404020000000000, 0x0000000000000000},
-    {0xCCCC020000000000, 0x0000000000000000},
-    {0x6868020000000000, 0x0000000000000000},
-    {0x0000020000000000, 0x0000000000000000},
-    {0xF000000000000000, 0x0000000000000000},
-    {0x0F00000000000000, 0x0000000000000000},
-    {0x00F0000000000000, 0x0000000000000000},
-    {0x000F000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-};
-
 // ネクスト表示用テトリミノ（前半）
 const bitmap_128_t tetris_bitmap_def_next_mino_1 = {
     {0x00000003F0000000, 0x0003F00000000000},
@@ -1335,274 +1203,4 @@ const bitmap_128_t tetris_bitmap_def_next_mino_2 = {
     {0x0000000000000000, 0x0000000000000000},
     {0x0000000000000000, 0x0000000000000000},
     {0x0000000000000000, 0x0000000000000000},
-};
-
-// 演算用ボックス
-const bitmap_128_t tetris_bitmap_def_box = {
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0x8010000000000000, 0x0000000000000000},
-    {0xFFF0000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-};
-
-// ゲームオーバー判定用レイヤ　オーバーレイして重なりがあるかを見る
-const bitmap_128_t tetris_bitmap_def_check_box_full_layer = {
-    {0x7FE0000000000000, 0x0000000000000000},
-    {0x7FE0000000000000, 0x0000000000000000},
-    {0x7FE0000000000000, 0x0000000000000000},
-    {0x7FE0000000000000, 0x0000000000000000},
-    {0x7FE0000000000000, 0x0000000000000000},
-    {0x7FE0000000000000, 0x0000000000000000},
-    {0x7FE0000000000000, 0x0000000000000000},
-    {0x7FE0000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-    {0x0000000000000000, 0x0000000000000000},
-};
-
-//======================================================
-// 定数定義・汎用
-//======================================================
-// 0初期化用ビットマップ
-const bitmap_128_t tetris_bitmap_def_zero = {0};
\ No newline at end of file
+};
\ No newline at end of file
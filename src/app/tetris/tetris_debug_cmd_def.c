@@ -29,15 +29,38 @@
 static void enable_game_pause(const DEBUG_COM_debug_frame_t *receive_frame);
 static void read_register(const DEBUG_COM_debug_frame_t *receive_frame);
 static void read_game_state(const DEBUG_COM_debug_frame_t *receive_frame);
+static void enable_autoplay(const DEBUG_COM_debug_frame_t *receive_frame);
+static void read_autoplay_search_time(const DEBUG_COM_debug_frame_t *receive_frame);
+static void read_lock_statistics(const DEBUG_COM_debug_frame_t *receive_frame);
+static void read_lock_process_time(const DEBUG_COM_debug_frame_t *receive_frame);
+static void read_frame_process_time(const DEBUG_COM_debug_frame_t *receive_frame);
+static void read_snapshot_time(const DEBUG_COM_debug_frame_t *receive_frame);
+static void read_score_log_time(const DEBUG_COM_debug_frame_t *receive_frame);
+static void read_high_score_table(const DEBUG_COM_debug_frame_t *receive_frame);
+static void read_boot_time(const DEBUG_COM_debug_frame_t *receive_frame);
+static void read_play_statistics(const DEBUG_COM_debug_frame_t *receive_frame);
+static void read_frame_sent_bytes(const DEBUG_COM_debug_frame_t *receive_frame);
+static void set_uint32_little_endian(uint8_t *dst, uint32_t value);
 
 //======================================================
 // 変数・定数
 //======================================================
 // コマンドリスト：cmd番号,cmd実行関数を定義
 const cmd_list_t tetris_cmd_list[] = {
-    {0x55, enable_game_pause}, // ポーズ有効・無効
-    {0x56, read_game_state},   // ゲームステート読み出し
-    {0x60, read_register},     // 汎用レジスタ読み出し
+    {0x55, enable_game_pause},         // ポーズ有効・無効
+    {0x56, read_game_state},           // ゲームステート読み出し
+    {0x57, enable_autoplay},           // 自動操作有効・無効
+    {0x58, read_autoplay_search_time}, // 自動操作 配置探索時間読み出し
+    {0x59, read_lock_statistics},      // 固定タイミング統計読み出し
+    {0x5A, read_lock_process_time},    // ミノ固定処理時間読み出し
+    {0x5B, read_frame_process_time},   // フレーム処理時間読み出し
+    {0x5C, read_snapshot_time},        // スナップショット保存時間読み出し
+    {0x5D, read_score_log_time},       // ハイスコアログ フラッシュ処理時間読み出し
+    {0x5E, read_high_score_table},     // ハイスコア読み出し
+    {0x5F, read_boot_time},            // 起動時間読み出し
+    {0x60, read_register},             // 汎用レジスタ読み出し
+    {0x61, read_play_statistics},      // プレイ統計読み出し
+    {0x62, read_frame_sent_bytes},     // フレーム送信バイト数読み出し
 };
 
 //======================================================
@@ -80,6 +103,228 @@ static void read_game_state(const DEBUG_COM_debug_frame_t *receive_frame)
     DEBUG_COM_send(receive_frame->cmd, 1, &game_state);
 }
 
+/**
+ * @brief 自動操作有効化コマンド実行
+ * @param receive_frame 受信デバッグフレーム
+ * @return なし
+ */
+static void enable_autoplay(const DEBUG_COM_debug_frame_t *receive_frame)
+{
+    bool is_autoplay_enable = receive_frame->data[0];
+    tetris_debug_autoplay_enable(is_autoplay_enable); // tetris_main内関数
+
+    DEBUG_COM_send(receive_frame->cmd, NO_DATA_LEN, NO_DATA);
+}
+
+/**
+ * @brief 自動操作 配置探索時間読出しコマンド実行
+ * @param receive_frame 受信デバッグフレーム
+ * @return なし
+ * @details 最新値[us]、最大値[us]の順に各4byteリトルエンディアンで返す
+ */
+static void read_autoplay_search_time(const DEBUG_COM_debug_frame_t *receive_frame)
+{
+    tetris_autoplay_search_time_t search_time = tetris_get_autoplay_search_time(); // tetris_input_ctrl内関数
+
+    uint8_t response_data[8];
+    response_data[0] = (search_time.latest_us >> 0) & MASK_8BIT;
+    response_data[1] = (search_time.latest_us >> 8) & MASK_8BIT;
+    response_data[2] = (search_time.latest_us >> 16) & MASK_8BIT;
+    response_data[3] = (search_time.latest_us >> 24) & MASK_8BIT;
+    response_data[4] = (search_time.max_us >> 0) & MASK_8BIT;
+    response_data[5] = (search_time.max_us >> 8) & MASK_8BIT;
+    response_data[6] = (search_time.max_us >> 16) & MASK_8BIT;
+    response_data[7] = (search_time.max_us >> 24) & MASK_8BIT;
+
+    DEBUG_COM_send(receive_frame->cmd, sizeof(response_data), response_data);
+}
+
+/**
+ * @brief 固定タイミング統計読出しコマンド実行
+ * @param receive_frame 受信デバッグフレーム
+ * @return なし
+ * @details 固定したミノ数、直近のミノの接地から固定までの時間[us]、直近のミノの固定期限からの遅れ[us]、
+ *          固定期限からの遅れの最大値[us]の順に各4byteリトルエンディアン、最後に直近のミノの猶予延長回数1byteを返す
+ */
+static void read_lock_statistics(const DEBUG_COM_debug_frame_t *receive_frame)
+{
+    TETRIS_CORE_lock_statistics_t statistics = tetris_get_lock_statistics(); // tetris_main内関数
+
+    uint8_t response_data[17];
+    set_uint32_little_endian(&response_data[0], statistics.lock_count);
+    set_uint32_little_endian(&response_data[4], statistics.latest_grounded_us);
+    set_uint32_little_endian(&response_data[8], statistics.latest_late_us);
+    set_uint32_little_endian(&response_data[12], statistics.max_late_us);
+    response_data[16] = statistics.latest_reset_count;
+
+    DEBUG_COM_send(receive_frame->cmd, sizeof(response_data), response_data);
+}
+
+/**
+ * @brief ミノ固定処理時間読出しコマンド実行
+ * @param receive_frame 受信デバッグフレーム
+ * @return なし
+ * @details 計測回数、最新値[us]、最大値[us]の順に各4byteリトルエンディアンで返す
+ */
+static void read_lock_process_time(const DEBUG_COM_debug_frame_t *receive_frame)
+{
+    tetris_lock_process_time_t process_time = tetris_get_lock_process_time(); // tetris_main内関数
+
+    uint8_t response_data[12];
+    set_uint32_little_endian(&response_data[0], process_time.lock_count);
+    set_uint32_little_endian(&response_data[4], process_time.latest_us);
+    set_uint32_little_endian(&response_data[8], process_time.max_us);
+
+    DEBUG_COM_send(receive_frame->cmd, sizeof(response_data), response_data);
+}
+
+/**
+ * @brief フレーム処理時間読出しコマンド実行
+ * @param receive_frame 受信デバッグフレーム
+ * @return なし
+ * @details 最新値[us]、最大値[us]の順に各4byteリトルエンディアンで返す（1人プレイと対戦の比較で盤面数に対する負荷の伸びを見る）
+ */
+static void read_frame_process_time(const DEBUG_COM_debug_frame_t *receive_frame)
+{
+    tetris_frame_process_time_t process_time = tetris_get_frame_process_time(); // tetris_main内関数
+
+    uint8_t response_data[8];
+    set_uint32_little_endian(&response_data[0], process_time.latest_us);
+    set_uint32_little_endian(&response_data[4], process_time.max_us);
+
+    DEBUG_COM_send(receive_frame->cmd, sizeof(response_data), response_data);
+}
+
+/**
+ * @brief スナップショット保存時間読出しコマンド実行
+ * @param receive_frame 受信デバッグフレーム
+ * @return なし
+ * @details 最新値[us]、最大値[us]の順に各4byteリトルエンディアンで返す（演算状態1つ分の構造体コピーの処理時間）
+ */
+static void read_snapshot_time(const DEBUG_COM_debug_frame_t *receive_frame)
+{
+    tetris_snapshot_time_t save_time = tetris_get_snapshot_time(); // tetris_main内関数
+
+    uint8_t response_data[8];
+    set_uint32_little_endian(&response_data[0], save_time.latest_us);
+    set_uint32_little_endian(&response_data[4], save_time.max_us);
+
+    DEBUG_COM_send(receive_frame->cmd, sizeof(response_data), response_data);
+}
+
+/**
+ * @brief ハイスコアログ フラッシュ処理時間読出しコマンド実行
+ * @param receive_frame 受信デバッグフレーム
+ * @return なし
+ * @details ページ書き込みの最新値・最大値、セクタ消去の最新値・最大値の順に各4byteリトルエンディアン[us]で返す
+ *          （フラッシュ操作1ステップ毎の最悪処理時間＝その間メインループが止まる時間の確認用）
+ */
+static void read_score_log_time(const DEBUG_COM_debug_frame_t *receive_frame)
+{
+    tetris_score_log_time_t log_time = tetris_get_score_log_time(); // tetris_score_log内関数
+
+    uint8_t response_data[16];
+    set_uint32_little_endian(&response_data[0], log_time.program_time.latest_us);
+    set_uint32_little_endian(&response_data[4], log_time.program_time.max_us);
+    set_uint32_little_endian(&response_data[8], log_time.erase_time.latest_us);
+    set_uint32_little_endian(&response_data[12], log_time.erase_time.max_us);
+
+    DEBUG_COM_send(receive_frame->cmd, sizeof(response_data), response_data);
+}
+
+/**
+ * @brief ハイスコア読出しコマンド実行
+ * @param receive_frame 受信デバッグフレーム（data[0]：ゲームモード、data[1]：順位（0始まり））
+ * @return なし
+ * @details 指定モード・順位のハイスコアの記録値・記録IDを各4byteリトルエンディアンで返す（記録IDが0なら空き）
+ *          ハイスコアを記録しないモード・範囲外の順位の場合は何も返さない
+ */
+static void read_high_score_table(const DEBUG_COM_debug_frame_t *receive_frame)
+{
+    const tetris_high_score_t *table = tetris_get_high_score_table((tetris_game_mode_t)receive_frame->data[0]); // tetris_score_log内関数
+    uint8_t rank = receive_frame->data[1];
+    if (NULL == table || TETRIS_HIGH_SCORE_TABLE_LENGTH <= rank)
+        return;
+
+    uint8_t response_data[8];
+    set_uint32_little_endian(&response_data[0], table[rank].value);
+    set_uint32_little_endian(&response_data[4], table[rank].record_id);
+
+    DEBUG_COM_send(receive_frame->cmd, sizeof(response_data), response_data);
+}
+
+/**
+ * @brief 起動時間読出しコマンド実行
+ * @param receive_frame 受信デバッグフレーム
+ * @return なし
+ * @details アプリ開始時刻、ハイスコアログ読み込み時間、ゲーム再開時間、最初のフレームの処理完了時刻の順に各4byteリトルエンディアン[us]で返す
+ *          （ゲーム再開時間は中断データが無ければ検索のみの時間）
+ */
+static void read_boot_time(const DEBUG_COM_debug_frame_t *receive_frame)
+{
+    tetris_boot_time_t boot_time = tetris_get_boot_time(); // tetris_main内関数
+
+    uint8_t response_data[16];
+    set_uint32_little_endian(&response_data[0], boot_time.main_entry_us);
+    set_uint32_little_endian(&response_data[4], boot_time.score_log_load_us);
+    set_uint32_little_endian(&response_data[8], boot_time.resume_us);
+    set_uint32_little_endian(&response_data[12], boot_time.first_frame_us);
+
+    DEBUG_COM_send(receive_frame->cmd, sizeof(response_data), response_data);
+}
+
+/**
+ * @brief プレイ統計読出しコマンド実行
+ * @param receive_frame 受信デバッグフレーム（data[0]：読み出す項目の組（0：入力・速度、1：行消去種別））
+ * @return なし
+ * @details 組0：PPS×100、KPP×100、固定したミノ数、最少手順を超えた入力数の順に各4byteリトルエンディアンで返す
+ *          組1：1～4行消去の回数、Tスピン消去の回数の順に各2byteリトルエンディアンで返す
+ *          範囲外の組の場合は何も返さない
+ */
+static void read_play_statistics(const DEBUG_COM_debug_frame_t *receive_frame)
+{
+    TETRIS_CORE_play_statistics_t statistics = tetris_get_play_statistics(); // tetris_main内関数
+
+    if (0 == receive_frame->data[0])
+    {
+        uint8_t response_data[16];
+        set_uint32_little_endian(&response_data[0], TETRIS_CORE_get_pieces_per_second_x100(&statistics));
+        set_uint32_little_endian(&response_data[4], TETRIS_CORE_get_inputs_per_piece_x100(&statistics));
+        set_uint32_little_endian(&response_data[8], statistics.piece_count);
+        set_uint32_little_endian(&response_data[12], statistics.finesse_fault_count);
+        DEBUG_COM_send(receive_frame->cmd, sizeof(response_data), response_data);
+    }
+    else if (1 == receive_frame->data[0])
+    {
+        uint8_t response_data[2 * (TETRIS_CORE_ERASE_ROW_MAX + 1)];
+        for (uint8_t rows = 1; rows <= TETRIS_CORE_ERASE_ROW_MAX; rows++)
+        {
+            response_data[2 * (rows - 1)] = (uint8_t)statistics.clear_count[rows];
+            response_data[2 * (rows - 1) + 1] = (uint8_t)(statistics.clear_count[rows] >> 8);
+        }
+        response_data[2 * TETRIS_CORE_ERASE_ROW_MAX] = (uint8_t)statistics.t_spin_clear_count;
+        response_data[2 * TETRIS_CORE_ERASE_ROW_MAX + 1] = (uint8_t)(statistics.t_spin_clear_count >> 8);
+        DEBUG_COM_send(receive_frame->cmd, sizeof(response_data), response_data);
+    }
+}
+
+/**
+ * @brief フレーム送信バイト数読出しコマンド実行
+ * @param receive_frame 受信デバッグフレーム
+ * @return なし
+ * @details 最新値、最大値の順に各4byteリトルエンディアンで返す（ディスプレイICへの差分送信の通信量。I2Cのスレーブアドレスを含む）
+ */
+static void read_frame_sent_bytes(const DEBUG_COM_debug_frame_t *receive_frame)
+{
+    tetris_frame_sent_bytes_t sent_bytes = tetris_get_frame_sent_bytes(); // tetris_main内関数
+
+    uint8_t response_data[8];
+    set_uint32_little_endian(&response_data[0], sent_bytes.latest_bytes);
+    set_uint32_little_endian(&response_data[4], sent_bytes.max_bytes);
+
+    DEBUG_COM_send(receive_frame->cmd, sizeof(response_data), response_data);
+}
+
 /**
  * @brief レジスタ値読出しコマンド実行
  * @param receive_frame 受信デバッグフレーム
@@ -102,4 +347,18 @@ static void read_register(const DEBUG_COM_debug_frame_t *receive_frame)
     response_data[3] = (register_value >> 24) & MASK_8BIT;
 
     DEBUG_COM_send(receive_frame->cmd, sizeof(response_data), response_data);
+}
+
+/**
+ * @brief 4byteリトルエンディアン格納
+ * @param dst 格納先（4byte）
+ * @param value 格納する値
+ * @return なし
+ */
+static void set_uint32_little_endian(uint8_t *dst, uint32_t value)
+{
+    dst[0] = (value >> 0) & MASK_8BIT;
+    dst[1] = (value >> 8) & MASK_8BIT;
+    dst[2] = (value >> 16) & MASK_8BIT;
+    dst[3] = (value >> 24) & MASK_8BIT;
 }
\ No newline at end of file
@@ -11,85 +11,376 @@
 #include "SH1107.h"
 #include "math_lib.h"
 #include "bitmap_lib.h"
+#include "tetris_core.h"
+#include "timer.h"
 
 //======================================================
 // マクロ定義
 //======================================================
 #define VISUALIZE_MINO_DEF_LENGTH 24
-#define VISUALIZE_OFFSET_X 1
-#define VISUALIZE_OFFSET_Y 4
+
+// 開始・リスタートメッセージの点滅周期[us]（表示・非表示を切り替える間隔）
+#define MESSAGE_BLINK_PERIOD_US 500000
+
+// プレイフィールド表示領域（固定UIの左画面の枠内）。拡大率はフィールドの寸法から、領域に収まる最大の整数倍とする
+#define FIELD_AREA_X 6
+#define FIELD_AREA_Y 6
+#define FIELD_AREA_WIDTH 60
+#define FIELD_AREA_HEIGHT 120
+#define FIELD_SCALE_BY_WIDTH (FIELD_AREA_WIDTH / TETRIS_CORE_FIELD_WIDTH)
+#define FIELD_SCALE_BY_HEIGHT (FIELD_AREA_HEIGHT / TETRIS_CORE_FIELD_VISIBLE_ROWS)
+#define FIELD_SCALE ((FIELD_SCALE_BY_WIDTH < FIELD_SCALE_BY_HEIGHT) ? FIELD_SCALE_BY_WIDTH : FIELD_SCALE_BY_HEIGHT)
+
+// プレイフィールド表示位置（表示領域の中央に寄せる）
+#define FIELD_X (FIELD_AREA_X + (FIELD_AREA_WIDTH - TETRIS_CORE_FIELD_WIDTH * FIELD_SCALE) / 2)
+#define FIELD_Y (FIELD_AREA_Y + (FIELD_AREA_HEIGHT - TETRIS_CORE_FIELD_VISIBLE_ROWS * FIELD_SCALE) / 2)
+#define FIELD_DOT_WIDTH (TETRIS_CORE_FIELD_WIDTH * FIELD_SCALE)
+#define FIELD_DOT_HEIGHT (TETRIS_CORE_FIELD_VISIBLE_ROWS * FIELD_SCALE)
+
+// 情報パネルの範囲（右画面の枠内。情報レイヤが変化した時はこの範囲を合成し直す）
+#define INFORMATION_AREA_X 72
+#define INFORMATION_AREA_Y 0
+#define INFORMATION_AREA_WIDTH 56
+#define INFORMATION_AREA_HEIGHT 128
+
+// 定数ビットマップのフィールド用レイヤが前提とするフィールドの寸法・拡大率（10×20を6倍で表示）
+#define FIELD_CONST_LAYER_WIDTH 10
+#define FIELD_CONST_LAYER_ROWS 20
+#define FIELD_CONST_LAYER_SCALE 6
+
+// ネクスト2番目以降・ホールド表示用の縮小ミノ（1ブロック2×2ドット）
+#define SMALL_MINO_BLOCK_SIZE 2
+#define SMALL_MINO_HEIGHT (TETRIS_CORE_MINO_LENGTH * SMALL_MINO_BLOCK_SIZE)
+
+// 定数ビットマップに描画用ミノの無いミノ種別（ペントミノ）のネクスト1番目（1ブロック5×5ドットで生成し、NEXT枠内の中央に寄せる）
+#define LARGE_MINO_BLOCK_SIZE 5
+#define NEXT_FRAME_INNER_WIDTH 28  // NEXT枠の内側
+#define NEXT_FRAME_INNER_HEIGHT 16 // NEXT枠の内側
+
+// 数字ビットマップ（1文字4×7ドット、5ドット間隔で並べる）
+#define NUMBER_WIDTH 4
+#define NUMBER_HEIGHT 7
+#define NUMBER_PITCH 5
+
+// ゲームタイマ表示（M:SS.cc、LEVEL表示とROW見出しの間。位置は手動設定）
+#define TIMER_X 91
+#define TIMER_Y 72
+#define TIMER_DIGITS 5
+
+// 開始画面のゲームモード選択表示（3×5ドットの文字を4ドット間隔で並べたモード名と、左右の選択矢印）
+#define MODE_LABEL_HEIGHT 5
+#define MODE_LABEL_Y 100
+#define MODE_ARROW_LEFT_X (FIELD_AREA_X + 2)
+#define MODE_ARROW_RIGHT_X (FIELD_AREA_X + FIELD_AREA_WIDTH - 5)
+
+// ゲームオーバー画面のプレイ統計表示（フィールド表示領域のうちリスタートメッセージより下。ラベルは3×5ドットの文字）
+#define STATS_PANEL_Y 92
+#define STATS_PANEL_HEIGHT 34
+#define STATS_ROW_PITCH 8
+#define STATS_LABEL_X (FIELD_AREA_X + 2)
+#define STATS_VALUE_X (STATS_LABEL_X + 16)
+#define STATS_SHORT_VALUE_OFFSET 12 // 2文字ラベルの値の位置（ラベル左端から）
+#define STATS_SECOND_LABEL_X (FIELD_AREA_X + 32)
+
+// CPU対戦画面：2盤面を左右に並べるため、1ブロック5×5ドット（4×4ドット＋隙間1ドット）を上限に、盤面1つが表示領域に収まるよう縮小する
+#define VERSUS_AREA_WIDTH 50
+#define VERSUS_AREA_HEIGHT 100
+#define VERSUS_CELL_SIZE_MAX 5
+#define VERSUS_CELL_SIZE_BY_WIDTH (VERSUS_AREA_WIDTH / TETRIS_CORE_FIELD_WIDTH)
+#define VERSUS_CELL_SIZE_BY_HEIGHT (VERSUS_AREA_HEIGHT / TETRIS_CORE_FIELD_VISIBLE_ROWS)
+#define VERSUS_CELL_SIZE_FIT ((VERSUS_CELL_SIZE_BY_WIDTH < VERSUS_CELL_SIZE_BY_HEIGHT) ? VERSUS_CELL_SIZE_BY_WIDTH : VERSUS_CELL_SIZE_BY_HEIGHT)
+#define VERSUS_CELL_SIZE ((VERSUS_CELL_SIZE_FIT < VERSUS_CELL_SIZE_MAX) ? VERSUS_CELL_SIZE_FIT : VERSUS_CELL_SIZE_MAX)
+#define VERSUS_CELL_FILL (VERSUS_CELL_SIZE - 1)
+#define VERSUS_BOARD_WIDTH (TETRIS_CORE_FIELD_WIDTH * VERSUS_CELL_SIZE)
+#define VERSUS_BOARD_HEIGHT (TETRIS_CORE_FIELD_VISIBLE_ROWS * VERSUS_CELL_SIZE)
+
+// CPU対戦画面の行展開表（1エントリ5マス分。フィールド1行は左から5マスずつ表引きする）
+#define VERSUS_CELL_TABLE_COLUMNS 5
+#define VERSUS_CELL_TABLE_CHUNKS ((TETRIS_CORE_FIELD_WIDTH + VERSUS_CELL_TABLE_COLUMNS - 1) / VERSUS_CELL_TABLE_COLUMNS)
+
+// CPU対戦画面の表示位置（盤面枠は盤面の左右・下の1ドット外側。位置は手動設定）
+#define VERSUS_BOARD_Y 1
+#define VERSUS_PLAYER_BOARD_X 1
+#define VERSUS_OPPONENT_BOARD_X (127 - VERSUS_BOARD_WIDTH)
+#define VERSUS_GARBAGE_METER_WIDTH 2 // 受け取り待ち行数メータ（盤面の下端から1行1マス分伸ばす）
+#define VERSUS_PLAYER_NEXT_X 56      // ネクスト1番目（縮小表示）
+#define VERSUS_OPPONENT_NEXT_X 64    // ネクスト1番目（縮小表示）
+#define VERSUS_NEXT_Y 2              // ネクスト1番目（縮小表示）
+#define VERSUS_PLAYER_GARBAGE_X (VERSUS_PLAYER_BOARD_X + VERSUS_BOARD_WIDTH + 2)
+#define VERSUS_OPPONENT_GARBAGE_X (VERSUS_OPPONENT_BOARD_X - 2 - VERSUS_GARBAGE_METER_WIDTH)
+#define VERSUS_PLAYER_SCORE_X (VERSUS_PLAYER_BOARD_X + 1)
+#define VERSUS_OPPONENT_SCORE_X (VERSUS_OPPONENT_BOARD_X + 1)
+#define VERSUS_SCORE_Y (VERSUS_BOARD_Y + VERSUS_BOARD_HEIGHT + 9)
 
 //======================================================
 // 型定義
 //======================================================
+/**
+ * @brief プレイ統計ラベル定義
+ */
+typedef enum
+{
+    stats_label_pps = 0,   /**< 毎秒ミノ数 */
+    stats_label_kpp,       /**< ミノあたり入力数 */
+    stats_label_finesse,   /**< 最少手順を超えた入力数 */
+    stats_label_four_rows, /**< 4行消去回数 */
+    stats_label_t_spin,    /**< Tスピン消去回数 */
+    STATS_LABEL_NUMBER,
+} stats_label_t;
+
+/**
+ * @brief 情報レイヤ配置定義
+ * @details ピースセット毎のネクスト・ホールドの表示位置（位置は手動設定）
+ *          ペントミノは縮小表示でも幅・高さが大きいため、ネクストの縮小表示数を減らしてホールド枠を横に並べる
+ */
+typedef struct
+{
+    uint8_t next_mino_x;       /**< ネクスト1番目（NEXT枠内） */
+    uint8_t next_mino_y;       /**< ネクスト1番目（NEXT枠内） */
+    uint8_t next_queue_number; /**< ネクスト2番目以降の表示数 */
+    uint8_t next_queue_x;      /**< ネクスト2番目以降（NEXT枠の下に横並び） */
+    uint8_t next_queue_y;      /**< ネクスト2番目以降（NEXT枠の下に横並び） */
+    uint8_t next_queue_pitch;  /**< ネクスト2番目以降の表示間隔 */
+    uint8_t hold_frame_x;      /**< ホールド枠 */
+    uint8_t hold_frame_y;      /**< ホールド枠 */
+    uint8_t hold_frame_width;  /**< ホールド枠（縮小ミノ＋余白1ドット＋枠線） */
+    uint8_t hold_frame_height; /**< ホールド枠（縮小ミノ＋余白1ドット＋枠線） */
+} information_layout_t;
+
+/**
+ * @brief 情報パネル表示内容定義
+ * @details 表示中の内容を保持し、演算状態と比べて変化した時のみ情報レイヤを描き直す
+ */
+typedef struct
+{
+    uint8_t level;                                                          /**< ゲームレベル */
+    uint16_t row_deleted;                                                   /**< 合計消去行数 */
+    uint32_t score;                                                         /**< ゲームスコア */
+    TETRIS_CORE_mino_type_t next_mino_queue[TETRIS_CORE_NEXT_QUEUE_LENGTH]; /**< ネクストミノの種別 */
+    TETRIS_CORE_mino_type_t hold_mino_type;                                 /**< ホールド中のミノの種別 */
+    bool is_holding;                                                        /**< ホールド中のミノ有無 */
+    TETRIS_CORE_piece_set_t piece_set;                                      /**< ピースセット（配置の選択用） */
+} information_content_t;
+
+/**
+ * @brief ミノスプライト定義
+ * @details 描画済みのミノを1行32bit（bit31が左端）で保持する。幅32ドット以下の小さな画像を行単位のORだけで重ねるため
+ */
+typedef struct
+{
+    uint32_t row[VISUALIZE_MINO_DEF_LENGTH]; /**< 各行のドット */
+} mino_sprite_t;
 
 //======================================================
 // 変数・定数
 //======================================================
 static uint8_t game_restarted_counter = 0; // ゲーム起動・再起動のカウンター（起動・再起動を検知するためだけに使用　オーバーフローを許容する）
-static bitmap_128_t previous_layer;        // ゲームオーバー時のベースレイヤ用　ゲーム実行中の描画データを保持しておく
+static bitmap_128_t previous_layer;        // ゲーム実行中の最終画面（レイヤ合成結果を保持し、変化範囲のみ書き換える）　ゲームオーバー時のベースレイヤにも使う
+
+// ゲーム実行中画面の描画レイヤ（固定UIは定数ビットマップをそのまま使う。各レイヤは変化した行・範囲のみ描き直す）
+static bitmap_128_t field_block_layer; // 固定済みブロック
+static bitmap_128_t ghost_layer;       // 落下地点
+static bitmap_128_t active_mino_layer; // 操作ミノ
+static bitmap_128_t information_layer; // 情報パネル
+static bitmap_128_t overlay_layer;     // オーバーレイ（ゲームタイマ）
+static const uint64_t (*const in_game_layers[TETRIS_DISPLAY_LAYER_NUMBER])[2] = {
+    tetris_bitmap_def_fixed_UI, field_block_layer, ghost_layer, active_mino_layer, information_layer, overlay_layer, // tetris_display_layer_tの順
+};
+
+// 表示中のレイヤの内容（演算状態と比べて変化した所のみ描き直す。フィールドのレイヤは描画範囲の各行、フィールド幅分のbitで最上位が左端の列）
+static uint16_t shown_field_rows[TETRIS_CORE_FIELD_VISIBLE_ROWS];       // 固定済みブロック
+static uint16_t shown_ghost_rows[TETRIS_CORE_FIELD_VISIBLE_ROWS];       // 落下地点
+static uint16_t shown_active_mino_rows[TETRIS_CORE_FIELD_VISIBLE_ROWS]; // 操作ミノ
+static information_content_t shown_information;                         // 情報パネル
+
+// ネクスト・ホールド表示用スプライトキャッシュ（初回のゲーム開始時に1回だけ生成し、毎フレームの抽出・拡大を不要にする）
+static mino_sprite_t next_mino_sprite[TETRIS_CORE_NUMBER_MINO_TYPES];  // ネクスト1番目用（定数ビットマップから抽出）
+static mino_sprite_t small_mino_sprite[TETRIS_CORE_NUMBER_MINO_TYPES]; // ネクスト2番目以降・ホールド用（ミノ形状から生成）
+static mino_sprite_t hold_frame_sprite[TETRIS_CORE_NUMBER_PIECE_SETS]; // ホールド枠（ピースセット毎）
+static mino_sprite_t number_sprite[10];                                // 数字（0～9）
+static bool is_sprite_cached = false;                                  // スプライトキャッシュ生成済みフラグ
+
+// 情報レイヤ配置（TETRIS_CORE_piece_set_tの順）
+static const information_layout_t information_layout[TETRIS_CORE_NUMBER_PIECE_SETS] = {
+    {85, 17, 4, 79, 39, 10, 79, 44, 12, 8},   // テトリミノ
+    {83, 21, 2, 75, 39, 12, 100, 38, 14, 10}, // ペントミノ
+};
+
+// ミノスプライトの1ブロックのドット（縮小：塗りつぶし、拡大：枠と中央の点。bit0が右端）
+static const uint8_t small_mino_block_dots[SMALL_MINO_BLOCK_SIZE] = {0x03, 0x03};
+static const uint8_t large_mino_block_dots[LARGE_MINO_BLOCK_SIZE] = {0x1F, 0x11, 0x15, 0x11, 0x1F};
+
+// プレイフィールドのマスのスタンプ（描画範囲のドット行毎に、1マス分の模様をフィールド幅分並べたドット列。bit63がフィールドの左端）
+// スプライトキャッシュと同時に生成する。空のマスは何も描かない
+static uint64_t block_stamp_rows[FIELD_DOT_HEIGHT]; // ブロック
+static uint64_t ghost_stamp_rows[FIELD_DOT_HEIGHT]; // 落下地点
+
+// ゲームタイマ表示（表示中の各桁を保持し、変化した桁のみ描き直す）
+static const uint8_t timer_digit_x[TIMER_DIGITS] = {TIMER_X, TIMER_X + 7, TIMER_X + 12, TIMER_X + 19, TIMER_X + 24}; // 分・秒2桁・1/100秒2桁の描画位置
+static uint8_t shown_timer_digits[TIMER_DIGITS];                                                                  // 表示中の各桁の数字
+
+// 開始画面のゲームモード名（tetris_game_mode_tの順。1行32bit、bit31が左端）
+static const uint32_t mode_label_sprite[TETRIS_GAME_MODE_NUMBER][MODE_LABEL_HEIGHT] = {
+    {0xA4C4EA4C, 0xEAAA4AAA, 0xEECE4EAA, 0xAAAA4AAA, 0xAAAA4A4A}, // MARATHON
+    {0x6CCECE00, 0x8AA4A400, 0x4CC4A400, 0x28A4A400, 0xC8AEA400}, // SPRINT
+    {0xA8EC4000, 0xA84AA000, 0xA84CE000, 0xA84AA000, 0xEE4AA000}, // ULTRA
+    {0xCC46EE6E, 0xAAA84488, 0xCCE8448C, 0x8AA84488, 0x8AA64E6E}, // PRACTICE
+    {0xAEC6A600, 0xA8A8A800, 0xACC4A400, 0xA8A2A200, 0x4EACEC00}, // VERSUS
+    {0xCECE4000, 0xA8A4A000, 0xCCA4E000, 0x88A4A000, 0x8EA4A000}, // PENTA
+};
+static const uint8_t mode_label_width[TETRIS_GAME_MODE_NUMBER] = {31, 23, 19, 31, 23, 19};                               // モード名の幅（中央寄せ用）
+static const uint32_t mode_arrow_left[MODE_LABEL_HEIGHT] = {0x20000000, 0x40000000, 0x80000000, 0x40000000, 0x20000000};  // 左矢印
+static const uint32_t mode_arrow_right[MODE_LABEL_HEIGHT] = {0x80000000, 0x40000000, 0x20000000, 0x40000000, 0x80000000}; // 右矢印
+
+// ゲームオーバー画面のプレイ統計ラベル（stats_label_tの順。モード名と同じ3×5ドットの文字）
+static const uint32_t stats_label_sprite[STATS_LABEL_NUMBER][MODE_LABEL_HEIGHT] = {
+    {0xCC600000, 0xAA800000, 0xCC400000, 0x88200000, 0x88C00000}, // PPS
+    {0xACC00000, 0xAAA00000, 0xCCC00000, 0xA8800000, 0xA8800000}, // KPP
+    {0xEEC00000, 0x84A00000, 0xC4A00000, 0x84A00000, 0x8EA00000}, // FIN
+    {0xA8000000, 0xA8000000, 0xE8000000, 0x28000000, 0x2E000000}, // 4L
+    {0xE6000000, 0x48000000, 0x44000000, 0x42000000, 0x4C000000}, // TS
+};
+
+// CPU対戦画面用キャッシュ（スプライトキャッシュと同時に生成する）
+static uint32_t versus_cell_solid[1 << VERSUS_CELL_TABLE_COLUMNS]; // 5マス分のブロック有無（bit4が左端）→ 5マス分の塗りつぶしパターン
+static uint32_t versus_cell_ghost[1 << VERSUS_CELL_TABLE_COLUMNS]; // 5マス分の落下地点有無（bit4が左端）→ 5マス分の枠の左右辺パターン
+static bitmap_128_t versus_frame_layer;                            // 盤面枠
 
 //======================================================
 // プロトタイプ宣言
 //======================================================
 static void update_previous_base_layer(const bitmap_128_t current_bitmap);
 static void overlay_Fixed_UI(bitmap_128_t dst_bitmap);
-static void overlay_field_layer(bitmap_128_t dst_bitmap, tetris_compute_state_t *mino_compute_data);
-static void overlay_information_layer(bitmap_128_t dst_bitmap, tetris_compute_state_t *mino_compute_data);
-static void get_number_string_bitmap(bitmap_128_t dst_bitmap, uint16_t num);
+static void initialize_in_game_layers(const tetris_game_timer_t *timer_ptr);
+static void update_field_layers(const tetris_compute_state_t *compute_state_ptr);
+static void update_cell_layer(tetris_display_layer_t layer, bitmap_128_t layer_bitmap, uint16_t shown_rows[], const uint16_t rows[], const uint64_t stamp_rows[]);
+static uint64_t expand_field_row(uint16_t row_bits);
+static void update_information_layer(const tetris_compute_state_t *compute_state_ptr, bool is_forced);
+static bool update_information_content(const TETRIS_CORE_state_t *core_state_ptr);
+static void overlay_information_layer(bitmap_128_t dst_bitmap, const tetris_compute_state_t *compute_state_ptr);
 static void get_number_bitmap(bitmap_128_t dst_bitmap, uint8_t num);
-static void get_visualize_mino_bitmap(bitmap_128_t dst, const bitmap_128_t visualize_mino_definition_1, const bitmap_128_t visualize_mino_definition_2, tetris_mino_type_t mino_type, tetris_mino_turn_state_t turn);
+static void get_visualize_mino_bitmap(bitmap_128_t dst, const bitmap_128_t visualize_mino_definition_1, const bitmap_128_t visualize_mino_definition_2, TETRIS_CORE_mino_type_t mino_type, TETRIS_CORE_mino_turn_state_t turn);
+static void cache_mino_sprite();
+static void get_mino_sprite(mino_sprite_t *sprite_ptr, TETRIS_CORE_mino_type_t mino_type, uint8_t block_size, const uint8_t block_dots[], uint8_t area_width, uint8_t area_height);
+static void overlay_sprite(bitmap_128_t dst_bitmap, const mino_sprite_t *sprite_ptr, uint8_t height, uint8_t x, uint8_t y);
+static void overlay_number_sprite(bitmap_128_t dst_bitmap, uint32_t num, uint8_t x, uint8_t y);
+static void overlay_versus_board(bitmap_128_t dst_bitmap, const tetris_compute_state_t *compute_state_ptr, uint8_t board_x, uint8_t garbage_x, uint8_t next_x, uint8_t score_x);
+static uint16_t get_mino_field_row(uint32_t mino_shape, int8_t mino_row, int8_t reference_x);
+static uint64_t expand_versus_row(uint16_t row_bits, const uint32_t cell_table[]);
+static void cache_field_stamp();
+static void cache_versus_layer();
+static void or_dots(bitmap_128_t dst_bitmap, uint8_t y, uint64_t dots, uint8_t x);
+static void clear_dots(bitmap_128_t dst_bitmap, uint8_t y, uint64_t dots, uint8_t x);
+static void overlay_mode_label(bitmap_128_t dst_bitmap, tetris_game_mode_t selected_mode);
+static void overlay_timer(bitmap_128_t dst_bitmap, uint32_t centiseconds);
+static void update_timer_digits(uint32_t centiseconds);
+static void split_timer_digits(uint8_t digits[], uint32_t centiseconds);
+static void overlay_play_statistics(bitmap_128_t dst_bitmap, const TETRIS_CORE_play_statistics_t *statistics_ptr);
+static void overlay_stats_label(bitmap_128_t dst_bitmap, stats_label_t label, uint8_t x, uint8_t y);
+static void overlay_fixed_point_sprite(bitmap_128_t dst_bitmap, uint32_t value_x100, uint8_t x, uint8_t y);
 
 //======================================================
 // 公開関数定義
 //======================================================
 /**
  * @brief ゲーム開始待機画面表示
+ * @param selected_mode 選択中のゲームモード
  * @return なし
  * @details 一定周期で開始メッセージの表示をトグルし、点滅表示を行う
+ *          開始メッセージの下に選択中のゲームモード名を常時表示し、選択が変わればすぐに描き直す
  */
-void tetris_display_waiting_start()
+void tetris_display_waiting_start(tetris_game_mode_t selected_mode)
 {
-    static bool enable_message = false;         // メッセージ点滅表示選択
-    static uint8_t blink_cycle_counter = 50;    // メッセージ点滅サイクルカウンター
-    static bitmap_128_t base_layer_initializer; // レイヤ初期値
+    static bool enable_message = false;                        // メッセージ点滅表示選択
+    static uint64_t blink_time_us = 0;                         // 前回メッセージ表示を切り替えた時刻[us]（初回は即切り替え）
+    static bitmap_128_t base_layer_initializer;                // レイヤ初期値
+    static tetris_game_mode_t shown_mode = game_mode_marathon; // 表示中のゲームモード
 
-    // 等時間間隔でメッセージを点滅させる
-    if (blink_cycle_counter++ >= 50) // 数値は適当
+    // 等時間間隔でメッセージを点滅させる（フレーム数ではなく実時間で数える）
+    uint64_t current_time_us = TIMER_get_time_us();
+    bool is_blink_timing = (MESSAGE_BLINK_PERIOD_US <= current_time_us - blink_time_us);
+    if (is_blink_timing || selected_mode != shown_mode)
     {
         // レイヤ初期化
         bitmap_128_t base_layer = {0};
         overlay_Fixed_UI(base_layer);
 
         // メッセージ表示有無をトグル
-        enable_message ^= true;
+        if (is_blink_timing)
+        {
+            enable_message ^= true;
+            blink_time_us = current_time_us;
+        }
         if (enable_message)
         {
             BITMAP_or(base_layer, tetris_bitmap_def_start_message); // スタートメッセージを重ねる
         }
 
+        // ゲームモード選択表示
+        overlay_mode_label(base_layer, selected_mode);
+        shown_mode = selected_mode;
+
         // 描画用データ送信
         SH1107_display_bitmap_data(base_layer);
-
-        blink_cycle_counter = 0;
     }
 }
 
 /**
  * @brief ゲーム実行中 描画メイン処理
  * @param compute_state_ptr 演算状態
+ * @param timer_ptr ゲームタイマ（スプリント・ウルトラ以外はNULL）
+ * @return なし
+ * @details 画面を描画レイヤ（固定UI・固定済みブロック・落下地点・操作ミノ・情報パネル・オーバーレイ）の重ね合わせとして保持し、
+ *          演算状態と比べて変化したレイヤの変化した範囲のみ描き直して、その範囲だけ最終画面に合成・送信する
+ *          操作ミノが動いただけのフレームは、移動前後の行のみ描き直して合成する（画面全体の合成・拡大は行わない）
+ *          演算で表示対象が変化しなかったフレームは、ゲームタイマの変化した桁のみ合成・送信する
+ *          ゲーム開始・リスタート後の初回は全レイヤを描き直し、画面全体を合成する
+ */
+void tetris_display_ctrl_in_game(tetris_compute_state_t *compute_state_ptr, const tetris_game_timer_t *timer_ptr)
+{
+    static uint8_t previous_game_restarted_local = 0; // 起動・再起動検知用
+
+    bool is_restarted = (previous_game_restarted_local != game_restarted_counter);
+    if (is_restarted)
+    {
+        previous_game_restarted_local = game_restarted_counter;
+        initialize_in_game_layers(timer_ptr);
+    }
+
+    // 各レイヤを表示中の内容と比べ、変化した範囲を描き直す
+    if (is_restarted || compute_state_ptr->is_display_changed)
+    {
+        update_field_layers(compute_state_ptr);                   // 左画面のプレイフィールド
+        update_information_layer(compute_state_ptr, is_restarted); // 右画面のスコアやレベルなどの可変UI
+    }
+    if (timer_ptr && !is_restarted)
+        update_timer_digits(timer_ptr->display_centiseconds); // ゲームタイマ
+
+    // 変化した範囲のみ最終画面に合成して送信（保持した最終画面はゲームオーバー時にも使用する）
+    tetris_compose_display_layers(previous_layer, in_game_layers);
+}
+
+/**
+ * @brief CPU対戦中 描画メイン処理
+ * @param compute_state_ptr 自分の演算状態
+ * @param opponent_compute_state_ptr 対戦相手の演算状態
  * @return なし
- * @details 固定UI、フィールドレイヤ、各種情報レイヤを合成し、ディスプレイICに送信して表示させる
+ * @details 2盤面を1ブロック5×5ドットで左右に並べ、それぞれのネクスト・受け取り待ち行数・スコアを添えて表示する
+ *          フィールド1行を表引きで盤面1行分のドット列に展開し、ビットマップの行に直接ORする（盤面全体の拡大・シフトを行わない）
+ *          どちらの盤面も表示対象が変化しなかったフレームは、合成も送信も行わない
  */
-void tetris_display_ctrl_in_game(tetris_compute_state_t *compute_state_ptr)
+void tetris_display_ctrl_versus(tetris_compute_state_t *compute_state_ptr, tetris_compute_state_t *opponent_compute_state_ptr)
 {
+    if (!compute_state_ptr->is_display_changed && !opponent_compute_state_ptr->is_display_changed)
+        return;
+
     // レイヤ初期化
     bitmap_128_t base_layer = {0};
-    overlay_Fixed_UI(base_layer); // 固定UIをオーバーレイ
+    BITMAP_copy(base_layer, versus_frame_layer); // 盤面枠
 
-    // 各種レイヤをオーバーレイ
-    overlay_field_layer(base_layer, compute_state_ptr);       // 左画面に表示するプレイフィールドを生成してオーバーレイ
-    overlay_information_layer(base_layer, compute_state_ptr); // 右画面に表示するスコアやレベルなどの可変UIを生成してオーバーレイ
+    // 左に自分、右に対戦相手の盤面を重ねる
+    overlay_versus_board(base_layer, compute_state_ptr, VERSUS_PLAYER_BOARD_X, VERSUS_PLAYER_GARBAGE_X, VERSUS_PLAYER_NEXT_X, VERSUS_PLAYER_SCORE_X);
+    overlay_versus_board(base_layer, opponent_compute_state_ptr, VERSUS_OPPONENT_BOARD_X, VERSUS_OPPONENT_GARBAGE_X, VERSUS_OPPONENT_NEXT_X, VERSUS_OPPONENT_SCORE_X);
 
     // 描画用データ送信
     SH1107_display_bitmap_data(base_layer);
@@ -100,29 +391,41 @@ void tetris_display_ctrl_in_game(tetris_compute_state_t *compute_state_ptr)
 
 /**
  * @brief ゲームリスタート待機画面表示
+ * @param compute_state_ptr 演算状態（プレイ統計の表示用）
+ * @param game_mode ゲームモード（CPU対戦はプレイ統計を表示しない）
  * @return なし
  * @details 再開メッセージを点滅表示させる
  *          ゲームオーバー時の画面に再開メッセージを重ねる形で画面生成している
  *          これによって、再開メッセージ表示中もゲームオーバー時のスコア等を見れるようにしている
+ *          プレイ統計はゲームオーバー後の初回コール時にゲームオーバー時の画面（previous_layer）へ1回だけ書き込み、
+ *          その範囲のみ送信する（盤面は描き直さない。以降の点滅は統計を含んだ画面を使う）
+ *          CPU対戦画面は統計の表示範囲に自分の盤面下端・せり上がりメータ・スコアがあり、空き領域も無いため統計を重ねない
  */
-void tetris_display_waiting_restart()
+void tetris_display_waiting_restart(const tetris_compute_state_t *compute_state_ptr, tetris_game_mode_t game_mode)
 {
     static uint8_t previous_game_restarted_local = 0; // 起動・再起動検知用
 
     static bool enable_message;                 // メッセージ点滅表示選択
-    static uint8_t blink_cycle_counter;         // メッセージ点滅サイクルカウンター
+    static uint64_t blink_time_us;              // 前回メッセージ表示を切り替えた時刻[us]
     static bitmap_128_t base_layer_initializer; // レイヤ初期値
 
     // ゲーム起動・再起動後の初回コール時のみ、各パラメータの初期値を設定する
+    uint64_t current_time_us = TIMER_get_time_us();
     if (previous_game_restarted_local != game_restarted_counter)
     {
         enable_message = false;
-        blink_cycle_counter = 0;
+        blink_time_us = current_time_us;
         previous_game_restarted_local = game_restarted_counter;
+
+        if (game_mode_versus != game_mode)
+        {
+            overlay_play_statistics(previous_layer, &compute_state_ptr->core_state.play_statistics);
+            SH1107_display_bitmap_area_data(previous_layer, FIELD_AREA_X, STATS_PANEL_Y, FIELD_AREA_WIDTH, STATS_PANEL_HEIGHT);
+        }
     }
 
-    // 等時間間隔でメッセージを点滅させる
-    if (blink_cycle_counter++ >= 50) // 数値は適当
+    // 等時間間隔でメッセージを点滅させる（フレーム数ではなく実時間で数える）
+    if (MESSAGE_BLINK_PERIOD_US <= current_time_us - blink_time_us)
     {
         // レイヤ初期化
         bitmap_128_t base_layer = {0};
@@ -139,7 +442,7 @@ void tetris_display_waiting_restart()
         // 描画用データ送信
         SH1107_display_bitmap_data(base_layer);
 
-        blink_cycle_counter = 0;
+        blink_time_us = current_time_us;
     }
 }
 
@@ -152,113 +455,248 @@ void tetris_display_waiting_restart()
 void tetris_initialize_display_ctrl()
 {
     game_restarted_counter = game_restarted_counter + 1; // リスタート通知（オーバーフロー許容）
+
+    if (!is_sprite_cached)
+    {
+        cache_mino_sprite();
+        cache_field_stamp();
+        cache_versus_layer();
+        is_sprite_cached = true;
+    }
 }
 
 //======================================================
 // 内部関数定義
 //======================================================
 /**
- * @brief フィールド関連レイヤ合成
- * @param dst_bitmap 出力先ビットマップ
- * @param compute_state_ptr 演算状態
+ * @brief ゲーム実行中レイヤ初期化
+ * @param timer_ptr ゲームタイマ（スプリント・ウルトラ以外はNULL）
  * @return なし
- * @details ディスプレイの左画面に表示するプレイフィールドのビットマップを生成
- * @note 計算量が多く最適化余地あり
+ * @details 描き直すレイヤを全て消去して表示中の内容を空にし、ゲームタイマは全桁を描いてから、画面全体を合成対象にする
  */
-static void overlay_field_layer(bitmap_128_t dst_bitmap, tetris_compute_state_t *compute_state_ptr)
+static void initialize_in_game_layers(const tetris_game_timer_t *timer_ptr)
 {
-    bitmap_128_t base_bitmap = {0};
-    bitmap_128_t base_bitmap_extracted = {0};
-    bitmap_128_t base_bitmap_enlarged = {0};
-    bitmap_128_t falling_point_bitmap = {0};
-    bitmap_128_t falling_point_bitmap_enlarged = {0};
+    for (uint8_t y = 0; y < 128; y++)
+    {
+        for (uint8_t word = 0; word < 2; word++)
+        {
+            field_block_layer[y][word] = 0;
+            ghost_layer[y][word] = 0;
+            active_mino_layer[y][word] = 0;
+            information_layer[y][word] = 0;
+            overlay_layer[y][word] = 0;
+        }
+    }
+
+    for (uint8_t visible_row = 0; visible_row < TETRIS_CORE_FIELD_VISIBLE_ROWS; visible_row++)
+    {
+        shown_field_rows[visible_row] = 0;
+        shown_ghost_rows[visible_row] = 0;
+        shown_active_mino_rows[visible_row] = 0;
+    }
 
-    // 演算用ビットマップを重ねる（この時点では1ブロック1ドット）
-    BITMAP_or(base_bitmap, compute_state_ptr->field_parameter.bitmap); // フィールドのビットマップをオーバーレイ
-    BITMAP_or(base_bitmap, compute_state_ptr->mino_parameter.bitmap);  // ミノのビットマップをオーバーレイ
+    if (timer_ptr)
+        overlay_timer(overlay_layer, timer_ptr->display_centiseconds);
 
-    // 重ねた演算用ビットマップをディスプレイ表示用に拡大＆調整する
-    BITMAP_shift(base_bitmap, -1, -4);                               // ボックス内側の左上のドットが0,0に来るようシフトする
-    BITMAP_extract(base_bitmap_extracted, base_bitmap, 0, 9, 0, 19); // ボックス枠を削除（ボックス枠は固定UI側で表示するため）
-    BITMAP_enlarge(base_bitmap_enlarged, base_bitmap_extracted, 6);  // 拡大表示する
-    BITMAP_shift(base_bitmap_enlarged, 6, 6);                        // 固定UIに合わせて位置調整
-    BITMAP_and(base_bitmap_enlarged, tetris_bitmap_def_field_layer); // ミノに描画用レイヤを適用する
+    tetris_invalidate_all_display_layers();
+}
 
-    // 上記とは別で落下地点表示のビットマップを生成する
-    BITMAP_copy(falling_point_bitmap, compute_state_ptr->mino_parameter.bitmap);                       // ミノのビットマップを取得
-    BITMAP_shift(falling_point_bitmap, -1, compute_state_ptr->mino_parameter.distance_to_landing - 4); // 落下地点にシフト＆ボックス内の左上のドットが0,0に来るようシフトする
-    BITMAP_enlarge(falling_point_bitmap_enlarged, falling_point_bitmap, 6);                            // 拡大表示する
-    BITMAP_shift(falling_point_bitmap_enlarged, 6, 6);                                                 // 固定UIに合わせて位置調整
-    BITMAP_and(falling_point_bitmap_enlarged, tetris_bitmap_def_falling_point_layer);                  // 落下地点レイヤー専用表示を適用
+/**
+ * @brief フィールド関連レイヤ更新
+ * @param compute_state_ptr 演算状態
+ * @return なし
+ * @details 描画範囲の各行について固定済みブロック・操作ミノ・落下地点の行マスクを求め、レイヤ毎に表示中の行と比べて変化した行のみ描き直す
+ *          ミノ接地後、次のミノが生成されるまでの間は操作ミノ無しとして、操作ミノ・落下地点を消す
+ */
+static void update_field_layers(const tetris_compute_state_t *compute_state_ptr)
+{
+    const TETRIS_CORE_state_t *core_state_ptr = &compute_state_ptr->core_state;
+    const TETRIS_CORE_mino_parameter_t *mino_ptr = &core_state_ptr->mino_parameter;
+    uint32_t mino_shape = TETRIS_CORE_get_mino_shape(mino_ptr->mino_type, mino_ptr->turn_state);
+    int8_t landing_y = mino_ptr->reference_y + mino_ptr->distance_to_landing;
 
-    // 最終的なビットマップを合成
-    BITMAP_or(base_bitmap_enlarged, falling_point_bitmap_enlarged); // 拡大した演算用ビットマップと落下地点表示ビットマップを重ねる
-    BITMAP_or(dst_bitmap, base_bitmap_enlarged);                    // 戻り値の格納
+    uint16_t field_rows[TETRIS_CORE_FIELD_VISIBLE_ROWS];
+    uint16_t ghost_rows[TETRIS_CORE_FIELD_VISIBLE_ROWS];
+    uint16_t active_mino_rows[TETRIS_CORE_FIELD_VISIBLE_ROWS];
+    for (uint8_t visible_row = 0; visible_row < TETRIS_CORE_FIELD_VISIBLE_ROWS; visible_row++)
+    {
+        int8_t field_y = TETRIS_CORE_FIELD_VISIBLE_TOP + visible_row;
+        field_rows[visible_row] = core_state_ptr->field_parameter.row[field_y];
+        ghost_rows[visible_row] = 0;
+        active_mino_rows[visible_row] = 0;
+        if (!mino_ptr->is_next_mino_generate) // 操作ミノ無しの間はフィールドのみ
+        {
+            ghost_rows[visible_row] = get_mino_field_row(mino_shape, field_y - landing_y, mino_ptr->reference_x);
+            active_mino_rows[visible_row] = get_mino_field_row(mino_shape, field_y - mino_ptr->reference_y, mino_ptr->reference_x);
+        }
+    }
+
+    update_cell_layer(display_layer_field, field_block_layer, shown_field_rows, field_rows, block_stamp_rows);
+    update_cell_layer(display_layer_ghost, ghost_layer, shown_ghost_rows, ghost_rows, ghost_stamp_rows);
+    update_cell_layer(display_layer_active_mino, active_mino_layer, shown_active_mino_rows, active_mino_rows, block_stamp_rows);
 }
 
 /**
- * @brief 固定UIレイヤ取得
- * @param dst_bitmap 出力先ビットマップ
+ * @brief フィールドのレイヤ1枚更新
+ * @param layer 描画レイヤ
+ * @param layer_bitmap レイヤのビットマップ
+ * @param shown_rows 表示中の各行（描き直した行は更新する）
+ * @param rows 描画範囲の各行のマスク（フィールド行と同じ座標系、壁のbitは無視する）
+ * @param stamp_rows マスのスタンプ（描画範囲のドット行毎）
  * @return なし
- * @details 定数のビットマップレイヤーを取得するだけ
+ * @details 変化した行のみ、拡大率分のドット行を描き直す
+ *          1行のマスをFIELD_SCALEドット幅のマスクに広げ、各ドット行でスタンプとANDを取ってレイヤの行に直接書き込む
+ *          （マスのある位置にだけ模様が残るので、マス毎のスタンプを表示位置に押したのと同じになる。ビットマップ全体の処理は行わない）
+ *          描き直した行を囲む範囲を、レイヤの変化範囲として登録する
  */
-static void overlay_Fixed_UI(bitmap_128_t dst_bitmap)
+static void update_cell_layer(tetris_display_layer_t layer, bitmap_128_t layer_bitmap, uint16_t shown_rows[], const uint16_t rows[], const uint64_t stamp_rows[])
 {
-    BITMAP_or(dst_bitmap, tetris_bitmap_def_fixed_UI);
+    int8_t row_first = -1;
+    int8_t row_last = -1;
+
+    for (uint8_t visible_row = 0; visible_row < TETRIS_CORE_FIELD_VISIBLE_ROWS; visible_row++)
+    {
+        uint16_t row_bits = (rows[visible_row] & TETRIS_CORE_ROW_BLOCK_MASK) >> TETRIS_CORE_ROW_BLOCK_SHIFT;
+        if (row_bits == shown_rows[visible_row])
+            continue;
+        shown_rows[visible_row] = row_bits;
+
+        uint64_t cell_mask = expand_field_row(row_bits);
+        for (uint8_t dot_y = 0; dot_y < FIELD_SCALE; dot_y++)
+        {
+            uint8_t dot_row = visible_row * FIELD_SCALE + dot_y;
+            uint8_t y = FIELD_Y + dot_row;
+            layer_bitmap[y][0] = 0; // レイヤはフィールド内のみ描くので、行全体を消してよい
+            layer_bitmap[y][1] = 0;
+            or_dots(layer_bitmap, y, cell_mask & stamp_rows[dot_row], FIELD_X);
+        }
+
+        row_first = (row_first < 0) ? visible_row : row_first;
+        row_last = visible_row;
+    }
+
+    if (0 <= row_first)
+        tetris_invalidate_display_layer(layer, FIELD_X, FIELD_Y + row_first * FIELD_SCALE, FIELD_DOT_WIDTH, (row_last - row_first + 1) * FIELD_SCALE);
 }
 
 /**
- * @brief 情報レイヤ合成
- * @param dst_bitmap 出力先ビットマップ
+ * @brief フィールド1行拡大
+ * @param row_bits フィールド1行のマス（フィールド幅分のbit、最上位が左端の列）
+ * @return 拡大したドット列（bit63がフィールドの左端。1マスFIELD_SCALEドット）
+ */
+static uint64_t expand_field_row(uint16_t row_bits)
+{
+    uint64_t block_dots = ~(uint64_t)0 << (64 - FIELD_SCALE);
+    uint64_t dots = 0;
+
+    for (uint8_t column = 0; column < TETRIS_CORE_FIELD_WIDTH; column++)
+    {
+        if (row_bits & (1u << (TETRIS_CORE_FIELD_WIDTH - 1 - column)))
+            dots |= block_dots >> (column * FIELD_SCALE);
+    }
+
+    return dots;
+}
+
+/**
+ * @brief 情報レイヤ更新
  * @param compute_state_ptr 演算状態
- * @details ディスプレイの右画面に表示するパラメータ表示のビットマップを生成
+ * @param is_forced 内容が変化していなくても描き直すか（ゲーム開始・リスタート後の初回）
  * @return なし
+ * @details レベル・消去行・スコア・ネクスト・ホールドのいずれかが表示中の内容から変化した時のみ、情報パネル全体を描き直す
+ *          （ミノが動いただけのフレームでは何もしない）
  */
-static void overlay_information_layer(bitmap_128_t dst_bitmap, tetris_compute_state_t *compute_state_ptr)
+static void update_information_layer(const tetris_compute_state_t *compute_state_ptr, bool is_forced)
 {
-    // 初期化
-    bitmap_128_t next_bitmap = {0};
-    bitmap_128_t level_bitmap = {0};
-    bitmap_128_t row_bitmap = {0};
-    bitmap_128_t score_bitmap = {0};
+    bool is_changed = update_information_content(&compute_state_ptr->core_state);
+    if (!is_changed && !is_forced)
+        return;
 
-    // ネクストミノ、レベル、消去行、スコア情報のビットマップを取得する
-    get_visualize_mino_bitmap(next_bitmap, tetris_bitmap_def_next_mino_1, tetris_bitmap_def_next_mino_2, compute_state_ptr->mino_parameter.next_mino_type, r_no_turn);
-    get_number_string_bitmap(level_bitmap, compute_state_ptr->game_parameter.level);
-    get_number_string_bitmap(row_bitmap, compute_state_ptr->game_parameter.row_deleted);
-    get_number_string_bitmap(score_bitmap, compute_state_ptr->game_parameter.score);
+    for (uint8_t y = INFORMATION_AREA_Y; y < INFORMATION_AREA_Y + INFORMATION_AREA_HEIGHT; y++)
+    {
+        information_layer[y][0] = 0;
+        information_layer[y][1] = 0;
+    }
+    overlay_information_layer(information_layer, compute_state_ptr);
 
-    // 上記で取得したビットマップを全て重ねる
-    BITMAP_or_with_shift(dst_bitmap, next_bitmap, 85, 17);   // 位置は手動設定
-    BITMAP_or_with_shift(dst_bitmap, level_bitmap, 91, 63);  // 位置は手動設定
-    BITMAP_or_with_shift(dst_bitmap, row_bitmap, 91, 90);    // 位置は手動設定
-    BITMAP_or_with_shift(dst_bitmap, score_bitmap, 91, 116); // 位置は手動設定
+    tetris_invalidate_display_layer(display_layer_information, INFORMATION_AREA_X, INFORMATION_AREA_Y, INFORMATION_AREA_WIDTH, INFORMATION_AREA_HEIGHT);
 }
 
 /**
- * @brief 10進数文字列ビットマップ生成
+ * @brief 情報パネル表示内容更新
+ * @param core_state_ptr ゲームコア演算状態
+ * @return true：表示中の内容から変化した（表示中の内容を演算状態の値に更新する）
+ */
+static bool update_information_content(const TETRIS_CORE_state_t *core_state_ptr)
+{
+    const TETRIS_CORE_game_parameter_t *game_parameter_ptr = &core_state_ptr->game_parameter;
+    const TETRIS_CORE_mino_parameter_t *mino_ptr = &core_state_ptr->mino_parameter;
+    information_content_t *shown_ptr = &shown_information;
+    bool is_changed = false;
+
+    is_changed |= (shown_ptr->level != game_parameter_ptr->level);
+    is_changed |= (shown_ptr->row_deleted != game_parameter_ptr->row_deleted);
+    is_changed |= (shown_ptr->score != game_parameter_ptr->score);
+    is_changed |= (shown_ptr->hold_mino_type != mino_ptr->hold_mino_type);
+    is_changed |= (shown_ptr->is_holding != mino_ptr->is_holding);
+    is_changed |= (shown_ptr->piece_set != core_state_ptr->piece_set);
+    for (uint8_t i = 0; i < TETRIS_CORE_NEXT_QUEUE_LENGTH; i++)
+    {
+        is_changed |= (shown_ptr->next_mino_queue[i] != mino_ptr->next_mino_queue[i]);
+        shown_ptr->next_mino_queue[i] = mino_ptr->next_mino_queue[i];
+    }
+
+    shown_ptr->level = game_parameter_ptr->level;
+    shown_ptr->row_deleted = game_parameter_ptr->row_deleted;
+    shown_ptr->score = game_parameter_ptr->score;
+    shown_ptr->hold_mino_type = mino_ptr->hold_mino_type;
+    shown_ptr->is_holding = mino_ptr->is_holding;
+    shown_ptr->piece_set = core_state_ptr->piece_set;
+
+    return is_changed;
+}
+
+/**
+ * @brief 固定UIレイヤ取得
  * @param dst_bitmap 出力先ビットマップ
- * @param num 変換対象数値
  * @return なし
- * @details 数値を10進数の文字列に分解し、各桁のビットマップを取得して重ねることで、数値全体のビットマップを生成する
+ * @details 定数のビットマップレイヤーを取得するだけ
  */
-static void get_number_string_bitmap(bitmap_128_t dst_bitmap, uint16_t num)
+static void overlay_Fixed_UI(bitmap_128_t dst_bitmap)
 {
-    bitmap_128_t ret_bitmap = {0};
+    BITMAP_or(dst_bitmap, tetris_bitmap_def_fixed_UI);
+}
 
-    int num_array[100]; // 100のサイズは適当
-    int digits = MATH_split_digits(num_array, num);
+/**
+ * @brief 情報レイヤ合成
+ * @param dst_bitmap 出力先ビットマップ
+ * @param compute_state_ptr 演算状態
+ * @details ディスプレイの右画面に表示するパラメータ表示のビットマップを生成
+ *          ネクスト・ホールドはキャッシュ済みスプライトを行単位で重ねるだけなので、表示数を増やしても描画時間はほぼ増えない
+ *          表示位置はピースセット毎の配置定義に従う
+ * @return なし
+ */
+static void overlay_information_layer(bitmap_128_t dst_bitmap, const tetris_compute_state_t *compute_state_ptr)
+{
+    const TETRIS_CORE_mino_parameter_t *mino_ptr = &compute_state_ptr->core_state.mino_parameter;
+    const information_layout_t *layout_ptr = &information_layout[compute_state_ptr->core_state.piece_set];
 
-    for (uint8_t d = 0; d < digits; d++)
+    // ネクストミノ（1番目は枠内に拡大表示、2番目以降は枠の下に縮小表示）
+    overlay_sprite(dst_bitmap, &next_mino_sprite[mino_ptr->next_mino_queue[0]], VISUALIZE_MINO_DEF_LENGTH, layout_ptr->next_mino_x, layout_ptr->next_mino_y);
+    for (uint8_t i = 1; i <= layout_ptr->next_queue_number && i < TETRIS_CORE_NEXT_QUEUE_LENGTH; i++)
     {
-        bitmap_128_t temp_bitmap = {0};
-        get_number_bitmap(temp_bitmap, num_array[d]);
-        BITMAP_shift(temp_bitmap, d * 5, 0);
-
-        BITMAP_or(ret_bitmap, temp_bitmap);
+        overlay_sprite(dst_bitmap, &small_mino_sprite[mino_ptr->next_mino_queue[i]], SMALL_MINO_HEIGHT, layout_ptr->next_queue_x + (i - 1) * layout_ptr->next_queue_pitch, layout_ptr->next_queue_y);
     }
 
-    BITMAP_copy(dst_bitmap, ret_bitmap); // ビットマップを上書き
+    // ホールドミノ
+    overlay_sprite(dst_bitmap, &hold_frame_sprite[compute_state_ptr->core_state.piece_set], layout_ptr->hold_frame_height, layout_ptr->hold_frame_x, layout_ptr->hold_frame_y);
+    if (mino_ptr->is_holding)
+        overlay_sprite(dst_bitmap, &small_mino_sprite[mino_ptr->hold_mino_type], SMALL_MINO_HEIGHT, layout_ptr->hold_frame_x + 2, layout_ptr->hold_frame_y + 2);
+
+    // レベル、消去行、スコア（キャッシュ済みの数字スプライトを重ねる）
+    overlay_number_sprite(dst_bitmap, compute_state_ptr->core_state.game_parameter.level, 91, 63);        // 位置は手動設定
+    overlay_number_sprite(dst_bitmap, compute_state_ptr->core_state.game_parameter.row_deleted, 91, 90);  // 位置は手動設定
+    overlay_number_sprite(dst_bitmap, compute_state_ptr->core_state.game_parameter.score, 91, 116);       // 位置は手動設定
 }
 
 /**
@@ -292,7 +730,7 @@ static void get_number_bitmap(bitmap_128_t dst_bitmap, uint8_t num)
  * @details 描画用ミノのビットマップは、2枚の128×128ビットマップに複数のミノを並べて埋め込んでいる（容量削減のため）
  *          ミノの種別と回転状態を指定することで、その2枚のビットマップから欲しいミノを抽出する
  */
-static void get_visualize_mino_bitmap(bitmap_128_t dst, const bitmap_128_t visualize_mino_definition_1, const bitmap_128_t visualize_mino_definition_2, tetris_mino_type_t mino_type, tetris_mino_turn_state_t turn)
+static void get_visualize_mino_bitmap(bitmap_128_t dst, const bitmap_128_t visualize_mino_definition_1, const bitmap_128_t visualize_mino_definition_2, TETRIS_CORE_mino_type_t mino_type, TETRIS_CORE_mino_turn_state_t turn)
 {
     // ミノ定義のビットマップを2枚に分けているので、どちらを参照するかを選択
     uint8_t select_bitmap_num = (mino_type < mino_S) ? 1 : 2;
@@ -312,4 +750,554 @@ static void get_visualize_mino_bitmap(bitmap_128_t dst, const bitmap_128_t visua
     {
         BITMAP_extract(dst, visualize_mino_definition_2, start_x, end_X, start_y, end_y);
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief ネクスト・ホールド表示用スプライトキャッシュ生成
+ * @return なし
+ * @details ネクスト1番目用はテトリミノは定数ビットマップから、それ以外（ペントミノ）はゲームコアのミノ形状から生成する
+ *          縮小表示用はゲームコアのミノ形状から全ミノ種別分を生成する
+ *          ビットマップの抽出・シフトは重い処理なので、ゲーム中は行わずここで1回だけ実行する
+ */
+static void cache_mino_sprite()
+{
+    for (TETRIS_CORE_mino_type_t mino_type = mino_I; mino_type < TETRIS_CORE_NUMBER_MINO_TYPES; mino_type++)
+    {
+        if (mino_type < mino_F5)
+        {
+            bitmap_128_t mino_bitmap = {0};
+            get_visualize_mino_bitmap(mino_bitmap, tetris_bitmap_def_next_mino_1, tetris_bitmap_def_next_mino_2, mino_type, r_no_turn);
+            for (uint8_t y = 0; y < VISUALIZE_MINO_DEF_LENGTH; y++)
+            {
+                next_mino_sprite[mino_type].row[y] = (uint32_t)(mino_bitmap[y][0] >> 32); // 左上に詰めて抽出されているので上位32bitのみ
+            }
+        }
+        else
+        {
+            get_mino_sprite(&next_mino_sprite[mino_type], mino_type, LARGE_MINO_BLOCK_SIZE, large_mino_block_dots, NEXT_FRAME_INNER_WIDTH, NEXT_FRAME_INNER_HEIGHT);
+        }
+
+        get_mino_sprite(&small_mino_sprite[mino_type], mino_type, SMALL_MINO_BLOCK_SIZE, small_mino_block_dots, 0, 0);
+    }
+
+    // 数字（左上に詰めて抽出されているので上位32bitのみ）
+    for (uint8_t num = 0; num < 10; num++)
+    {
+        bitmap_128_t number_bitmap = {0};
+        get_number_bitmap(number_bitmap, num);
+        for (uint8_t y = 0; y < NUMBER_HEIGHT; y++)
+        {
+            number_sprite[num].row[y] = (uint32_t)(number_bitmap[y][0] >> 32);
+        }
+    }
+
+    // ホールド枠（上下の辺と左右の辺）
+    for (uint8_t piece_set = 0; piece_set < TETRIS_CORE_NUMBER_PIECE_SETS; piece_set++)
+    {
+        const information_layout_t *layout_ptr = &information_layout[piece_set];
+        uint32_t frame_edge = ~(uint32_t)0 << (32 - layout_ptr->hold_frame_width);
+        uint32_t frame_side = (1u << 31) | (1u << (32 - layout_ptr->hold_frame_width));
+        for (uint8_t y = 0; y < layout_ptr->hold_frame_height; y++)
+        {
+            hold_frame_sprite[piece_set].row[y] = (0 == y || layout_ptr->hold_frame_height - 1 == y) ? frame_edge : frame_side;
+        }
+    }
+}
+
+/**
+ * @brief ミノスプライト生成
+ * @param sprite_ptr 出力先スプライト
+ * @param mino_type ミノ種別
+ * @param block_size 1ブロックのドット数（縦横）
+ * @param block_dots 1ブロックの各行のドット（bit0が右端）
+ * @param area_width 中央に寄せる領域の幅（0なら左に寄せる）
+ * @param area_height 中央に寄せる領域の高さ（0なら上に寄せる）
+ * @return なし
+ * @details 回転無しのミノ形状を1ブロックblock_sizeドット四方で描画する。形状定義の空白行・空白列は詰めてから、指定の領域の中央に寄せる
+ */
+static void get_mino_sprite(mino_sprite_t *sprite_ptr, TETRIS_CORE_mino_type_t mino_type, uint8_t block_size, const uint8_t block_dots[], uint8_t area_width, uint8_t area_height)
+{
+    uint32_t mino_shape = TETRIS_CORE_get_mino_shape(mino_type, r_no_turn);
+    uint8_t top = TETRIS_CORE_MINO_LENGTH;
+    uint8_t left = TETRIS_CORE_MINO_LENGTH;
+    uint8_t bottom = 0;
+    uint8_t right = 0;
+
+    // ブロックのある最上行・最左列・最下行・最右列を探す
+    for (uint8_t mino_row = 0; mino_row < TETRIS_CORE_MINO_LENGTH; mino_row++)
+    {
+        for (uint8_t mino_column = 0; mino_column < TETRIS_CORE_MINO_LENGTH; mino_column++)
+        {
+            if (mino_shape & TETRIS_CORE_MINO_CELL_BIT(mino_row, mino_column))
+            {
+                top = (mino_row < top) ? mino_row : top;
+                left = (mino_column < left) ? mino_column : left;
+                bottom = (bottom < mino_row) ? mino_row : bottom;
+                right = (right < mino_column) ? mino_column : right;
+            }
+        }
+    }
+
+    // 中央寄せの余白
+    uint8_t width = (right - left + 1) * block_size;
+    uint8_t height = (bottom - top + 1) * block_size;
+    uint8_t offset_x = (width < area_width) ? (area_width - width) / 2 : 0;
+    uint8_t offset_y = (height < area_height) ? (area_height - height) / 2 : 0;
+
+    *sprite_ptr = (mino_sprite_t){0};
+    for (uint8_t mino_row = top; mino_row <= bottom; mino_row++)
+    {
+        for (uint8_t mino_column = left; mino_column <= right; mino_column++)
+        {
+            if (!(mino_shape & TETRIS_CORE_MINO_CELL_BIT(mino_row, mino_column)))
+                continue;
+
+            uint8_t dot_shift = 32 - offset_x - block_size * (mino_column - left + 1);
+            for (uint8_t dot_y = 0; dot_y < block_size; dot_y++)
+            {
+                sprite_ptr->row[offset_y + (mino_row - top) * block_size + dot_y] |= (uint32_t)block_dots[dot_y] << dot_shift;
+            }
+        }
+    }
+}
+
+/**
+ * @brief スプライト重ね合わせ
+ * @param dst_bitmap 出力先ビットマップ
+ * @param sprite_ptr スプライト
+ * @param height スプライトの描画行数
+ * @param x 描画位置（スプライト左上の列）
+ * @param y 描画位置（スプライト左上の行）
+ * @return なし
+ * @details スプライト1行を64bitに広げて出力先の行に直接ORする（ビットマップ全体のコピー・シフトを行わない）
+ */
+static void overlay_sprite(bitmap_128_t dst_bitmap, const mino_sprite_t *sprite_ptr, uint8_t height, uint8_t x, uint8_t y)
+{
+    for (uint8_t sprite_y = 0; sprite_y < height && y + sprite_y < 128; sprite_y++)
+    {
+        or_dots(dst_bitmap, y + sprite_y, (uint64_t)sprite_ptr->row[sprite_y] << 32, x);
+    }
+}
+
+/**
+ * @brief 数値スプライト重ね合わせ
+ * @param dst_bitmap 出力先ビットマップ
+ * @param num 表示する数値
+ * @param x 描画位置（最上位桁の左上の列）
+ * @param y 描画位置（最上位桁の左上の行）
+ * @return なし
+ * @details 数値を10進数の各桁に分解し、キャッシュ済みの数字スプライトを5ドット間隔で行単位に重ねる
+ */
+static void overlay_number_sprite(bitmap_128_t dst_bitmap, uint32_t num, uint8_t x, uint8_t y)
+{
+    int num_array[100]; // 100のサイズは適当
+    int digits = MATH_split_digits(num_array, (int)num); // スコアは7桁で頭打ちなのでintに収まる
+
+    for (uint8_t d = 0; d < digits; d++)
+    {
+        overlay_sprite(dst_bitmap, &number_sprite[num_array[d]], NUMBER_HEIGHT, x + d * NUMBER_PITCH, y);
+    }
+}
+
+/**
+ * @brief CPU対戦用 盤面重ね合わせ
+ * @param dst_bitmap 出力先ビットマップ
+ * @param compute_state_ptr 演算状態
+ * @param board_x 盤面の描画位置（左端の列）
+ * @param garbage_x 受け取り待ち行数メータの描画位置（左端の列）
+ * @param next_x ネクスト1番目の描画位置（左端の列）
+ * @param score_x スコアの描画位置（左端の列）
+ * @return なし
+ * @details 描画範囲の各行について、フィールド行に操作ミノを重ねてから壁を除いて詰め、5マスずつ表引きでドット列に展開する
+ *          落下地点はブロックと重ならないマスのみ、4×4ドットの枠で描画する。ブロックの無い行は何もしない
+ */
+static void overlay_versus_board(bitmap_128_t dst_bitmap, const tetris_compute_state_t *compute_state_ptr, uint8_t board_x, uint8_t garbage_x, uint8_t next_x, uint8_t score_x)
+{
+    const TETRIS_CORE_state_t *core_state_ptr = &compute_state_ptr->core_state;
+    const TETRIS_CORE_mino_parameter_t *mino_ptr = &core_state_ptr->mino_parameter;
+    uint32_t mino_shape = TETRIS_CORE_get_mino_shape(mino_ptr->mino_type, mino_ptr->turn_state);
+    int8_t landing_y = mino_ptr->reference_y + mino_ptr->distance_to_landing;
+
+    // 盤面
+    for (uint8_t visible_row = 0; visible_row < TETRIS_CORE_FIELD_VISIBLE_ROWS; visible_row++)
+    {
+        int8_t field_y = TETRIS_CORE_FIELD_VISIBLE_TOP + visible_row;
+        uint16_t block_row = core_state_ptr->field_parameter.row[field_y];
+        uint16_t ghost_row = 0;
+        if (!mino_ptr->is_next_mino_generate) // 操作ミノ無しの間はフィールドのみ
+        {
+            block_row |= get_mino_field_row(mino_shape, field_y - mino_ptr->reference_y, mino_ptr->reference_x);
+            ghost_row = get_mino_field_row(mino_shape, field_y - landing_y, mino_ptr->reference_x);
+        }
+
+        // 壁を除いてフィールド幅分のbit（最上位が左端の列）に詰める
+        uint16_t block_bits = (block_row & TETRIS_CORE_ROW_BLOCK_MASK) >> TETRIS_CORE_ROW_BLOCK_SHIFT;
+        uint16_t ghost_bits = ((ghost_row & TETRIS_CORE_ROW_BLOCK_MASK) >> TETRIS_CORE_ROW_BLOCK_SHIFT) & ~block_bits;
+        if (!(block_bits | ghost_bits))
+            continue;
+
+        uint64_t edge_dots = expand_versus_row(block_bits | ghost_bits, versus_cell_solid);                                      // 1マスの上下端の行
+        uint64_t side_dots = expand_versus_row(block_bits, versus_cell_solid) | expand_versus_row(ghost_bits, versus_cell_ghost); // 1マスの中間の行
+        uint8_t y = VERSUS_BOARD_Y + visible_row * VERSUS_CELL_SIZE;
+        or_dots(dst_bitmap, y, edge_dots, board_x);
+        for (uint8_t dot_y = 1; dot_y < VERSUS_CELL_FILL - 1; dot_y++)
+        {
+            or_dots(dst_bitmap, y + dot_y, side_dots, board_x);
+        }
+        or_dots(dst_bitmap, y + VERSUS_CELL_FILL - 1, edge_dots, board_x);
+    }
+
+    // 受け取り待ち行数メータ（盤面の下端から伸ばす）
+    uint64_t meter_dots = ~(UINT64_MAX >> VERSUS_GARBAGE_METER_WIDTH);
+    for (uint8_t dot_y = 0; dot_y < core_state_ptr->garbage.pending * VERSUS_CELL_SIZE && dot_y < VERSUS_BOARD_HEIGHT; dot_y++)
+    {
+        or_dots(dst_bitmap, VERSUS_BOARD_Y + VERSUS_BOARD_HEIGHT - 1 - dot_y, meter_dots, garbage_x);
+    }
+
+    // ネクスト1番目・スコア
+    overlay_sprite(dst_bitmap, &small_mino_sprite[mino_ptr->next_mino_queue[0]], SMALL_MINO_HEIGHT, next_x, VERSUS_NEXT_Y);
+    overlay_number_sprite(dst_bitmap, core_state_ptr->game_parameter.score, score_x, VERSUS_SCORE_Y);
+}
+
+/**
+ * @brief ミノ行マスク取得（範囲外考慮）
+ * @param mino_shape ミノ形状
+ * @param mino_row ミノ定義の行（0～4以外ならミノ無しの行）
+ * @param reference_x ミノの基準点（X軸）
+ * @return フィールド行と同じ座標系のミノ行マスク
+ */
+static uint16_t get_mino_field_row(uint32_t mino_shape, int8_t mino_row, int8_t reference_x)
+{
+    if (mino_row < 0 || TETRIS_CORE_MINO_LENGTH <= mino_row)
+        return 0;
+
+    return (uint16_t)TETRIS_CORE_get_mino_row_mask(mino_shape, (uint8_t)mino_row, reference_x);
+}
+
+/**
+ * @brief CPU対戦用 盤面1行展開
+ * @param row_bits 盤面1行のマス（フィールド幅分のbit、最上位が左端の列）
+ * @param cell_table 5マス分の行展開表
+ * @return 盤面1行分のドット列（bit63が盤面の左端）
+ * @details 右端を5マス単位まで0で埋めてから、左から5マスずつ表引きして繋げる
+ */
+static uint64_t expand_versus_row(uint16_t row_bits, const uint32_t cell_table[])
+{
+    uint16_t padded_bits = row_bits << (VERSUS_CELL_TABLE_CHUNKS * VERSUS_CELL_TABLE_COLUMNS - TETRIS_CORE_FIELD_WIDTH);
+    uint64_t dots = 0;
+    for (int8_t chunk = VERSUS_CELL_TABLE_CHUNKS - 1; 0 <= chunk; chunk--)
+    {
+        uint8_t cells = (padded_bits >> (chunk * VERSUS_CELL_TABLE_COLUMNS)) & ((1 << VERSUS_CELL_TABLE_COLUMNS) - 1);
+        dots = (dots << (VERSUS_CELL_TABLE_COLUMNS * VERSUS_CELL_SIZE)) | cell_table[cells];
+    }
+
+    return dots << (64 - VERSUS_CELL_TABLE_CHUNKS * VERSUS_CELL_TABLE_COLUMNS * VERSUS_CELL_SIZE);
+}
+
+/**
+ * @brief プレイフィールドのマスのスタンプ生成
+ * @return なし
+ * @details フィールドの寸法・拡大率が定数ビットマップの前提（10×20を6倍）と同じなら、定数ビットマップのフィールド範囲の各行を切り出す
+ *          （定数ビットマップは描画範囲の最上段に模様が無く、その行のブロックは表示されない。従来の表示に合わせてそのまま使う）
+ *          異なる場合は、拡大率に合わせた1ブロック分の模様をフィールド幅分並べて生成する
+ *          模様は定数ビットマップに合わせ、ブロックは外周＋中央、落下地点は中央のみ（5倍未満では中央が取れないので、ブロックは外周のみ・落下地点は外周の内側）
+ */
+static void cache_field_stamp()
+{
+    uint64_t field_mask = ~(uint64_t)0 << (64 - FIELD_DOT_WIDTH);
+
+    if (FIELD_CONST_LAYER_WIDTH == TETRIS_CORE_FIELD_WIDTH && FIELD_CONST_LAYER_ROWS == TETRIS_CORE_FIELD_VISIBLE_ROWS && FIELD_CONST_LAYER_SCALE == FIELD_SCALE)
+    {
+        for (uint8_t dot_row = 0; dot_row < FIELD_DOT_HEIGHT; dot_row++)
+        {
+            uint8_t y = FIELD_Y + dot_row;
+            block_stamp_rows[dot_row] = ((tetris_bitmap_def_field_layer[y][0] << FIELD_X) | (tetris_bitmap_def_field_layer[y][1] >> (64 - FIELD_X))) & field_mask;
+            ghost_stamp_rows[dot_row] = ((tetris_bitmap_def_falling_point_layer[y][0] << FIELD_X) | (tetris_bitmap_def_falling_point_layer[y][1] >> (64 - FIELD_X))) & field_mask;
+        }
+        return;
+    }
+
+    uint8_t center_start = (5 <= FIELD_SCALE) ? 2 : 1;
+    uint8_t center_end = FIELD_SCALE - center_start; // この列・行を含まない
+    for (uint8_t cell_y = 0; cell_y < FIELD_SCALE; cell_y++)
+    {
+        // 1マス分の1ドット行（bit(FIELD_SCALE-1)が左端）
+        uint64_t block_dots = 0;
+        uint64_t ghost_dots = 0;
+        for (uint8_t cell_x = 0; cell_x < FIELD_SCALE; cell_x++)
+        {
+            bool is_edge = (0 == cell_x || FIELD_SCALE - 1 == cell_x || 0 == cell_y || FIELD_SCALE - 1 == cell_y);
+            bool is_center = (center_start <= cell_x && cell_x < center_end && center_start <= cell_y && cell_y < center_end);
+            uint64_t dot = (uint64_t)1 << (FIELD_SCALE - 1 - cell_x);
+
+            block_dots |= (is_edge || (is_center && 5 <= FIELD_SCALE)) ? dot : 0;
+            ghost_dots |= is_center ? dot : 0;
+        }
+
+        // フィールド幅分並べる
+        uint64_t block_row = 0;
+        uint64_t ghost_row = 0;
+        for (uint8_t column = 0; column < TETRIS_CORE_FIELD_WIDTH; column++)
+        {
+            block_row = (block_row << FIELD_SCALE) | block_dots;
+            ghost_row = (ghost_row << FIELD_SCALE) | ghost_dots;
+        }
+        for (uint8_t dot_row = cell_y; dot_row < FIELD_DOT_HEIGHT; dot_row += FIELD_SCALE)
+        {
+            block_stamp_rows[dot_row] = block_row << (64 - FIELD_DOT_WIDTH);
+            ghost_stamp_rows[dot_row] = ghost_row << (64 - FIELD_DOT_WIDTH);
+        }
+    }
+}
+
+/**
+ * @brief CPU対戦画面用キャッシュ生成
+ * @return なし
+ * @details 行展開表（5マス分の有無→ドット列）と盤面枠レイヤを生成する
+ */
+static void cache_versus_layer()
+{
+    // 行展開表（1マス：左からVERSUS_CELL_FILLドットの塗りつぶし or 両端のみ、右端1ドットは隙間）
+    uint32_t solid_pattern = ((1u << VERSUS_CELL_FILL) - 1) << 1;
+    uint32_t ghost_pattern = (1u << VERSUS_CELL_FILL) | (1u << 1);
+    for (uint8_t cells = 0; cells < (1 << VERSUS_CELL_TABLE_COLUMNS); cells++)
+    {
+        versus_cell_solid[cells] = 0;
+        versus_cell_ghost[cells] = 0;
+        for (uint8_t column = 0; column < VERSUS_CELL_TABLE_COLUMNS; column++)
+        {
+            if (!(cells & (1 << (VERSUS_CELL_TABLE_COLUMNS - 1 - column))))
+                continue;
+
+            uint8_t shift = (VERSUS_CELL_TABLE_COLUMNS - 1 - column) * VERSUS_CELL_SIZE;
+            versus_cell_solid[cells] |= solid_pattern << shift;
+            versus_cell_ghost[cells] |= ghost_pattern << shift;
+        }
+    }
+
+    // 盤面枠（左右の辺と下の辺）
+    const uint8_t board_x[] = {VERSUS_PLAYER_BOARD_X, VERSUS_OPPONENT_BOARD_X};
+    for (uint8_t i = 0; i < sizeof(board_x) / sizeof(board_x[0]); i++)
+    {
+        BITMAP_vertical_line(versus_frame_layer, board_x[i] - 1, 0, VERSUS_BOARD_Y + VERSUS_BOARD_HEIGHT);
+        BITMAP_vertical_line(versus_frame_layer, board_x[i] + VERSUS_BOARD_WIDTH, 0, VERSUS_BOARD_Y + VERSUS_BOARD_HEIGHT);
+        BITMAP_horizontal_line(versus_frame_layer, board_x[i] - 1, VERSUS_BOARD_Y + VERSUS_BOARD_HEIGHT, VERSUS_BOARD_WIDTH + 2);
+    }
+}
+
+/**
+ * @brief ドット列重ね合わせ
+ * @param dst_bitmap 出力先ビットマップ
+ * @param y 描画する行
+ * @param dots ドット列（bit63が描画位置の列）
+ * @param x 描画位置（ドット列の左端の列）
+ * @return なし
+ * @details 64bitのドット列を出力先の行に直接ORする（画面右端からはみ出た分は捨てる）
+ */
+static void or_dots(bitmap_128_t dst_bitmap, uint8_t y, uint64_t dots, uint8_t x)
+{
+    if (!dots)
+        return;
+
+    if (x < 64)
+    {
+        dst_bitmap[y][0] |= dots >> x;
+        if (x)
+            dst_bitmap[y][1] |= dots << (64 - x);
+    }
+    else
+    {
+        dst_bitmap[y][1] |= dots >> (x - 64);
+    }
+}
+
+/**
+ * @brief ドット列消去
+ * @param dst_bitmap 出力先ビットマップ
+ * @param y 消去する行
+ * @param dots 消去するドット列（bit63が左端）
+ * @param x 消去位置（ドット列の左端の列）
+ * @return なし
+ * @details or_dotsで重ねた範囲を0に戻す（右端からはみ出た分は捨てる）
+ */
+static void clear_dots(bitmap_128_t dst_bitmap, uint8_t y, uint64_t dots, uint8_t x)
+{
+    if (!dots)
+        return;
+
+    if (x < 64)
+    {
+        dst_bitmap[y][0] &= ~(dots >> x);
+        if (x)
+            dst_bitmap[y][1] &= ~(dots << (64 - x));
+    }
+    else
+    {
+        dst_bitmap[y][1] &= ~(dots >> (x - 64));
+    }
+}
+
+/**
+ * @brief ゲームモード選択表示重ね合わせ
+ * @param dst_bitmap 出力先ビットマップ
+ * @param selected_mode 選択中のゲームモード
+ * @return なし
+ * @details フィールド表示領域の中央にモード名、その左右に選択を送る方向の矢印を描く
+ */
+static void overlay_mode_label(bitmap_128_t dst_bitmap, tetris_game_mode_t selected_mode)
+{
+    uint8_t label_x = FIELD_AREA_X + (FIELD_AREA_WIDTH - mode_label_width[selected_mode]) / 2;
+
+    for (uint8_t y = 0; y < MODE_LABEL_HEIGHT; y++)
+    {
+        or_dots(dst_bitmap, MODE_LABEL_Y + y, (uint64_t)mode_label_sprite[selected_mode][y] << 32, label_x);
+        or_dots(dst_bitmap, MODE_LABEL_Y + y, (uint64_t)mode_arrow_left[y] << 32, MODE_ARROW_LEFT_X);
+        or_dots(dst_bitmap, MODE_LABEL_Y + y, (uint64_t)mode_arrow_right[y] << 32, MODE_ARROW_RIGHT_X);
+    }
+}
+
+/**
+ * @brief ゲームタイマ重ね合わせ
+ * @param dst_bitmap 出力先ビットマップ
+ * @param centiseconds 表示する時間[10ms]
+ * @return なし
+ * @details 画面全体を合成するフレームで呼び、区切り記号（:と.）と全桁を描いて、表示中の桁として記録する
+ */
+static void overlay_timer(bitmap_128_t dst_bitmap, uint32_t centiseconds)
+{
+    split_timer_digits(shown_timer_digits, centiseconds);
+
+    for (uint8_t d = 0; d < TIMER_DIGITS; d++)
+    {
+        overlay_sprite(dst_bitmap, &number_sprite[shown_timer_digits[d]], NUMBER_HEIGHT, timer_digit_x[d], TIMER_Y);
+    }
+
+    // 区切り記号（分と秒の間に:、秒と1/100秒の間に.）
+    uint64_t dot = (uint64_t)1 << 63;
+    or_dots(dst_bitmap, TIMER_Y + 2, dot, timer_digit_x[1] - 2);
+    or_dots(dst_bitmap, TIMER_Y + 4, dot, timer_digit_x[1] - 2);
+    or_dots(dst_bitmap, TIMER_Y + NUMBER_HEIGHT - 1, dot, timer_digit_x[3] - 2);
+}
+
+/**
+ * @brief ゲームタイマ差分更新
+ * @param centiseconds 表示する時間[10ms]
+ * @return なし
+ * @details オーバーレイレイヤのうち、変化した桁の4×7ドットのみを描き直し、変化した桁を含む範囲をレイヤの変化範囲として登録する
+ *          （合成・送信されるのは通常1/100秒の1桁のみ）
+ */
+static void update_timer_digits(uint32_t centiseconds)
+{
+    uint8_t digits[TIMER_DIGITS];
+    split_timer_digits(digits, centiseconds);
+
+    uint8_t x_first = UINT8_MAX;
+    uint8_t x_last = 0;
+    for (uint8_t d = 0; d < TIMER_DIGITS; d++)
+    {
+        if (digits[d] == shown_timer_digits[d])
+            continue;
+
+        for (uint8_t y = 0; y < NUMBER_HEIGHT; y++)
+        {
+            clear_dots(overlay_layer, TIMER_Y + y, (uint64_t)number_sprite[shown_timer_digits[d]].row[y] << 32, timer_digit_x[d]);
+            or_dots(overlay_layer, TIMER_Y + y, (uint64_t)number_sprite[digits[d]].row[y] << 32, timer_digit_x[d]);
+        }
+        shown_timer_digits[d] = digits[d];
+
+        x_first = (timer_digit_x[d] < x_first) ? timer_digit_x[d] : x_first;
+        x_last = timer_digit_x[d] + NUMBER_WIDTH - 1;
+    }
+
+    if (x_first <= x_last)
+        tetris_invalidate_display_layer(display_layer_overlay, x_first, TIMER_Y, x_last - x_first + 1, NUMBER_HEIGHT);
+}
+
+/**
+ * @brief ゲームタイマ桁分解
+ * @param digits 各桁の数字格納先（分、秒の10の位、秒の1の位、1/100秒の10の位、1/100秒の1の位）
+ * @param centiseconds 表示する時間[10ms]（9:59.99以下）
+ * @return なし
+ */
+static void split_timer_digits(uint8_t digits[], uint32_t centiseconds)
+{
+    uint32_t seconds = centiseconds / 100;
+
+    digits[0] = (uint8_t)(seconds / 60);
+    digits[1] = (uint8_t)(seconds % 60 / 10);
+    digits[2] = (uint8_t)(seconds % 10);
+    digits[3] = (uint8_t)(centiseconds % 100 / 10);
+    digits[4] = (uint8_t)(centiseconds % 10);
+}
+
+/**
+ * @brief プレイ統計重ね合わせ
+ * @param dst_bitmap 出力先ビットマップ（ゲームオーバー時の画面）
+ * @param statistics_ptr プレイ統計
+ * @return なし
+ * @details 表示範囲のドットを消してから、PPS・KPP・最少手順超過入力数・4行消去とTスピン消去の回数を1行ずつ描く
+ */
+static void overlay_play_statistics(bitmap_128_t dst_bitmap, const TETRIS_CORE_play_statistics_t *statistics_ptr)
+{
+    uint64_t panel_dots = ~(uint64_t)0 << (64 - FIELD_AREA_WIDTH);
+    for (uint8_t y = 0; y < STATS_PANEL_HEIGHT; y++)
+    {
+        clear_dots(dst_bitmap, STATS_PANEL_Y + y, panel_dots, FIELD_AREA_X);
+    }
+
+    uint8_t y = STATS_PANEL_Y + 1;
+    overlay_stats_label(dst_bitmap, stats_label_pps, STATS_LABEL_X, y);
+    overlay_fixed_point_sprite(dst_bitmap, TETRIS_CORE_get_pieces_per_second_x100(statistics_ptr), STATS_VALUE_X, y);
+
+    y += STATS_ROW_PITCH;
+    overlay_stats_label(dst_bitmap, stats_label_kpp, STATS_LABEL_X, y);
+    overlay_fixed_point_sprite(dst_bitmap, TETRIS_CORE_get_inputs_per_piece_x100(statistics_ptr), STATS_VALUE_X, y);
+
+    y += STATS_ROW_PITCH;
+    overlay_stats_label(dst_bitmap, stats_label_finesse, STATS_LABEL_X, y);
+    overlay_number_sprite(dst_bitmap, statistics_ptr->finesse_fault_count, STATS_VALUE_X, y);
+
+    y += STATS_ROW_PITCH;
+    overlay_stats_label(dst_bitmap, stats_label_four_rows, STATS_LABEL_X, y);
+    overlay_number_sprite(dst_bitmap, statistics_ptr->clear_count[TETRIS_CORE_ERASE_ROW_MAX], STATS_LABEL_X + STATS_SHORT_VALUE_OFFSET, y);
+    overlay_stats_label(dst_bitmap, stats_label_t_spin, STATS_SECOND_LABEL_X, y);
+    overlay_number_sprite(dst_bitmap, statistics_ptr->t_spin_clear_count, STATS_SECOND_LABEL_X + STATS_SHORT_VALUE_OFFSET, y);
+}
+
+/**
+ * @brief プレイ統計ラベル重ね合わせ
+ * @param dst_bitmap 出力先ビットマップ
+ * @param label ラベル
+ * @param x 描画位置（左端の列）
+ * @param y 描画位置（数字の上端の行。ラベルは数字の高さの中央に寄せる）
+ * @return なし
+ */
+static void overlay_stats_label(bitmap_128_t dst_bitmap, stats_label_t label, uint8_t x, uint8_t y)
+{
+    for (uint8_t row = 0; row < MODE_LABEL_HEIGHT; row++)
+    {
+        or_dots(dst_bitmap, y + (NUMBER_HEIGHT - MODE_LABEL_HEIGHT) / 2 + row, (uint64_t)stats_label_sprite[label][row] << 32, x);
+    }
+}
+
+/**
+ * @brief 小数2桁の数値スプライト重ね合わせ
+ * @param dst_bitmap 出力先ビットマップ
+ * @param value_x100 表示する値×100
+ * @param x 描画位置（最上位桁の左上の列）
+ * @param y 描画位置（最上位桁の左上の行）
+ * @return なし
+ * @details 整数部・小数点・小数部2桁の順に描く（小数点はゲームタイマと同じ1ドット）
+ */
+static void overlay_fixed_point_sprite(bitmap_128_t dst_bitmap, uint32_t value_x100, uint8_t x, uint8_t y)
+{
+    int num_array[10];
+    uint8_t digits = (uint8_t)MATH_split_digits(num_array, (int)(value_x100 / 100));
+    uint8_t fraction = (uint8_t)(value_x100 % 100);
+
+    overlay_number_sprite(dst_bitmap, value_x100 / 100, x, y);
+    uint8_t dot_x = x + digits * NUMBER_PITCH;
+    or_dots(dst_bitmap, y + NUMBER_HEIGHT - 1, (uint64_t)1 << 63, dot_x);
+    overlay_sprite(dst_bitmap, &number_sprite[fraction / 10], NUMBER_HEIGHT, dot_x + 2, y);
+    overlay_sprite(dst_bitmap, &number_sprite[fraction % 10], NUMBER_HEIGHT, dot_x + 2 + NUMBER_PITCH, y);
+}
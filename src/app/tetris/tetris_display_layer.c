@@ -0,0 +1,242 @@
+/**
+ * @file   tetris_display_layer.c
+ * @brief  tetris・描画レイヤ合成実装
+ * @details ゲーム実行中の画面を描画レイヤ（固定UI・固定済みブロック・落下地点・操作ミノ・情報パネル・オーバーレイ）の重ね合わせとして扱い、
+ *          レイヤ毎に変化した範囲（ダーティ矩形）を記録して、その範囲だけを最終画面に合成し直してディスプレイICに送信する
+ *          レイヤのビットマップは描画制御側が保持・更新し、ここでは変化範囲の管理と合成・送信のみ行う
+ *          重なる矩形は1つにまとめてから合成するので、同じ範囲を2回合成・送信することは無い
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris.h"
+#include "tetris_internal.h"
+#include "SH1107.h"
+#include "bitmap_lib.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define SCREEN_SIZE 128 // 画面の幅・高さ[ドット]
+
+//======================================================
+// 型定義
+//======================================================
+/**
+ * @brief 矩形定義
+ * @details 両端を含む。描画位置・幅は合成するビットマップの座標
+ */
+typedef struct
+{
+    uint8_t x_first; /**< 左端の列 */
+    uint8_t y_first; /**< 上端の行 */
+    uint8_t x_last;  /**< 右端の列 */
+    uint8_t y_last;  /**< 下端の行 */
+} area_t;
+
+/**
+ * @brief レイヤ変化範囲定義
+ */
+typedef struct
+{
+    bool is_dirty; /**< 前回の合成以降に変化したか */
+    area_t area;   /**< 変化した範囲（変化が複数回あれば全てを囲む矩形） */
+} dirty_area_t;
+
+//======================================================
+// 変数・定数
+//======================================================
+static dirty_area_t dirty_area[TETRIS_DISPLAY_LAYER_NUMBER]; // レイヤ毎の変化範囲
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static bool is_area_overlapped(const area_t *area1_ptr, const area_t *area2_ptr);
+static void merge_area(area_t *dst_ptr, const area_t *src_ptr);
+static uint8_t collect_dirty_areas(area_t areas[]);
+static void compose_area(bitmap_128_t frame_bitmap, const uint64_t (*const layer_bitmaps[])[2], const area_t *area_ptr);
+static uint64_t get_column_mask(uint8_t word, uint8_t x_first, uint8_t x_last);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief レイヤ変化範囲登録
+ * @param layer 描画レイヤ
+ * @param x 変化した範囲の左端の列
+ * @param y 変化した範囲の上端の行
+ * @param width 変化した範囲の幅（0なら何もしない）
+ * @param height 変化した範囲の高さ（0なら何もしない）
+ * @return なし
+ * @details 次の合成までに同じレイヤへ複数回登録した場合は、全てを囲む矩形にまとめる。画面外にはみ出た分は捨てる
+ */
+void tetris_invalidate_display_layer(tetris_display_layer_t layer, uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    if (!width || !height || SCREEN_SIZE <= x || SCREEN_SIZE <= y)
+        return;
+
+    area_t area = {
+        .x_first = x,
+        .y_first = y,
+        .x_last = (SCREEN_SIZE - x < width) ? SCREEN_SIZE - 1 : x + width - 1,
+        .y_last = (SCREEN_SIZE - y < height) ? SCREEN_SIZE - 1 : y + height - 1,
+    };
+
+    dirty_area_t *dirty_ptr = &dirty_area[layer];
+    if (dirty_ptr->is_dirty)
+    {
+        merge_area(&dirty_ptr->area, &area);
+    }
+    else
+    {
+        dirty_ptr->area = area;
+        dirty_ptr->is_dirty = true;
+    }
+}
+
+/**
+ * @brief 全レイヤ変化範囲登録
+ * @return なし
+ * @details ゲーム開始・リスタート後の初回描画で呼び、画面全体を合成し直す
+ */
+void tetris_invalidate_all_display_layers()
+{
+    for (uint8_t layer = 0; layer < TETRIS_DISPLAY_LAYER_NUMBER; layer++)
+    {
+        tetris_invalidate_display_layer((tetris_display_layer_t)layer, 0, 0, SCREEN_SIZE, SCREEN_SIZE);
+    }
+}
+
+/**
+ * @brief レイヤ合成・送信
+ * @param frame_bitmap 最終画面（前回の合成結果を保持しておくこと。変化範囲のみ書き換える）
+ * @param layer_bitmaps 各レイヤのビットマップ（tetris_display_layer_tの順）
+ * @return なし
+ * @details 変化したレイヤの範囲を重なり毎に1つの矩形にまとめ、矩形毎に全レイヤのORを最終画面に書き込んで、その範囲のみ送信する
+ *          合成は矩形内の行のみ、1行あたりレイヤ数分のORで済む（変化の無いフレームは何もしない）
+ */
+void tetris_compose_display_layers(bitmap_128_t frame_bitmap, const uint64_t (*const layer_bitmaps[])[2])
+{
+    area_t areas[TETRIS_DISPLAY_LAYER_NUMBER];
+    uint8_t number_of_areas = collect_dirty_areas(areas);
+
+    for (uint8_t i = 0; i < number_of_areas; i++)
+    {
+        compose_area(frame_bitmap, layer_bitmaps, &areas[i]);
+        SH1107_display_bitmap_area_data(frame_bitmap, areas[i].x_first, areas[i].y_first, areas[i].x_last - areas[i].x_first + 1, areas[i].y_last - areas[i].y_first + 1);
+    }
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief 矩形重なり判定
+ * @param area1_ptr 矩形1
+ * @param area2_ptr 矩形2
+ * @return true：1ドット以上重なる
+ */
+static bool is_area_overlapped(const area_t *area1_ptr, const area_t *area2_ptr)
+{
+    return (area1_ptr->x_first <= area2_ptr->x_last) && (area2_ptr->x_first <= area1_ptr->x_last) && (area1_ptr->y_first <= area2_ptr->y_last) && (area2_ptr->y_first <= area1_ptr->y_last);
+}
+
+/**
+ * @brief 矩形結合
+ * @param dst_ptr 結合先の矩形（両方を囲む矩形に広げる）
+ * @param src_ptr 結合する矩形
+ * @return なし
+ */
+static void merge_area(area_t *dst_ptr, const area_t *src_ptr)
+{
+    dst_ptr->x_first = (src_ptr->x_first < dst_ptr->x_first) ? src_ptr->x_first : dst_ptr->x_first;
+    dst_ptr->y_first = (src_ptr->y_first < dst_ptr->y_first) ? src_ptr->y_first : dst_ptr->y_first;
+    dst_ptr->x_last = (dst_ptr->x_last < src_ptr->x_last) ? src_ptr->x_last : dst_ptr->x_last;
+    dst_ptr->y_last = (dst_ptr->y_last < src_ptr->y_last) ? src_ptr->y_last : dst_ptr->y_last;
+}
+
+/**
+ * @brief 合成範囲収集
+ * @param areas 合成範囲格納先（レイヤ数分）
+ * @return 合成範囲の数
+ * @details 変化したレイヤの範囲を集めて変化フラグを下ろし、重なる矩形同士を結合する（結合で広がった矩形は再度全体と比較する）
+ *          フィールド内のレイヤ同士、情報パネルとタイマはそれぞれ1つの矩形になり、左右の画面は別々に送信される
+ */
+static uint8_t collect_dirty_areas(area_t areas[])
+{
+    uint8_t number_of_areas = 0;
+    for (uint8_t layer = 0; layer < TETRIS_DISPLAY_LAYER_NUMBER; layer++)
+    {
+        if (!dirty_area[layer].is_dirty)
+            continue;
+
+        areas[number_of_areas++] = dirty_area[layer].area;
+        dirty_area[layer].is_dirty = false;
+    }
+
+    for (uint8_t i = 0; i < number_of_areas; i++)
+    {
+        for (uint8_t j = i + 1; j < number_of_areas; j++)
+        {
+            if (!is_area_overlapped(&areas[i], &areas[j]))
+                continue;
+
+            merge_area(&areas[i], &areas[j]);
+            areas[j] = areas[--number_of_areas];
+            j = i; // 広がった矩形で最初から比較し直す
+        }
+    }
+
+    return number_of_areas;
+}
+
+/**
+ * @brief 矩形合成
+ * @param frame_bitmap 最終画面
+ * @param layer_bitmaps 各レイヤのビットマップ
+ * @param area_ptr 合成範囲
+ * @return なし
+ * @details 範囲内のドットのみ全レイヤのORで置き換える（範囲外のドットは変更しない）
+ */
+static void compose_area(bitmap_128_t frame_bitmap, const uint64_t (*const layer_bitmaps[])[2], const area_t *area_ptr)
+{
+    uint64_t mask[2];
+    for (uint8_t word = 0; word < 2; word++)
+        mask[word] = get_column_mask(word, area_ptr->x_first, area_ptr->x_last);
+
+    for (uint8_t y = area_ptr->y_first; y <= area_ptr->y_last; y++)
+    {
+        for (uint8_t word = 0; word < 2; word++)
+        {
+            if (!mask[word])
+                continue;
+
+            uint64_t dots = 0;
+            for (uint8_t layer = 0; layer < TETRIS_DISPLAY_LAYER_NUMBER; layer++)
+                dots |= layer_bitmaps[layer][y][word];
+
+            frame_bitmap[y][word] = (frame_bitmap[y][word] & ~mask[word]) | (dots & mask[word]);
+        }
+    }
+}
+
+/**
+ * @brief 列マスク取得
+ * @param word ビットマップ1行の要素（0：列0～63、1：列64～127）
+ * @param x_first 範囲の左端の列
+ * @param x_last 範囲の右端の列
+ * @return 要素内で範囲に含まれる列のビットが1のマスク（bit63が要素の左端）
+ */
+static uint64_t get_column_mask(uint8_t word, uint8_t x_first, uint8_t x_last)
+{
+    int16_t first = (int16_t)x_first - word * 64;
+    int16_t last = (int16_t)x_last - word * 64;
+    if (last < 0 || 63 < first)
+        return 0;
+
+    first = (first < 0) ? 0 : first;
+    last = (63 < last) ? 63 : last;
+
+    return (~(uint64_t)0 >> first) & (~(uint64_t)0 << (63 - last));
+}
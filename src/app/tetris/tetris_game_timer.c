@@ -0,0 +1,150 @@
+/**
+ * @file   tetris_game_timer.c
+ * @brief  tetris・ゲームタイマ（スプリント・ウルトラ）処理実装
+ * @details スプリントは規定行数を消去するまでの経過時間、ウルトラは制限時間の残り時間を計り、終了条件を判定する
+ *          経過時間はステップ数ではなくTIMER_get_time_us()の実時間から求め、ポーズしていた時間を差し引く
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris.h"
+#include "tetris_internal.h"
+#include "tetris_core.h"
+#include "typedef.h"
+#include "timer.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define SPRINT_GOAL_ROWS 40                // スプリントの目標消去行数
+#define ULTRA_TIME_LIMIT_US (120 * 1000000) // ウルトラの制限時間[us]（2分）
+#define CENTISECOND_US 10000               // 表示単位[us]（1/100秒）
+#define DISPLAY_CENTISECONDS_MAX 59999     // 表示上限[10ms]（9:59.99、分は1桁表示）
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static uint64_t get_elapsed_time_us(const tetris_game_timer_t *timer_ptr);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief ゲームタイマ初期化
+ * @param timer_ptr ゲームタイマ格納先
+ * @param game_mode ゲームモード（スプリント・ウルトラ）
+ * @return なし
+ * @details ゲーム開始時＆ゲームオーバー後のゲームリスタート時に呼び、呼んだ時刻から計測を始める
+ */
+void tetris_initialize_game_timer(tetris_game_timer_t *timer_ptr, tetris_game_mode_t game_mode)
+{
+    timer_ptr->game_mode = game_mode;
+    timer_ptr->start_time_us = TIMER_get_time_us();
+    timer_ptr->pause_start_time_us = 0;
+    timer_ptr->paused_time_us = 0;
+    timer_ptr->is_paused = false;
+    timer_ptr->is_finished = false;
+    timer_ptr->display_centiseconds = (game_mode_ultra == game_mode) ? ULTRA_TIME_LIMIT_US / CENTISECOND_US : 0;
+}
+
+/**
+ * @brief ゲームタイマ 演算処理
+ * @param compute_state_ptr 演算状態（今回のステップを処理済みであること）
+ * @param timer_ptr ゲームタイマ
+ * @param state_next 演算処理で決まった次ゲームステート
+ * @return 次ゲームステート
+ * @details 表示する時間を更新し、スプリントは目標行数の消去、ウルトラは制限時間の経過でゲームを終える
+ *          スプリントの表示は目標行数を消去したステップの時間で止まる（以降はゲームオーバー画面になるため更新しない）
+ */
+tetris_game_state_t tetris_data_compute_game_timer(const tetris_compute_state_t *compute_state_ptr, tetris_game_timer_t *timer_ptr, tetris_game_state_t state_next)
+{
+    uint64_t elapsed_us = get_elapsed_time_us(timer_ptr);
+    bool is_finished;
+
+    if (game_mode_ultra == timer_ptr->game_mode)
+    {
+        is_finished = (ULTRA_TIME_LIMIT_US <= elapsed_us);
+        timer_ptr->display_centiseconds = (is_finished) ? 0 : (uint32_t)((ULTRA_TIME_LIMIT_US - elapsed_us) / CENTISECOND_US);
+    }
+    else
+    {
+        is_finished = (SPRINT_GOAL_ROWS <= compute_state_ptr->core_state.game_parameter.row_deleted);
+        uint64_t centiseconds = elapsed_us / CENTISECOND_US;
+        timer_ptr->display_centiseconds = (DISPLAY_CENTISECONDS_MAX < centiseconds) ? DISPLAY_CENTISECONDS_MAX : (uint32_t)centiseconds;
+    }
+
+    timer_ptr->is_finished = is_finished;
+    return (is_finished) ? game_over : state_next;
+}
+
+/**
+ * @brief ゲームタイマ ポーズ切替
+ * @param timer_ptr ゲームタイマ
+ * @param is_pause ポーズ開始時true、ポーズ解除時false
+ * @return なし
+ * @details ポーズ中は経過時間を止め、解除時にポーズしていた時間を累計に加える（同じ指定が続いた場合は何もしない）
+ */
+void tetris_pause_game_timer(tetris_game_timer_t *timer_ptr, bool is_pause)
+{
+    if (is_pause && !timer_ptr->is_paused)
+    {
+        timer_ptr->pause_start_time_us = TIMER_get_time_us();
+        timer_ptr->is_paused = true;
+    }
+    else if (!is_pause && timer_ptr->is_paused)
+    {
+        timer_ptr->paused_time_us += TIMER_get_time_us() - timer_ptr->pause_start_time_us;
+        timer_ptr->is_paused = false;
+    }
+}
+
+/**
+ * @brief ゲームタイマ 経過時間取得
+ * @param timer_ptr ゲームタイマ
+ * @return 計測開始からの経過時間[us]（ポーズしていた時間を除く。32bitで頭打ち）
+ * @details ゲーム中断時に保存する
+ */
+uint32_t tetris_get_game_timer_elapsed_us(const tetris_game_timer_t *timer_ptr)
+{
+    uint64_t elapsed_us = get_elapsed_time_us(timer_ptr);
+
+    return (UINT32_MAX < elapsed_us) ? UINT32_MAX : (uint32_t)elapsed_us;
+}
+
+/**
+ * @brief ゲームタイマ 復元
+ * @param timer_ptr ゲームタイマ格納先
+ * @param game_mode ゲームモード（スプリント・ウルトラ）
+ * @param elapsed_us 中断時の経過時間[us]
+ * @return なし
+ * @details 中断したゲームの再開時に呼び、中断時の経過時間から計測を再開する（電源を切っていた時間は含めない）
+ */
+void tetris_restore_game_timer(tetris_game_timer_t *timer_ptr, tetris_game_mode_t game_mode, uint32_t elapsed_us)
+{
+    tetris_initialize_game_timer(timer_ptr, game_mode);
+    timer_ptr->start_time_us -= elapsed_us; // 起動直後は現在時刻より大きく戻すことになるが、経過時間は差分で求めるので問題無い
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief 経過時間取得
+ * @param timer_ptr ゲームタイマ
+ * @return 計測開始からの経過時間[us]（ポーズしていた時間を除く。ポーズ中はポーズ開始時点の値）
+ */
+static uint64_t get_elapsed_time_us(const tetris_game_timer_t *timer_ptr)
+{
+    uint64_t current_time_us = (timer_ptr->is_paused) ? timer_ptr->pause_start_time_us : TIMER_get_time_us();
+
+    return current_time_us - timer_ptr->start_time_us - timer_ptr->paused_time_us;
+}
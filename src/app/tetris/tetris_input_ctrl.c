@@ -11,6 +11,8 @@
 #include "typedef.h"
 #include "button.h"
 #include "analogStick.h"
+#include "timer.h"
+#include "tetris_core.h"
 
 //======================================================
 // マクロ定義
@@ -21,6 +23,9 @@
 #define AD_INPUT_U_TH -50
 #define AD_INPUT_D_TH 50
 
+// 自動操作でネクストミノまで含めた2手読みを行うか（falseで操作ミノのみ探索、探索時間は約1/30）
+#define AUTOPLAY_LOOKAHEAD_ENABLE true
+
 //======================================================
 // 型定義
 //======================================================
@@ -28,6 +33,8 @@
 //======================================================
 // 変数・定数
 //======================================================
+static TETRIS_CORE_ai_player_t autoplay_player;           // 自動操作プレイヤー状態
+static tetris_autoplay_search_time_t autoplay_search_time; // 自動操作の配置探索時間（CPU負荷ベンチマーク用）
 
 //======================================================
 // プロトタイプ宣言
@@ -41,12 +48,24 @@
  * @param input_handler 入力ハンドラ
  * @param input_state_ptr 入力状態格納先
  * @return なし
- * @details ゲーム開始受付に使用するコントロールボタン1、コントロールボタン2の2つのみ入力取得
+ * @details ゲーム開始受付に使用するコントロールボタン1、コントロールボタン2と、ゲームモード選択用の左右入力のみ取得
  */
 void tetris_receive_game_start_input(TETRIS_input_parameter_t *input_handler, tetris_input_state_t *input_state_ptr)
 {
+    static bool was_input_R = false; // 前周期の右入力
+    static bool was_input_L = false; // 前周期の左入力
+
     input_state_ptr->is_input_control_button2 = BUTTON_check_pushed_once(&input_handler->control_button2);
     input_state_ptr->is_input_control_button1 = BUTTON_check_pushed_once(&input_handler->control_button1);
+
+    // ゲームモード選択用の左右入力：倒した直後の1周期でのみHigh（倒したままでは選択を送らない）
+    tetris_input_ctrl_direction(input_handler, input_state_ptr);
+    bool is_input_R = input_state_ptr->is_input_R;
+    bool is_input_L = input_state_ptr->is_input_L;
+    input_state_ptr->is_input_R = is_input_R && !was_input_R;
+    input_state_ptr->is_input_L = is_input_L && !was_input_L;
+    was_input_R = is_input_R;
+    was_input_L = is_input_L;
 }
 
 /**
@@ -54,9 +73,29 @@ void tetris_receive_game_start_input(TETRIS_input_parameter_t *input_handler, te
  * @param input_handler 入力ハンドラ
  * @param input_state_ptr 入力状態格納先
  * @return なし
- * @details ゲームプレイに利用するアナログスティックの上下左右入力と右回転ボタン,左回転ボタンの入力を取得する
+ * @details ゲームプレイに利用するアナログスティックの上下左右入力と右回転ボタン,左回転ボタン,ホールド（コントロールボタン2）,
+ *          アンドゥ・中断（コントロールボタン1、練習モードではアンドゥ、それ以外のモードでは中断）の入力を取得する
  */
 void tetris_input_ctrl_in_game(TETRIS_input_parameter_t *input_handler, tetris_input_state_t *input_state_ptr)
+{
+    tetris_input_ctrl_direction(input_handler, input_state_ptr);
+
+    // ボタン入力更新：押した直後の1周期でのみHigh
+    input_state_ptr->is_input_turnR_button = BUTTON_check_pushed_once(&input_handler->turnR_button);
+    input_state_ptr->is_input_turnL_button = BUTTON_check_pushed_once(&input_handler->turnL_button);
+    input_state_ptr->is_input_control_button2 = BUTTON_check_pushed_once(&input_handler->control_button2);
+    input_state_ptr->is_input_control_button1 = BUTTON_check_pushed_once(&input_handler->control_button1);
+}
+
+/**
+ * @brief ゲーム実行中 方向入力更新
+ * @param input_handler 入力ハンドラ
+ * @param input_state_ptr 入力状態格納先
+ * @return なし
+ * @details アナログスティックの上下左右入力のみを取得する
+ *          オートシフトの押下時間を1ms単位で測るため、10ms周期の入力処理とは別に1ms周期でも呼ばれる
+ */
+void tetris_input_ctrl_direction(TETRIS_input_parameter_t *input_handler, tetris_input_state_t *input_state_ptr)
 {
     // スティックAD入力更新
     ANALOGSTICK_update_coordinate_value(&input_handler->analog_stick);
@@ -66,10 +105,48 @@ void tetris_input_ctrl_in_game(TETRIS_input_parameter_t *input_handler, tetris_i
     input_state_ptr->is_input_L = (input_handler->analog_stick.x_coordinate_value < AD_INPUT_L_TH) ? true : false;
     input_state_ptr->is_input_U = (input_handler->analog_stick.y_coordinate_value < AD_INPUT_U_TH) ? true : false;
     input_state_ptr->is_input_D = (AD_INPUT_D_TH < input_handler->analog_stick.y_coordinate_value) ? true : false;
+}
 
-    // ボタン入力更新：押した直後の1周期でのみHigh
-    input_state_ptr->is_input_turnR_button = BUTTON_check_pushed_once(&input_handler->turnR_button);
-    input_state_ptr->is_input_turnL_button = BUTTON_check_pushed_once(&input_handler->turnL_button);
+/**
+ * @brief ゲーム実行中入力状態更新（自動操作）
+ * @param compute_state_ptr 演算状態
+ * @param input_state_ptr 入力状態格納先
+ * @return なし
+ * @details 物理入力の代わりに、ゲームコアの自動操作が生成した入力を入力ステートに格納する
+ *          配置探索はミノ毎に1回だけ実行されるので、その処理時間を計測して最新値・最大値を保持する
+ */
+void tetris_input_ctrl_autoplay(const tetris_compute_state_t *compute_state_ptr, tetris_input_state_t *input_state_ptr)
+{
+    TETRIS_CORE_input_t core_input;
+
+    uint64_t start_time_us = TIMER_get_time_us();
+    bool is_searched = TETRIS_CORE_ai_decide_input(&autoplay_player, &compute_state_ptr->core_state, &TETRIS_CORE_ai_weight_default, &core_input);
+    uint32_t elapsed_time_us = (uint32_t)(TIMER_get_time_us() - start_time_us);
+
+    if (is_searched)
+    {
+        autoplay_search_time.latest_us = elapsed_time_us;
+        autoplay_search_time.max_us = (autoplay_search_time.max_us < elapsed_time_us) ? elapsed_time_us : autoplay_search_time.max_us;
+    }
+
+    input_state_ptr->is_input_R = core_input.is_input_R;
+    input_state_ptr->is_input_L = core_input.is_input_L;
+    input_state_ptr->is_input_U = core_input.is_input_U;
+    input_state_ptr->is_input_D = core_input.is_input_D;
+    input_state_ptr->is_input_turnR_button = core_input.is_input_turnR;
+    input_state_ptr->is_input_turnL_button = core_input.is_input_turnL;
+    input_state_ptr->is_input_control_button2 = core_input.is_input_hold;
+    input_state_ptr->is_input_control_button1 = false; // 自動操作はアンドゥしない
+}
+
+/**
+ * @brief 自動操作 配置探索時間取得
+ * @return 配置探索時間（最新値・最大値）
+ * @details デバッグ用通信ツールへの送信用
+ */
+tetris_autoplay_search_time_t tetris_get_autoplay_search_time()
+{
+    return autoplay_search_time;
 }
 
 /**
@@ -103,6 +180,9 @@ void tetris_initialize_input_ctrl(tetris_input_state_t *input_state_ptr)
     input_state_ptr->is_input_turnL_button = false;
     input_state_ptr->is_input_control_button2 = false;
     input_state_ptr->is_input_control_button1 = false;
+
+    // 自動操作状態初期化（配置探索時間の記録はゲームをまたいで保持する）
+    TETRIS_CORE_ai_initialize_player(&autoplay_player, AUTOPLAY_LOOKAHEAD_ENABLE);
 }
 
 //======================================================
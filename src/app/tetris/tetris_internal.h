@@ -12,10 +12,25 @@
 #include "debug_com.h"
 #include "typedef.h"
 #include "bitmap_lib.h"
+#include "tetris_core.h"
+#include "flash.h"
 
 //======================================================
 // マクロ定義
 //======================================================
+// ゲームモード数（開始画面で選択できるモードの数）
+#define TETRIS_GAME_MODE_NUMBER 6
+
+// ゲーム実行中画面の描画レイヤ数
+#define TETRIS_DISPLAY_LAYER_NUMBER 6
+
+// ハイスコア
+#define TETRIS_HIGH_SCORE_MODE_NUMBER 3  // ハイスコアを記録するゲームモード数（マラソン・スプリント・ウルトラ）
+#define TETRIS_HIGH_SCORE_TABLE_LENGTH 5 // ゲームモード毎のハイスコア保持数
+
+// フラッシュ配置（プログラム領域と重ならないよう末尾のセクタを使う）
+#define TETRIS_FLASH_SCORE_LOG_SECTORS 4                                                                  // ハイスコアログのセクタ数
+#define TETRIS_FLASH_SCORE_LOG_OFFSET (FLASH_TOTAL_SIZE - TETRIS_FLASH_SCORE_LOG_SECTORS * FLASH_SECTOR_SIZE) // ハイスコアログの先頭オフセット
 
 //======================================================
 // 型定義
@@ -32,6 +47,34 @@ typedef enum
     game_pause,                /**< ポーズ中 */
 } tetris_game_state_t;
 
+/**
+ * @brief ゲームモード定義
+ * @details 開始画面ではこの順に選択肢を並べる
+ */
+typedef enum
+{
+    game_mode_marathon = 0, /**< 1人プレイ（ゲームオーバーまで続ける） */
+    game_mode_sprint,       /**< スプリント（40行消去までのタイムを計る） */
+    game_mode_ultra,        /**< ウルトラ（制限時間内のスコアを競う） */
+    game_mode_practice,     /**< 練習（1人プレイに加え、直前に置いたミノをアンドゥで置き直せる） */
+    game_mode_versus,       /**< CPU対戦（行消去で相手にせり上がりを送り、先にゲームオーバーになった方の負け） */
+    game_mode_pentomino,    /**< ペントミノ（1人プレイを5ブロックのミノで行う） */
+} tetris_game_mode_t;
+
+/**
+ * @brief 描画レイヤ定義
+ * @details ゲーム実行中の画面を構成するレイヤ。最終画面は全レイヤのORで、変化したレイヤの変化した範囲のみ合成し直す
+ */
+typedef enum
+{
+    display_layer_fixed_UI = 0, /**< 固定UI（定数ビットマップ） */
+    display_layer_field,        /**< 固定済みブロック */
+    display_layer_ghost,        /**< 落下地点 */
+    display_layer_active_mino,  /**< 操作ミノ */
+    display_layer_information,  /**< 情報パネル（ネクスト・ホールド・レベル・消去行・スコア） */
+    display_layer_overlay,      /**< オーバーレイ（ゲームタイマ） */
+} tetris_display_layer_t;
+
 /**
  * @brief 入力ステート定義
  */
@@ -48,77 +91,141 @@ typedef struct
 } tetris_input_state_t;
 
 /**
- * @brief ミノ種別定義
+ * @brief ミノ固定処理時間定義
+ * @details ミノを固定したステップ（固定・行消去・スコア更新を含む）のゲームコア処理時間
  */
-typedef enum
+typedef struct
 {
-    mino_I = 0, /**< I字型ミノ */
-    mino_J,     /**< J字型ミノ */
-    mino_L,     /**< L字型ミノ */
-    mino_O,     /**< O字型ミノ */
-    mino_S,     /**< S字型ミノ */
-    mino_T,     /**< T字型ミノ */
-    mino_Z,     /**< Z字型ミノ */
-} tetris_mino_type_t;
+    uint32_t lock_count; /**< 計測したミノ固定回数 */
+    uint32_t latest_us;  /**< 最新のミノ固定ステップ処理時間[us] */
+    uint32_t max_us;     /**< ミノ固定ステップ処理時間の最大値[us] */
+} tetris_lock_process_time_t;
 
 /**
- * @brief ミノ回転状態定義
+ * @brief 演算ステート定義
+ * @details ゲームルールの演算状態は全てゲームコア側で保持する
  */
-typedef enum
+typedef struct
 {
-    r_no_turn = 0, /**< 回転無し（基準状態） */
-    r_1_turn,      /**< 右に1回転の状態 */
-    r_2_turn,      /**< 右に2回転の状態 */
-    r_3_turn,      /**< 右に3回転の状態 */
-} tetris_mino_turn_state_t;
+    TETRIS_CORE_state_t core_state;               /**< ゲームコア演算状態（ミノ・フィールド・ゲーム制御パラメータ） */
+    uint64_t auto_shift_time_us;                  /**< 前回オートシフト処理（ゲーム経過時間更新）時刻[us] */
+    bool is_display_changed;                      /**< 今回の演算で表示対象が変化した（falseなら描画・送信を省略する） */
+    tetris_lock_process_time_t lock_process_time; /**< ミノ固定ステップの処理時間（盤面毎に計測する） */
+} tetris_compute_state_t;
 
 /**
- * @brief ミノ演算パラメータ定義
+ * @brief CPU対戦相手ステート定義
+ * @details 対戦相手の盤面は演算ステートをもう1つ持って動かす（ゲームコアはファイル内グローバルな状態を持たないため）
  */
 typedef struct
 {
-    bitmap_128_t bitmap;                 /**< ミノの演算用ビットマップ */
-    uint8_t reference_x;                 /**< ミノの基準点（X軸） */
-    uint8_t reference_y;                 /**< ミノの基準点（Y軸） */
-    uint8_t distance_to_landing;         /**< ミノの現在地点から着地点までの距離 */
-    tetris_mino_turn_state_t turn_state; /**< ミノの回転状態 */
-    tetris_mino_type_t mino_type;        /**< ミノの種別 */
-    tetris_mino_type_t next_mino_type;   /**< ネクストミノの種別 */
-    bool is_next_mino_generate;          /**< 次回ループでのミノ新規生成フラグ */
-} tetris_mino_parameter_t;
+    tetris_compute_state_t compute_state; /**< 対戦相手の演算ステート */
+    TETRIS_CORE_ai_player_t cpu_player;   /**< 対戦相手の自動操作プレイヤー状態 */
+    uint64_t reaction_end_time_us;        /**< 操作を始めるゲーム経過時間[us]（ミノ出現から一定時間は操作しない。CPUの強さ調整） */
+} tetris_opponent_state_t;
 
 /**
- * @brief フィールド演算ビットマップ定義
- * @details フィールドは接地済みミノとボックス枠で構成され、詳細は以下
- *          0～1行：バッファ、
- *          2～3行：操作ミノ生成、
- *          4～23行：ブロック描画範囲
+ * @brief フレーム処理時間定義
+ * @details ゲーム実行中の10msタスク1回分（入力・演算・描画）の処理時間。対戦モードでの盤面数に対する負荷の伸びを見る
  */
 typedef struct
 {
-    bitmap_128_t bitmap; /**< フィールド演算用ビットマップ */
-} tetris_field_parameter_t;
+    uint32_t latest_us; /**< 最新のフレーム処理時間[us] */
+    uint32_t max_us;    /**< フレーム処理時間の最大値[us] */
+} tetris_frame_process_time_t;
 
 /**
- * @brief ゲーム制御パラメータ定義
+ * @brief フレーム送信バイト数定義
+ * @details ゲーム実行中の10msタスク1回分でディスプレイICに送信したバイト数（I2Cのスレーブアドレスを含む）。描画差分の通信量を見る
  */
 typedef struct
 {
-    uint8_t level;        /**< UI表示用ゲームレベル */
-    uint16_t row_deleted; /**< UI表示用合計消去行数 */
-    uint16_t score;       /**< UI表示用ゲームスコア */
-    bool is_updated;      /**< ゲーム制御パラメータ更新有無 */
-} tetris_game_parameter_t;
+    uint32_t latest_bytes; /**< 最新のフレームの送信バイト数 */
+    uint32_t max_bytes;    /**< フレーム送信バイト数の最大値 */
+} tetris_frame_sent_bytes_t;
 
 /**
- * @brief 演算ステート定義
+ * @brief ゲームタイマ定義
+ * @details スプリント・ウルトラで使う。経過時間はポーズしていた時間を除いて計る
  */
 typedef struct
 {
-    tetris_mino_parameter_t mino_parameter;   /**< ミノ演算パラメータ */
-    tetris_field_parameter_t field_parameter; /**< フィールド演算パラメータ */
-    tetris_game_parameter_t game_parameter;   /**< ゲーム制御パラメータ */
-} tetris_compute_state_t;
+    tetris_game_mode_t game_mode;  /**< 計測中のゲームモード（スプリント：経過時間を表示、ウルトラ：残り時間を表示） */
+    uint64_t start_time_us;        /**< 計測開始時刻[us] */
+    uint64_t pause_start_time_us;  /**< ポーズ開始時刻[us] */
+    uint64_t paused_time_us;       /**< ポーズしていた時間の累計[us] */
+    bool is_paused;                /**< ポーズ中フラグ */
+    bool is_finished;              /**< 終了条件成立（スプリント：目標行数を消去、ウルトラ：制限時間が経過） */
+    uint32_t display_centiseconds; /**< 表示する時間[10ms] */
+} tetris_game_timer_t;
+
+/**
+ * @brief スナップショット保存時間定義
+ */
+typedef struct
+{
+    uint32_t latest_us; /**< 最新のスナップショット保存時間[us] */
+    uint32_t max_us;    /**< スナップショット保存時間の最大値[us] */
+} tetris_snapshot_time_t;
+
+/**
+ * @brief 練習モードステート定義
+ * @details ミノ出現直前の演算状態をリングに保存しておき、アンドゥ入力でそこまで巻き戻す
+ */
+typedef struct
+{
+    TETRIS_CORE_snapshot_ring_t snapshot_ring; /**< ミノ出現直前の演算状態スナップショット */
+    tetris_snapshot_time_t save_time;          /**< スナップショット保存時間（ゲームを跨いで計測する） */
+} tetris_practice_state_t;
+
+/**
+ * @brief ハイスコア定義
+ */
+typedef struct
+{
+    uint32_t value;     /**< 記録値（スプリント：タイム[10ms]、マラソン・ウルトラ：スコア） */
+    uint32_t record_id; /**< 記録ID（ハイスコアに入った順の通し番号、0は空き） */
+} tetris_high_score_t;
+
+/**
+ * @brief フラッシュ処理時間定義
+ */
+typedef struct
+{
+    uint32_t latest_us; /**< 最新の処理時間[us] */
+    uint32_t max_us;    /**< 処理時間の最大値[us] */
+} tetris_flash_step_time_t;
+
+/**
+ * @brief ハイスコアログ処理時間定義
+ * @details フラッシュ操作は1回の処理で1ページ書き込みか1セクタ消去のどちらか1つだけ行うので、その種類毎に計る
+ */
+typedef struct
+{
+    tetris_flash_step_time_t program_time; /**< ページ書き込み1回の処理時間 */
+    tetris_flash_step_time_t erase_time;   /**< セクタ消去1回の処理時間 */
+} tetris_score_log_time_t;
+
+/**
+ * @brief 起動時間定義
+ * @details 時刻はいずれもリセットからの経過時間（TIMER_get_time_us()はリセット時に0から数える）
+ */
+typedef struct
+{
+    uint32_t main_entry_us;     /**< アプリ開始（ドライバ・ミドル層初期化完了）時刻[us] */
+    uint32_t score_log_load_us; /**< ハイスコアログの読み込み時間[us] */
+    uint32_t resume_us;         /**< 中断データの確認・ゲーム再開時間[us]（中断データが無ければ確認のみ） */
+    uint32_t first_frame_us;    /**< 最初のフレーム（開始画面または再開したゲーム）の処理完了時刻[us] */
+} tetris_boot_time_t;
+
+/**
+ * @brief 自動操作 配置探索時間定義
+ */
+typedef struct
+{
+    uint32_t latest_us; /**< 最新の配置探索時間[us] */
+    uint32_t max_us;    /**< 配置探索時間の最大値[us] */
+} tetris_autoplay_search_time_t;
 
 // デバッグ実行関数ポインタ定義
 typedef void (*tetris_cmd_fn_ptr_t)(const DEBUG_COM_debug_frame_t *);
@@ -143,12 +250,8 @@ extern const bitmap_128_t tetris_bitmap_def_restart_message;
 extern const bitmap_128_t tetris_bitmap_def_restart_message_bold;
 extern const bitmap_128_t tetris_bitmap_def_falling_point_layer;
 extern const bitmap_128_t tetris_bitmap_def_field_layer;
-extern const bitmap_128_t tetris_bitmap_def_mino;
 extern const bitmap_128_t tetris_bitmap_def_next_mino_1;
 extern const bitmap_128_t tetris_bitmap_def_next_mino_2;
-extern const bitmap_128_t tetris_bitmap_def_box;
-extern const bitmap_128_t tetris_bitmap_def_check_box_full_layer;
-extern const bitmap_128_t tetris_bitmap_def_zero;
 
 /* debug_cmd_def */
 extern const cmd_list_t tetris_cmd_list[];
@@ -160,19 +263,61 @@ extern const cmd_list_t tetris_cmd_list[];
 extern void tetris_initialize_input_ctrl(tetris_input_state_t *input_state_ptr);
 extern void tetris_receive_game_start_input(TETRIS_input_parameter_t *input_handler, tetris_input_state_t *input_state_ptr);
 extern void tetris_input_ctrl_in_game(TETRIS_input_parameter_t *input_handler, tetris_input_state_t *input_state_ptr);
+extern void tetris_input_ctrl_direction(TETRIS_input_parameter_t *input_handler, tetris_input_state_t *input_state_ptr);
+extern void tetris_input_ctrl_autoplay(const tetris_compute_state_t *compute_state_ptr, tetris_input_state_t *input_state_ptr);
 extern void tetris_receive_game_restart_input(TETRIS_input_parameter_t *input_handler, tetris_input_state_t *input_state_ptr);
 
 /* main → data_compute */
-extern void tetris_initialize_data_compute(tetris_compute_state_t *mino_compute_data);
+extern void tetris_initialize_data_compute(tetris_compute_state_t *mino_compute_data, tetris_game_mode_t game_mode);
 extern tetris_game_state_t tetris_judge_game_start(tetris_input_state_t *input_state_ptr);
+extern tetris_game_mode_t tetris_judge_game_mode(tetris_input_state_t *input_state_ptr, tetris_game_mode_t selected_mode);
 extern tetris_game_state_t tetris_data_compute_in_game(tetris_input_state_t *input_state_ptr, tetris_compute_state_t *mino_compute_data);
+extern void tetris_data_compute_auto_shift(tetris_input_state_t *input_state_ptr, tetris_compute_state_t *mino_compute_data);
 extern tetris_game_state_t tetris_judge_game_restart(tetris_input_state_t *input_state_ptr);
+extern bool tetris_judge_game_suspend(tetris_input_state_t *input_state_ptr, tetris_game_mode_t game_mode);
+
+/* versus → data_compute */
+extern TETRIS_CORE_step_result_t tetris_data_compute_step(tetris_compute_state_t *compute_state_ptr, const TETRIS_CORE_input_t *core_input_ptr);
+extern void tetris_advance_game_time(tetris_compute_state_t *compute_state_ptr, const TETRIS_CORE_input_t *core_input_ptr);
+
+/* main → versus */
+extern void tetris_initialize_versus(tetris_opponent_state_t *opponent_state_ptr);
+extern tetris_game_state_t tetris_data_compute_versus(tetris_compute_state_t *compute_state_ptr, tetris_opponent_state_t *opponent_state_ptr, tetris_game_state_t player_state_next);
+
+/* main → practice */
+extern void tetris_initialize_practice(tetris_practice_state_t *practice_state_ptr);
+extern void tetris_data_compute_practice(tetris_input_state_t *input_state_ptr, tetris_compute_state_t *compute_state_ptr, tetris_practice_state_t *practice_state_ptr);
+
+/* main → game_timer */
+extern void tetris_initialize_game_timer(tetris_game_timer_t *timer_ptr, tetris_game_mode_t game_mode);
+extern tetris_game_state_t tetris_data_compute_game_timer(const tetris_compute_state_t *compute_state_ptr, tetris_game_timer_t *timer_ptr, tetris_game_state_t state_next);
+extern void tetris_pause_game_timer(tetris_game_timer_t *timer_ptr, bool is_pause);
+
+/* suspend → game_timer */
+extern uint32_t tetris_get_game_timer_elapsed_us(const tetris_game_timer_t *timer_ptr);
+extern void tetris_restore_game_timer(tetris_game_timer_t *timer_ptr, tetris_game_mode_t game_mode, uint32_t elapsed_us);
+
+/* main → score_log */
+extern void tetris_initialize_score_log();
+extern void tetris_record_high_score(tetris_game_mode_t game_mode, const tetris_compute_state_t *compute_state_ptr, const tetris_game_timer_t *timer_ptr);
+extern void tetris_process_score_log();
+
+/* main → suspend */
+extern void tetris_suspend_game(tetris_game_mode_t game_mode, const tetris_compute_state_t *compute_state_ptr, const tetris_opponent_state_t *opponent_state_ptr, const tetris_game_timer_t *timer_ptr);
+extern bool tetris_resume_game(tetris_game_mode_t *game_mode_ptr, tetris_compute_state_t *compute_state_ptr, tetris_opponent_state_t *opponent_state_ptr, tetris_game_timer_t *timer_ptr);
+extern void tetris_discard_suspended_game();
 
 /* main → display_ctrl */
 extern void tetris_initialize_display_ctrl();
-extern void tetris_display_waiting_start();
-extern void tetris_display_ctrl_in_game(tetris_compute_state_t *mino_compute_data);
-extern void tetris_display_waiting_restart();
+extern void tetris_display_waiting_start(tetris_game_mode_t selected_mode);
+extern void tetris_display_ctrl_in_game(tetris_compute_state_t *mino_compute_data, const tetris_game_timer_t *timer_ptr);
+extern void tetris_display_ctrl_versus(tetris_compute_state_t *compute_state_ptr, tetris_compute_state_t *opponent_compute_state_ptr);
+extern void tetris_display_waiting_restart(const tetris_compute_state_t *compute_state_ptr, tetris_game_mode_t game_mode);
+
+/* display_ctrl → display_layer */
+extern void tetris_invalidate_display_layer(tetris_display_layer_t layer, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+extern void tetris_invalidate_all_display_layers();
+extern void tetris_compose_display_layers(bitmap_128_t frame_bitmap, const uint64_t (*const layer_bitmaps[])[2]);
 
 /* main → debug_ctrl */
 extern void tetris_execute_debug_process(void);
@@ -182,6 +327,21 @@ extern uint8_t tetris_get_sizeof_cmd();
 
 /* debug_cmd_def → main */
 extern void tetris_debug_pause_enale(bool is_enable);
+extern void tetris_debug_autoplay_enable(bool is_enable);
 extern tetris_game_state_t tetris_get_game_state();
+extern TETRIS_CORE_lock_statistics_t tetris_get_lock_statistics();
+extern tetris_lock_process_time_t tetris_get_lock_process_time();
+extern tetris_frame_process_time_t tetris_get_frame_process_time();
+extern tetris_frame_sent_bytes_t tetris_get_frame_sent_bytes();
+extern tetris_snapshot_time_t tetris_get_snapshot_time();
+extern TETRIS_CORE_play_statistics_t tetris_get_play_statistics();
+extern tetris_boot_time_t tetris_get_boot_time();
+
+/* debug_cmd_def → score_log */
+extern const tetris_high_score_t *tetris_get_high_score_table(tetris_game_mode_t game_mode);
+extern tetris_score_log_time_t tetris_get_score_log_time();
+
+/* debug_cmd_def → input_ctrl */
+extern tetris_autoplay_search_time_t tetris_get_autoplay_search_time();
 
 #endif /* __TETRIS_INTERNAL_H__ */
\ No newline at end of file
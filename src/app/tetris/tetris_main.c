@@ -37,9 +37,17 @@ typedef struct
 static scheduler_flag_t scheduler_flag = {false}; // 周期管理用フラグ（割り込みからコールバックされた関数が参照するのでここで定義必要）
 static tetris_input_state_t input_state;          // 入力ステート
 static tetris_compute_state_t compute_state;      // 演算ステート
+static tetris_opponent_state_t opponent_state;    // CPU対戦相手ステート（CPU対戦モードのみ使用）
+static tetris_practice_state_t practice_state;    // 練習モードステート（練習モードのみ使用）
+static tetris_game_timer_t game_timer;            // ゲームタイマ（スプリント・ウルトラのみ使用）
 // 描画ステートは入力層・演算層に渡さないので、描画層の内部ステートとして持つ
 
 static tetris_game_state_t game_state_current = game_waiting_start; // ゲームステート（debug関数からのRWがあるのでファイル内グローバル）
+static bool is_autoplay_enabled = false;                            // 自動操作有効フラグ（debug関数からのRWがあるのでファイル内グローバル）
+static tetris_game_mode_t game_mode = game_mode_marathon;           // ゲームモード（ゲーム開始待機中に選択）
+static tetris_frame_process_time_t frame_process_time;              // ゲーム実行中の10msタスク処理時間（debug関数からの読み出しがあるのでファイル内グローバル）
+static tetris_frame_sent_bytes_t frame_sent_bytes;                  // ゲーム実行中の10msタスクのディスプレイ送信バイト数（debug関数からの読み出しがあるのでファイル内グローバル）
+static tetris_boot_time_t boot_time;                                // 起動時間（debug関数からの読み出しがあるのでファイル内グローバル）
 
 //======================================================
 // プロトタイプ宣言
@@ -47,6 +55,9 @@ static tetris_game_state_t game_state_current = game_waiting_start; // ゲーム
 static void task_scheduler();
 static bool check_task(bool *task_Nms_flag);
 static void update_game_state(tetris_game_state_t *state_current_ptr, tetris_game_state_t state_next);
+static void update_frame_process_time(uint32_t elapsed_time_us);
+static void update_frame_sent_bytes(uint32_t sent_bytes);
+static bool resume_suspended_game();
 
 //======================================================
 // 公開関数定義
@@ -56,11 +67,23 @@ static void update_game_state(tetris_game_state_t *state_current_ptr, tetris_gam
  * @param input_handler 入力ハンドラ
  * @return なし
  * @details 全てのステートは入力系処理 → 内部演算系処理 → 描画出力系処理 → ステート更新処理 の順で処理される
- *          現状は全ステート一律で10ms周期での実行
+ *          現状は全ステート一律で10ms周期での実行（ゲーム実行中のオートシフトのみ1ms周期）
+ *          CPU対戦モードでは自分の盤面に続けて対戦相手の盤面を同じ10msタスク内で処理する
+ *          練習モードでは自分の盤面のステップ前にアンドゥ入力の処理とスナップショットの保存を行う
+ *          スプリント・ウルトラではステップ後にゲームタイマを更新し、終了条件を満たせばゲームオーバーへ遷移する
+ *          ハイスコアはゲームオーバーへの遷移時にRAM上の表へ記録し、フラッシュへはゲームオーバー画面で少しずつ書き込む
+ *          ゲーム実行中の中断入力でゲームをフラッシュに保存し、次回起動時はゲーム実行中から再開する
  */
 void TETRIS_main(TETRIS_input_parameter_t *input_handler)
 {
     /* アプリ初期化 */
+    boot_time.main_entry_us = (uint32_t)TIMER_get_time_us();
+    tetris_initialize_score_log(); // ハイスコアをフラッシュから復元
+    boot_time.score_log_load_us = (uint32_t)TIMER_get_time_us() - boot_time.main_entry_us;
+    if (resume_suspended_game()) // 中断したゲームがあれば開始画面を経由せずに再開
+        update_game_state(&game_state_current, game_running);
+    boot_time.resume_us = (uint32_t)TIMER_get_time_us() - boot_time.main_entry_us - boot_time.score_log_load_us;
+
     tetris_game_state_t game_state_next = game_state_current;                                 // ゲームステート更新用（次に遷移するステートを保持する）
     bool task_do = false;                                                                     // タスク実行フラグ初期化
     TIMER_set_alarm_callback_function((TIMER_callback_func_pointer_t)task_scheduler, alarm0); // 周期管理用タイマ割り込み設定
@@ -70,6 +93,17 @@ void TETRIS_main(TETRIS_input_parameter_t *input_handler)
     /* メインルーチン */
     while (true)
     {
+        if (check_task(&scheduler_flag.task_1ms)) // 1ms周期で実行
+        {
+            /* オートシフト（DAS/ARR・高速落下）はゲーム実行中のみ、ステップ周期より細かい粒度で処理 */
+            if (game_running == game_state_current)
+            {
+                if (!is_autoplay_enabled)
+                    tetris_input_ctrl_direction(input_handler, &input_state); // 自動操作中は10msタスクの入力を保持
+                tetris_data_compute_auto_shift(&input_state, &compute_state);
+            }
+        }
+
         if (check_task(&scheduler_flag.task_10ms)) // 10ms周期で実行
         {
             /* メインステート処理 */
@@ -78,32 +112,73 @@ void TETRIS_main(TETRIS_input_parameter_t *input_handler)
             /* ゲーム開始のボタン入力待ち */
             case game_waiting_start:
                 tetris_receive_game_start_input(input_handler, &input_state); // 入力系処理
+                input_state.is_input_control_button1 |= is_autoplay_enabled;  // 自動操作中はボタン入力無しで開始
                 game_state_next = tetris_judge_game_start(&input_state);      // 内部演算系処理
-                tetris_display_waiting_start();                               // 描画出力系処理
+                game_mode = tetris_judge_game_mode(&input_state, game_mode);  // 内部演算系処理
+                tetris_display_waiting_start(game_mode);                      // 描画出力系処理
                 update_game_state(&game_state_current, game_state_next);      // ステート更新処理
                 break;
 
             /* ゲーム実行用パラメータ初期化 */
             case game_start_initialization:
                 tetris_initialize_input_ctrl(&input_state);
-                tetris_initialize_data_compute(&compute_state);
+                tetris_initialize_data_compute(&compute_state, game_mode);
+                if (game_mode_versus == game_mode)
+                    tetris_initialize_versus(&opponent_state);
+                if (game_mode_practice == game_mode)
+                    tetris_initialize_practice(&practice_state);
+                if (game_mode_sprint == game_mode || game_mode_ultra == game_mode)
+                    tetris_initialize_game_timer(&game_timer, game_mode);
                 tetris_initialize_display_ctrl();
+                tetris_discard_suspended_game(); // 中断したゲームを残したまま新しいゲームを始めない
                 update_game_state(&game_state_current, game_running);
                 break;
 
             /* ゲーム実行中 */
             case game_running:
-                tetris_input_ctrl_in_game(input_handler, &input_state);
+            {
+                uint64_t frame_start_time_us = TIMER_get_time_us();
+                uint32_t frame_start_sent_bytes = SH1107_get_sent_byte_count();
+                bool is_timed_mode = (game_mode_sprint == game_mode || game_mode_ultra == game_mode);
+                if (is_autoplay_enabled)
+                    tetris_input_ctrl_autoplay(&compute_state, &input_state);
+                else
+                    tetris_input_ctrl_in_game(input_handler, &input_state);
+                if (tetris_judge_game_suspend(&input_state, game_mode))
+                {
+                    tetris_suspend_game(game_mode, &compute_state, &opponent_state, &game_timer); // フラッシュに保存して開始画面へ戻る
+                    update_game_state(&game_state_current, game_waiting_start);
+                    break;
+                }
+                if (game_mode_practice == game_mode)
+                    tetris_data_compute_practice(&input_state, &compute_state, &practice_state); // アンドゥ・スナップショット保存はステップ前に行う
                 game_state_next = tetris_data_compute_in_game(&input_state, &compute_state);
-                tetris_display_ctrl_in_game(&compute_state);
+                if (game_mode_versus == game_mode)
+                {
+                    game_state_next = tetris_data_compute_versus(&compute_state, &opponent_state, game_state_next);
+                    tetris_display_ctrl_versus(&compute_state, &opponent_state.compute_state);
+                }
+                else
+                {
+                    if (is_timed_mode)
+                        game_state_next = tetris_data_compute_game_timer(&compute_state, &game_timer, game_state_next);
+                    tetris_display_ctrl_in_game(&compute_state, (is_timed_mode) ? &game_timer : NULL);
+                }
+                update_frame_process_time((uint32_t)(TIMER_get_time_us() - frame_start_time_us));
+                update_frame_sent_bytes(SH1107_get_sent_byte_count() - frame_start_sent_bytes);
+                if (game_over == game_state_next)
+                    tetris_record_high_score(game_mode, &compute_state, &game_timer); // フラッシュへの書き込みはゲームオーバー画面で行う
                 update_game_state(&game_state_current, game_state_next);
                 break;
+            }
 
             /* ゲームオーバー画面＆リスタートのボタン入力待ち */
             case game_over:
                 tetris_receive_game_restart_input(input_handler, &input_state);
+                input_state.is_input_control_button1 |= is_autoplay_enabled; // 自動操作中はボタン入力無しでリスタート（連続耐久試験用）
                 game_state_next = tetris_judge_game_restart(&input_state);
-                tetris_display_waiting_restart();
+                tetris_display_waiting_restart(&compute_state, game_mode); // 初回のみプレイ統計を重ねる（CPU対戦以外）
+                tetris_process_score_log(); // 描画の後に1ステップ分だけフラッシュを操作する
                 update_game_state(&game_state_current, game_state_next);
                 break;
 
@@ -116,6 +191,9 @@ void TETRIS_main(TETRIS_input_parameter_t *input_handler)
                 break;
             }
 
+            if (!boot_time.first_frame_us)
+                boot_time.first_frame_us = (uint32_t)TIMER_get_time_us(); // 起動後最初のフレーム
+
             /* デバッグプロセスはステートに関わらず実行 */
             // tetris_execute_debug_process(); // 現状無効化
         }
@@ -137,15 +215,31 @@ void tetris_debug_pause_enale(bool is_enable)
     {
         state_previous = game_state_current;                // 直前のステートを保存
         update_game_state(&game_state_current, game_pause); // ポーズ有効化
+        tetris_pause_game_timer(&game_timer, true);         // ポーズ中はゲームタイマを止める
         is_pause_enabled = true;
     }
     else if (is_pause_enabled && !is_enable) // ポーズ中に解除指定
     {
         update_game_state(&game_state_current, state_previous); // ステート復元
+        tetris_pause_game_timer(&game_timer, false);            // ゲームタイマ再開
+        compute_state.auto_shift_time_us = TIMER_get_time_us(); // ポーズ中の時間でゲーム経過時間を進めない
+        opponent_state.compute_state.auto_shift_time_us = TIMER_get_time_us();
         is_pause_enabled = false;
     }
 }
 
+/**
+ * @brief デバッグ用自動操作切替
+ * @param is_enable 自動操作有効フラグ
+ * @return なし
+ * @details デバッグ用通信ツールからコマンド受信した際にコールされる
+ *          有効中はスティック・ボタン入力の代わりにゲームコアの自動操作で入力し、ゲーム開始・リスタートも自動で行う
+ */
+void tetris_debug_autoplay_enable(bool is_enable)
+{
+    is_autoplay_enabled = is_enable;
+}
+
 /**
  * @brief デバッグ用ゲームステート取得
  * @return 現在のゲームステート
@@ -156,6 +250,76 @@ tetris_game_state_t tetris_get_game_state()
     return game_state_current;
 }
 
+/**
+ * @brief デバッグ用固定タイミング統計取得
+ * @return ゲームコアの固定タイミング統計（接地猶予の精度確認用）
+ * @details デバッグ用通信ツールへの送信用
+ */
+TETRIS_CORE_lock_statistics_t tetris_get_lock_statistics()
+{
+    return compute_state.core_state.lock_statistics;
+}
+
+/**
+ * @brief デバッグ用ミノ固定処理時間取得
+ * @return 自分の盤面のミノ固定ステップの処理時間（計測回数・最新値・最大値）
+ * @details デバッグ用通信ツールへの送信用
+ */
+tetris_lock_process_time_t tetris_get_lock_process_time()
+{
+    return compute_state.lock_process_time;
+}
+
+/**
+ * @brief デバッグ用フレーム処理時間取得
+ * @return ゲーム実行中の10msタスク処理時間（最新値・最大値）
+ * @details デバッグ用通信ツールへの送信用
+ */
+tetris_frame_process_time_t tetris_get_frame_process_time()
+{
+    return frame_process_time;
+}
+
+/**
+ * @brief デバッグ用フレーム送信バイト数取得
+ * @return ゲーム実行中の10msタスクのディスプレイ送信バイト数（最新値・最大値）
+ * @details デバッグ用通信ツールへの送信用
+ */
+tetris_frame_sent_bytes_t tetris_get_frame_sent_bytes()
+{
+    return frame_sent_bytes;
+}
+
+/**
+ * @brief デバッグ用スナップショット保存時間取得
+ * @return 練習モードのスナップショット保存時間（最新値・最大値）
+ * @details デバッグ用通信ツールへの送信用
+ */
+tetris_snapshot_time_t tetris_get_snapshot_time()
+{
+    return practice_state.save_time;
+}
+
+/**
+ * @brief デバッグ用プレイ統計取得
+ * @return 自分の盤面のプレイ統計（ゲーム中は現在までの値、ゲームオーバー後は最後のゲームの値）
+ * @details デバッグ用通信ツールへの送信用
+ */
+TETRIS_CORE_play_statistics_t tetris_get_play_statistics()
+{
+    return compute_state.core_state.play_statistics;
+}
+
+/**
+ * @brief デバッグ用起動時間取得
+ * @return 起動時間（アプリ開始時刻・ハイスコアログ読み込み時間・ゲーム再開時間・最初のフレームの処理完了時刻）
+ * @details デバッグ用通信ツールへの送信用
+ */
+tetris_boot_time_t tetris_get_boot_time()
+{
+    return boot_time;
+}
+
 //======================================================
 // 内部関数定義
 //======================================================
@@ -220,4 +384,43 @@ static bool check_task(bool *task_Nms_flag)
 static void update_game_state(tetris_game_state_t *state_current_ptr, tetris_game_state_t state_next)
 {
     *state_current_ptr = state_next;
+}
+
+/**
+ * @brief フレーム処理時間更新
+ * @param elapsed_time_us 今回のフレーム処理時間[us]
+ * @return なし
+ */
+static void update_frame_process_time(uint32_t elapsed_time_us)
+{
+    frame_process_time.latest_us = elapsed_time_us;
+    frame_process_time.max_us = (frame_process_time.max_us < elapsed_time_us) ? elapsed_time_us : frame_process_time.max_us;
+}
+
+/**
+ * @brief フレーム送信バイト数更新
+ * @param sent_bytes 今回のフレームでディスプレイに送信したバイト数
+ * @return なし
+ */
+static void update_frame_sent_bytes(uint32_t sent_bytes)
+{
+    frame_sent_bytes.latest_bytes = sent_bytes;
+    frame_sent_bytes.max_bytes = (frame_sent_bytes.max_bytes < sent_bytes) ? sent_bytes : frame_sent_bytes.max_bytes;
+}
+
+/**
+ * @brief 中断したゲームの再開
+ * @return 再開した場合true
+ * @details 中断データがあれば演算状態・ゲームタイマを復元し、ゲーム開始時と同じ入力・描画の初期化を行う
+ */
+static bool resume_suspended_game()
+{
+    if (!tetris_resume_game(&game_mode, &compute_state, &opponent_state, &game_timer))
+        return false;
+
+    tetris_initialize_input_ctrl(&input_state);
+    if (game_mode_practice == game_mode)
+        tetris_initialize_practice(&practice_state);
+    tetris_initialize_display_ctrl();
+    return true;
 }
\ No newline at end of file
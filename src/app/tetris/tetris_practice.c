@@ -0,0 +1,99 @@
+/**
+ * @file   tetris_practice.c
+ * @brief  tetris・練習モード（アンドゥ）処理実装
+ * @details ミノ出現直前の演算状態をゲームコアのスナップショットリングに保存し、アンドゥ入力で直前に置いたミノの出現前まで巻き戻す
+ *          疑似乱数状態も演算状態に含まれるため、巻き戻した後は同じミノが同じ順で出現する
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris.h"
+#include "tetris_internal.h"
+#include "tetris_core.h"
+#include "typedef.h"
+#include "timer.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static void undo_last_mino(tetris_compute_state_t *compute_state_ptr, tetris_practice_state_t *practice_state_ptr);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief 練習モード初期化
+ * @param practice_state_ptr 練習モードステート格納先
+ * @return なし
+ * @details ゲーム開始時＆ゲームオーバー後のゲームリスタート時に、演算状態と合わせて呼ぶ
+ *          スナップショット保存時間はゲームを跨いで計測し続けるので初期化しない
+ */
+void tetris_initialize_practice(tetris_practice_state_t *practice_state_ptr)
+{
+    TETRIS_CORE_initialize_snapshot_ring(&practice_state_ptr->snapshot_ring);
+}
+
+/**
+ * @brief 練習モード 演算処理
+ * @param input_state_ptr 入力状態
+ * @param compute_state_ptr 演算状態
+ * @param practice_state_ptr 練習モードステート
+ * @return なし
+ * @details ゲームコアのステップより前に呼ぶ
+ *          アンドゥ入力（コントロールボタン1）があれば巻き戻し、無ければミノ出現直前のステップでスナップショットを保存する
+ *          保存は演算状態の構造体コピー1回なので、その処理時間を計測して最新値・最大値を保持する
+ */
+void tetris_data_compute_practice(tetris_input_state_t *input_state_ptr, tetris_compute_state_t *compute_state_ptr, tetris_practice_state_t *practice_state_ptr)
+{
+    tetris_snapshot_time_t *save_time_ptr = &practice_state_ptr->save_time;
+
+    if (input_state_ptr->is_input_control_button1)
+    {
+        undo_last_mino(compute_state_ptr, practice_state_ptr);
+    }
+    else if (compute_state_ptr->core_state.mino_parameter.is_next_mino_generate) // 今回のステップで次のミノが出現する
+    {
+        uint64_t start_time_us = TIMER_get_time_us();
+        TETRIS_CORE_save_snapshot(&practice_state_ptr->snapshot_ring, &compute_state_ptr->core_state, start_time_us);
+        uint32_t elapsed_time_us = (uint32_t)(TIMER_get_time_us() - start_time_us);
+
+        save_time_ptr->latest_us = elapsed_time_us;
+        save_time_ptr->max_us = (save_time_ptr->max_us < elapsed_time_us) ? elapsed_time_us : save_time_ptr->max_us;
+    }
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief 直前のミノのアンドゥ
+ * @param compute_state_ptr 演算状態
+ * @param practice_state_ptr 練習モードステート
+ * @return なし
+ * @details 最新のスナップショットは操作中のミノの出現直前なので、その1つ前（直前に置いたミノの出現直前）まで巻き戻す
+ *          ミノ固定直後（次のミノの出現前）は最新のスナップショットが直前に置いたミノの出現直前になる
+ *          巻き戻す世代が残っていなければ何もしない
+ */
+static void undo_last_mino(tetris_compute_state_t *compute_state_ptr, tetris_practice_state_t *practice_state_ptr)
+{
+    uint8_t generations_back = (compute_state_ptr->core_state.mino_parameter.is_next_mino_generate) ? 0 : 1;
+
+    if (!TETRIS_CORE_restore_snapshot(&practice_state_ptr->snapshot_ring, generations_back, &compute_state_ptr->core_state))
+        return;
+
+    compute_state_ptr->auto_shift_time_us = TIMER_get_time_us(); // 巻き戻し前の経過時間でオートシフトを進めない
+    compute_state_ptr->is_display_changed = true;
+}
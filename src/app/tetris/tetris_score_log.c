@@ -0,0 +1,435 @@
+/**
+ * @file   tetris_score_log.c
+ * @brief  tetris・ハイスコアログ（フラッシュ保存）処理実装
+ * @details ハイスコアに入った記録をフラッシュ末尾のセクタに追記だけで残し、起動時に全記録を読み直してハイスコア表を復元する
+ *          追記先のセクタを順に回して消去回数を各セクタに分散させる（ウェアレベリング）。追記先の空きが少なくなれば、
+ *          次のセクタを消去してハイスコア表（有効な記録）だけを書き写し、以降はそのセクタに追記する（コンパクション）
+ *          フラッシュ操作中はプログラムを実行できず割り込みも止まるため、1回の処理では1ページ書き込みか1セクタ消去の
+ *          どちらか1つだけ行い、ゲームオーバー画面の10msタスクで少しずつ進める。ゲーム実行中はフラッシュに触れない
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris.h"
+#include "tetris_internal.h"
+#include "typedef.h"
+#include "timer.h"
+#include "flash.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define SCORE_RECORD_SIZE 16                                             // 1記録のサイズ[byte]
+#define SCORE_RECORDS_PER_SECTOR (FLASH_SECTOR_SIZE / SCORE_RECORD_SIZE) // 1セクタの記録枠数
+#define SCORE_RECORDS_PER_PAGE (FLASH_PAGE_SIZE / SCORE_RECORD_SIZE)     // 1ページの記録枠数（ハイスコア表全体が1ページに収まること）
+#define SCORE_RECORD_MAGIC 0x5A                                          // 有効な記録の識別値（消去済みは0xFF）
+#define SCORE_LOG_PENDING_LENGTH 4                                       // 書き込み待ち記録数
+#define SCORE_LOG_COMPACTION_THRESHOLD SCORE_RECORDS_PER_PAGE            // 追記先の空き枠がこれ未満になればコンパクションする
+
+//======================================================
+// 型定義
+//======================================================
+/**
+ * @brief フラッシュ上の記録
+ * @details 記録枠は16byteで、ページ書き込みの範囲内で枠単位に追記する（書き換えない枠は0xFFで書き込み、消去済みのまま残す）
+ */
+typedef struct
+{
+    uint8_t magic;      /**< 識別値（SCORE_RECORD_MAGIC） */
+    uint8_t game_mode;  /**< ゲームモード */
+    uint16_t checksum;  /**< チェックサム（書き込み中の電源断で壊れた記録を読み飛ばすため） */
+    uint32_t sequence;  /**< 書き込み通し番号（最も大きい記録のあるセクタが追記先） */
+    uint32_t record_id; /**< 記録ID（コンパクションで書き写しても変えない。起動時の重複除去に使う） */
+    uint32_t value;     /**< 記録値 */
+} score_record_t;
+
+//======================================================
+// 変数・定数
+//======================================================
+// ハイスコア表（ゲームモード毎に良い順）
+static tetris_high_score_t high_score_table[TETRIS_HIGH_SCORE_MODE_NUMBER][TETRIS_HIGH_SCORE_TABLE_LENGTH];
+
+static score_record_t pending_record[SCORE_LOG_PENDING_LENGTH]; // 書き込み待ち記録
+static uint8_t pending_count;                                   // 書き込み待ち記録数
+static bool is_compaction_requested;                            // 書き込み待ちが溢れた（コンパクションでハイスコア表ごと書く）
+static uint8_t active_sector;                                   // 追記先セクタ番号
+static uint16_t write_slot;                                     // 追記先セクタの次の書き込み枠
+static uint32_t next_sequence;                                  // 次の書き込み通し番号
+static uint32_t next_record_id;                                 // 次の記録ID
+static uint8_t page_buffer[FLASH_PAGE_SIZE];                    // ページ書き込みデータ（RAM上にある必要がある）
+static tetris_score_log_time_t score_log_time;                  // フラッシュ処理時間
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static void load_sector(uint8_t sector, uint32_t *max_sequence_ptr);
+static void append_pending_records();
+static void compact_log();
+static bool insert_high_score(tetris_game_mode_t game_mode, uint32_t value, uint32_t record_id);
+static bool is_better_score(tetris_game_mode_t game_mode, uint32_t value, uint32_t record_id, const tetris_high_score_t *compared_ptr);
+static bool is_sector_erased(uint8_t sector);
+static bool is_slot_erased(const uint8_t *slot_ptr);
+static uint16_t calculate_checksum(const score_record_t *record_ptr);
+static const score_record_t *get_record(uint8_t sector, uint16_t slot);
+static uint32_t get_sector_offset(uint8_t sector);
+static void update_step_time(tetris_flash_step_time_t *step_time_ptr, uint32_t elapsed_time_us);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief ハイスコアログ初期化
+ * @return なし
+ * @details 起動時に1回呼び、全セクタの記録を読んでハイスコア表と追記位置を復元する
+ *          フラッシュはXIP経由で読むだけなので、全セクタ（1024枠）を走査しても消去・書き込みのような停止は無い
+ */
+void tetris_initialize_score_log()
+{
+    uint32_t max_sequence = 0;
+
+    active_sector = 0;
+    write_slot = 0;
+    next_sequence = 1;
+    next_record_id = 1;
+    pending_count = 0;
+    is_compaction_requested = false;
+
+    for (uint8_t sector = 0; sector < TETRIS_FLASH_SCORE_LOG_SECTORS; sector++)
+        load_sector(sector, &max_sequence);
+
+    // 追記位置：追記先セクタの最後の使用済み枠（壊れた記録を含む）の次
+    write_slot = SCORE_RECORDS_PER_SECTOR;
+    while (write_slot && is_slot_erased((const uint8_t *)get_record(active_sector, write_slot - 1)))
+        write_slot--;
+}
+
+/**
+ * @brief ハイスコア記録
+ * @param game_mode ゲームモード
+ * @param compute_state_ptr 演算状態
+ * @param timer_ptr ゲームタイマ（スプリント・ウルトラのみ参照）
+ * @return なし
+ * @details ゲームオーバーに遷移するステップで呼ぶ。ハイスコア表に入ればRAM上の表を更新して書き込み待ちに積む
+ *          フラッシュへの書き込みはゲームオーバー画面のtetris_process_score_log()で行う
+ *          スプリントは目標行数を消去した場合のみタイムを記録し、練習・CPU対戦・ペントミノは記録しない
+ */
+void tetris_record_high_score(tetris_game_mode_t game_mode, const tetris_compute_state_t *compute_state_ptr, const tetris_game_timer_t *timer_ptr)
+{
+    uint32_t value;
+
+    switch (game_mode)
+    {
+    case game_mode_marathon:
+    case game_mode_ultra:
+        value = compute_state_ptr->core_state.game_parameter.score;
+        break;
+    case game_mode_sprint:
+        if (!timer_ptr->is_finished)
+            return;
+        value = timer_ptr->display_centiseconds;
+        break;
+    default:
+        return;
+    }
+
+    uint32_t record_id = next_record_id;
+    if (!insert_high_score(game_mode, value, record_id))
+        return;
+    next_record_id++;
+
+    if (SCORE_LOG_PENDING_LENGTH <= pending_count)
+    {
+        is_compaction_requested = true; // 書き込み待ちはRAM上の表に全て入っているので、表ごと書けば失われない
+        return;
+    }
+
+    score_record_t *record_ptr = &pending_record[pending_count++];
+    record_ptr->game_mode = (uint8_t)game_mode;
+    record_ptr->record_id = record_id;
+    record_ptr->value = value;
+}
+
+/**
+ * @brief ハイスコアログ フラッシュ処理
+ * @return なし
+ * @details ゲームオーバー画面の10msタスクで呼ぶ。1回の呼び出しでは1ページ書き込み（1ms程度）か
+ *          1セクタ消去（数十ms）のどちらか1つだけ行い、処理時間を種類毎に計測する
+ *          コンパクションが必要なら書き込み待ちより優先する（ハイスコア表ごと書くので書き込み待ちも含まれる）
+ */
+void tetris_process_score_log()
+{
+    if (is_compaction_requested || (SCORE_RECORDS_PER_SECTOR - write_slot < SCORE_LOG_COMPACTION_THRESHOLD))
+        compact_log();
+    else if (pending_count)
+        append_pending_records();
+}
+
+/**
+ * @brief デバッグ用ハイスコア表取得
+ * @param game_mode ゲームモード
+ * @return ハイスコア表（TETRIS_HIGH_SCORE_TABLE_LENGTH件、良い順。記録しないモードはNULL）
+ * @details デバッグ用通信ツールへの送信用
+ */
+const tetris_high_score_t *tetris_get_high_score_table(tetris_game_mode_t game_mode)
+{
+    return (game_mode < TETRIS_HIGH_SCORE_MODE_NUMBER) ? high_score_table[game_mode] : NULL;
+}
+
+/**
+ * @brief デバッグ用ハイスコアログ処理時間取得
+ * @return ページ書き込み・セクタ消去1回の処理時間（最新値・最大値）
+ * @details デバッグ用通信ツールへの送信用
+ */
+tetris_score_log_time_t tetris_get_score_log_time()
+{
+    return score_log_time;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief セクタ読み込み
+ * @param sector セクタ番号
+ * @param max_sequence_ptr これまでに読んだ書き込み通し番号の最大値（更新する）
+ * @return なし
+ * @details 有効な記録をハイスコア表に入れ（同じ記録IDは1回だけ）、通し番号が最大の記録のあるセクタを追記先とする
+ */
+static void load_sector(uint8_t sector, uint32_t *max_sequence_ptr)
+{
+    for (uint16_t slot = 0; slot < SCORE_RECORDS_PER_SECTOR; slot++)
+    {
+        const score_record_t *record_ptr = get_record(sector, slot);
+        if (SCORE_RECORD_MAGIC != record_ptr->magic || calculate_checksum(record_ptr) != record_ptr->checksum)
+            continue; // 空き枠・壊れた記録
+        if (TETRIS_HIGH_SCORE_MODE_NUMBER <= record_ptr->game_mode)
+            continue;
+
+        insert_high_score((tetris_game_mode_t)record_ptr->game_mode, record_ptr->value, record_ptr->record_id);
+
+        if (*max_sequence_ptr < record_ptr->sequence)
+        {
+            *max_sequence_ptr = record_ptr->sequence;
+            active_sector = sector;
+            next_sequence = record_ptr->sequence + 1;
+        }
+        if (next_record_id <= record_ptr->record_id)
+            next_record_id = record_ptr->record_id + 1;
+    }
+}
+
+/**
+ * @brief 書き込み待ち記録の追記
+ * @return なし
+ * @details 書き込み枠を含むページ1つに、そのページに収まる分の書き込み待ちをまとめて書き込む
+ */
+static void append_pending_records()
+{
+    uint16_t page_first_slot = write_slot - write_slot % SCORE_RECORDS_PER_PAGE;
+    uint8_t write_count = 0;
+
+    for (uint16_t i = 0; i < FLASH_PAGE_SIZE; i++)
+        page_buffer[i] = 0xFF;
+
+    while (write_count < pending_count && (write_slot + write_count) < page_first_slot + SCORE_RECORDS_PER_PAGE)
+    {
+        score_record_t *record_ptr = (score_record_t *)&page_buffer[(write_slot + write_count - page_first_slot) * SCORE_RECORD_SIZE];
+        *record_ptr = pending_record[write_count];
+        record_ptr->magic = SCORE_RECORD_MAGIC;
+        record_ptr->sequence = next_sequence++;
+        record_ptr->checksum = calculate_checksum(record_ptr);
+        write_count++;
+    }
+
+    uint64_t start_time_us = TIMER_get_time_us();
+    FLASH_program_page(get_sector_offset(active_sector) + page_first_slot * SCORE_RECORD_SIZE, page_buffer);
+    update_step_time(&score_log_time.program_time, (uint32_t)(TIMER_get_time_us() - start_time_us));
+
+    write_slot += write_count;
+    pending_count -= write_count;
+    for (uint8_t i = 0; i < pending_count; i++)
+        pending_record[i] = pending_record[i + write_count];
+}
+
+/**
+ * @brief ログのコンパクション
+ * @return なし
+ * @details 1回目の呼び出しで次のセクタを消去し（消去済みなら省略）、次の呼び出しでハイスコア表の全記録を先頭ページに書き写す
+ *          書き写した時点で次のセクタが追記先（通し番号最大）になり、書き込み待ちも表に含まれるので破棄する
+ *          書き写す前に電源が切れても、元のセクタは消去していないので記録は失われない
+ */
+static void compact_log()
+{
+    uint8_t target_sector = (active_sector + 1) % TETRIS_FLASH_SCORE_LOG_SECTORS;
+
+    if (!is_sector_erased(target_sector))
+    {
+        uint64_t start_time_us = TIMER_get_time_us();
+        FLASH_erase_sector(get_sector_offset(target_sector));
+        update_step_time(&score_log_time.erase_time, (uint32_t)(TIMER_get_time_us() - start_time_us));
+        return;
+    }
+
+    uint8_t write_count = 0;
+    for (uint16_t i = 0; i < FLASH_PAGE_SIZE; i++)
+        page_buffer[i] = 0xFF;
+
+    for (uint8_t mode = 0; mode < TETRIS_HIGH_SCORE_MODE_NUMBER; mode++)
+    {
+        for (uint8_t rank = 0; rank < TETRIS_HIGH_SCORE_TABLE_LENGTH; rank++)
+        {
+            const tetris_high_score_t *high_score_ptr = &high_score_table[mode][rank];
+            if (!high_score_ptr->record_id)
+                break;
+
+            score_record_t *record_ptr = (score_record_t *)&page_buffer[write_count * SCORE_RECORD_SIZE];
+            record_ptr->magic = SCORE_RECORD_MAGIC;
+            record_ptr->game_mode = mode;
+            record_ptr->sequence = next_sequence++;
+            record_ptr->record_id = high_score_ptr->record_id;
+            record_ptr->value = high_score_ptr->value;
+            record_ptr->checksum = calculate_checksum(record_ptr);
+            write_count++;
+        }
+    }
+
+    uint64_t start_time_us = TIMER_get_time_us();
+    FLASH_program_page(get_sector_offset(target_sector), page_buffer);
+    update_step_time(&score_log_time.program_time, (uint32_t)(TIMER_get_time_us() - start_time_us));
+
+    active_sector = target_sector;
+    write_slot = write_count;
+    pending_count = 0;
+    is_compaction_requested = false;
+}
+
+/**
+ * @brief ハイスコア表への挿入
+ * @param game_mode ゲームモード
+ * @param value 記録値
+ * @param record_id 記録ID
+ * @return ハイスコア表に入った場合true（同じ記録IDが既に入っている場合・順位外の場合はfalse）
+ */
+static bool insert_high_score(tetris_game_mode_t game_mode, uint32_t value, uint32_t record_id)
+{
+    tetris_high_score_t *table = high_score_table[game_mode];
+    uint8_t rank = TETRIS_HIGH_SCORE_TABLE_LENGTH;
+
+    for (uint8_t i = 0; i < TETRIS_HIGH_SCORE_TABLE_LENGTH; i++)
+    {
+        if (record_id == table[i].record_id)
+            return false;
+        if (TETRIS_HIGH_SCORE_TABLE_LENGTH == rank && is_better_score(game_mode, value, record_id, &table[i]))
+            rank = i;
+    }
+    if (TETRIS_HIGH_SCORE_TABLE_LENGTH == rank)
+        return false;
+
+    for (uint8_t i = TETRIS_HIGH_SCORE_TABLE_LENGTH - 1; rank < i; i--)
+        table[i] = table[i - 1];
+    table[rank] = (tetris_high_score_t){.value = value, .record_id = record_id};
+
+    return true;
+}
+
+/**
+ * @brief ハイスコア比較
+ * @param game_mode ゲームモード
+ * @param value 記録値
+ * @param record_id 記録ID
+ * @param compared_ptr 比較対象のハイスコア
+ * @return 比較対象より上位の場合true
+ * @details スプリントはタイムが短い程、それ以外はスコアが高い程上位。同じ値なら先に記録した方（記録IDが小さい方）を上位とし、
+ *          起動時に記録をどの順で読んでも同じ表になるようにする。空き（記録ID 0）より常に上位
+ */
+static bool is_better_score(tetris_game_mode_t game_mode, uint32_t value, uint32_t record_id, const tetris_high_score_t *compared_ptr)
+{
+    if (!compared_ptr->record_id)
+        return true;
+    if (value == compared_ptr->value)
+        return record_id < compared_ptr->record_id;
+
+    return (game_mode_sprint == game_mode) ? (value < compared_ptr->value) : (compared_ptr->value < value);
+}
+
+/**
+ * @brief セクタ消去済み判定
+ * @param sector セクタ番号
+ * @return 全byteが0xFFの場合true
+ */
+static bool is_sector_erased(uint8_t sector)
+{
+    const uint32_t *word_ptr = (const uint32_t *)FLASH_get_read_address(get_sector_offset(sector));
+
+    for (uint16_t i = 0; i < FLASH_SECTOR_SIZE / sizeof(uint32_t); i++)
+    {
+        if (UINT32_MAX != word_ptr[i])
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 記録枠消去済み判定
+ * @param slot_ptr 記録枠の先頭
+ * @return 記録枠の全byteが0xFFの場合true
+ */
+static bool is_slot_erased(const uint8_t *slot_ptr)
+{
+    for (uint8_t i = 0; i < SCORE_RECORD_SIZE; i++)
+    {
+        if (0xFF != slot_ptr[i])
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief チェックサム計算
+ * @param record_ptr 記録
+ * @return チェックサム（チェックサム以外の全byteの和の反転）
+ */
+static uint16_t calculate_checksum(const score_record_t *record_ptr)
+{
+    uint16_t sum = record_ptr->magic + record_ptr->game_mode;
+    const uint8_t *byte_ptr = (const uint8_t *)&record_ptr->sequence;
+
+    for (uint8_t i = 0; i < SCORE_RECORD_SIZE - offsetof(score_record_t, sequence); i++)
+        sum += byte_ptr[i];
+
+    return (uint16_t)~sum;
+}
+
+/**
+ * @brief フラッシュ上の記録取得
+ * @param sector セクタ番号
+ * @param slot 記録枠番号
+ * @return 記録（XIP領域上のアドレス）
+ */
+static const score_record_t *get_record(uint8_t sector, uint16_t slot)
+{
+    return (const score_record_t *)FLASH_get_read_address(get_sector_offset(sector) + slot * SCORE_RECORD_SIZE);
+}
+
+/**
+ * @brief セクタのオフセット取得
+ * @param sector セクタ番号
+ * @return フラッシュ先頭からのオフセット
+ */
+static uint32_t get_sector_offset(uint8_t sector)
+{
+    return TETRIS_FLASH_SCORE_LOG_OFFSET + sector * FLASH_SECTOR_SIZE;
+}
+
+/**
+ * @brief フラッシュ処理時間更新
+ * @param step_time_ptr 更新する処理時間
+ * @param elapsed_time_us 今回の処理時間[us]
+ * @return なし
+ */
+static void update_step_time(tetris_flash_step_time_t *step_time_ptr, uint32_t elapsed_time_us)
+{
+    step_time_ptr->latest_us = elapsed_time_us;
+    step_time_ptr->max_us = (step_time_ptr->max_us < elapsed_time_us) ? elapsed_time_us : step_time_ptr->max_us;
+}
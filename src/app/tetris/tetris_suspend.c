@@ -0,0 +1,261 @@
+/**
+ * @file   tetris_suspend.c
+ * @brief  tetris・ゲーム中断・再開処理実装
+ * @details 実行中のゲームをフラッシュに保存して中断し、次回起動時に開始画面を経由せずゲーム実行中から再開する
+ *          保存するのはゲームコアのシリアライズ結果（盤面・ミノ・ネクスト・疑似乱数・スコア等）とゲームタイマの経過時間のみで、
+ *          描画用のビットマップは保存しない（再開後の初回描画で演算状態から描き直す）。1回の中断は1ページに収まる
+ *          中断データはハイスコアログの直前の1セクタに、中断毎に次のページへ書き込む（消去はセクタを使い切った時のみ）
+ *          再開したページ、および中断後に新しいゲームを開始した場合の最新ページは、識別値の隣の有効フラグに0を書き込んで無効化し、
+ *          同じデータから二重に再開したり、新しいゲームの後に古いゲームへ戻ったりしないようにする
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris.h"
+#include "tetris_internal.h"
+#include "tetris_core.h"
+#include "typedef.h"
+#include "timer.h"
+#include "flash.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define SUSPEND_FLASH_OFFSET (TETRIS_FLASH_SCORE_LOG_OFFSET - FLASH_SECTOR_SIZE) // 中断データのセクタ（ハイスコアログの直前）
+#define SUSPEND_PAGES_PER_SECTOR (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)           // 中断データを書けるページ数
+#define SUSPEND_MAGIC 0xC3                                                       // 中断データの識別値（消去済みは0xFF）
+#define SUSPEND_VALID 0xFF                                                       // 有効フラグ：未再開（消去済みの値のまま）
+#define SUSPEND_INVALID 0x00                                                     // 有効フラグ：再開済み
+
+//======================================================
+// 型定義
+//======================================================
+/**
+ * @brief 中断データ（フラッシュ1ページ分）
+ */
+typedef struct
+{
+    uint8_t magic;                                            /**< 識別値（SUSPEND_MAGIC） */
+    uint8_t is_valid;                                         /**< 有効フラグ（SUSPEND_VALID：未再開、SUSPEND_INVALID：再開済み） */
+    uint8_t game_mode;                                        /**< ゲームモード */
+    uint8_t reserved;                                         /**< 予約（0xFF） */
+    uint16_t checksum;                                        /**< チェックサム（有効フラグ以外）*/
+    uint16_t serialized_size;                                 /**< ゲームコア演算状態1つ分のシリアライズサイズ（形式確認用） */
+    uint32_t timer_elapsed_us;                                /**< ゲームタイマの経過時間[us]（スプリント・ウルトラのみ） */
+    uint8_t core_state[TETRIS_CORE_SERIALIZED_SIZE];          /**< 自分のゲームコア演算状態 */
+    uint8_t opponent_core_state[TETRIS_CORE_SERIALIZED_SIZE]; /**< 対戦相手のゲームコア演算状態（CPU対戦のみ） */
+} suspend_data_t;
+_Static_assert(sizeof(suspend_data_t) <= FLASH_PAGE_SIZE, "suspend_data_t must fit in one flash page (FLASH_program_page writes FLASH_PAGE_SIZE bytes)");
+
+/**
+ * @brief ページ書き込みバッファ
+ */
+typedef union
+{
+    suspend_data_t data;            /**< 中断データ */
+    uint8_t bytes[FLASH_PAGE_SIZE]; /**< ページ書き込みデータ（RAM上にある必要がある） */
+} suspend_page_t;
+
+//======================================================
+// 変数・定数
+//======================================================
+static suspend_page_t page_buffer; // ページ書き込みバッファ
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static const suspend_data_t *find_latest_data(uint8_t *page_ptr);
+static uint16_t calculate_checksum(const suspend_data_t *data_ptr);
+static bool check_page_blank(uint8_t page);
+static void invalidate_page(uint8_t page);
+static uint32_t get_page_offset(uint8_t page);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief ゲーム中断
+ * @param game_mode ゲームモード
+ * @param compute_state_ptr 自分の演算状態
+ * @param opponent_state_ptr 対戦相手ステート（CPU対戦のみ参照）
+ * @param timer_ptr ゲームタイマ（スプリント・ウルトラのみ参照）
+ * @return なし
+ * @details 中断データを作って次の空きページに書き込む。空きページが無ければセクタを消去してから先頭ページに書く
+ *          書き込み先が消去済みでない場合（書き込み途中の電源断・識別値の無いゴミ等）もセクタを消去してから先頭ページに書く
+ *          ゲームを止める操作なので、書き込み（1ms程度）・消去（数十ms）で10msタスクが止まってもプレイには影響しない
+ *          練習モードのアンドゥ履歴、自動操作・対戦相手の操作状態は保存しない（再開後のミノから取り直す）
+ */
+void tetris_suspend_game(tetris_game_mode_t game_mode, const tetris_compute_state_t *compute_state_ptr, const tetris_opponent_state_t *opponent_state_ptr, const tetris_game_timer_t *timer_ptr)
+{
+    suspend_data_t *data_ptr = &page_buffer.data;
+    uint8_t page;
+
+    for (uint16_t i = 0; i < FLASH_PAGE_SIZE; i++)
+        page_buffer.bytes[i] = 0xFF;
+
+    data_ptr->magic = SUSPEND_MAGIC;
+    data_ptr->is_valid = SUSPEND_VALID;
+    data_ptr->game_mode = (uint8_t)game_mode;
+    data_ptr->serialized_size = TETRIS_CORE_SERIALIZED_SIZE;
+    data_ptr->timer_elapsed_us = (game_mode_sprint == game_mode || game_mode_ultra == game_mode) ? tetris_get_game_timer_elapsed_us(timer_ptr) : 0;
+    TETRIS_CORE_serialize(&compute_state_ptr->core_state, data_ptr->core_state);
+    if (game_mode_versus == game_mode)
+        TETRIS_CORE_serialize(&opponent_state_ptr->compute_state.core_state, data_ptr->opponent_core_state);
+    data_ptr->checksum = calculate_checksum(data_ptr);
+
+    // 書き込み先：最後に書いたページの次（使い切っている・消去済みでなければセクタを消去して先頭）
+    if (NULL == find_latest_data(&page))
+        page = 0;
+    else
+        page++;
+    if (SUSPEND_PAGES_PER_SECTOR <= page || !check_page_blank(page))
+    {
+        FLASH_erase_sector(SUSPEND_FLASH_OFFSET);
+        page = 0;
+    }
+
+    FLASH_program_page(get_page_offset(page), page_buffer.bytes);
+}
+
+/**
+ * @brief ゲーム再開
+ * @param game_mode_ptr ゲームモード格納先
+ * @param compute_state_ptr 自分の演算状態格納先
+ * @param opponent_state_ptr 対戦相手ステート格納先
+ * @param timer_ptr ゲームタイマ格納先
+ * @return 再開した場合true（中断データが無い・再開済み・壊れている場合はfalseで、格納先は変更しない）
+ * @details 起動時に1回呼ぶ。最後に書いた中断データを復元し、再開済みにしてから返す
+ *          フラッシュはXIP経由で読み、復元はシリアライズ結果の展開のみ。無効化の書き込み1回（1ms程度）が加わる
+ */
+bool tetris_resume_game(tetris_game_mode_t *game_mode_ptr, tetris_compute_state_t *compute_state_ptr, tetris_opponent_state_t *opponent_state_ptr, tetris_game_timer_t *timer_ptr)
+{
+    uint8_t page;
+    const suspend_data_t *data_ptr = find_latest_data(&page);
+
+    if (NULL == data_ptr || SUSPEND_VALID != data_ptr->is_valid)
+        return false;
+    if (TETRIS_CORE_SERIALIZED_SIZE != data_ptr->serialized_size || TETRIS_GAME_MODE_NUMBER <= data_ptr->game_mode || calculate_checksum(data_ptr) != data_ptr->checksum)
+        return false;
+
+    tetris_game_mode_t game_mode = (tetris_game_mode_t)data_ptr->game_mode;
+    TETRIS_CORE_state_t core_state;
+    TETRIS_CORE_state_t opponent_core_state;
+    if (!TETRIS_CORE_deserialize(&core_state, data_ptr->core_state))
+        return false;
+    if (game_mode_versus == game_mode && !TETRIS_CORE_deserialize(&opponent_core_state, data_ptr->opponent_core_state))
+        return false;
+
+    // 演算状態：ゲーム開始時と同じ初期化の後、ゲームコアの演算状態だけ差し替える
+    tetris_initialize_data_compute(compute_state_ptr, game_mode);
+    compute_state_ptr->core_state = core_state;
+    if (game_mode_versus == game_mode)
+    {
+        tetris_initialize_versus(opponent_state_ptr);
+        opponent_state_ptr->compute_state.core_state = opponent_core_state;
+    }
+    if (game_mode_sprint == game_mode || game_mode_ultra == game_mode)
+        tetris_restore_game_timer(timer_ptr, game_mode, data_ptr->timer_elapsed_us);
+    *game_mode_ptr = game_mode;
+
+    invalidate_page(page); // 再開済みにする
+
+    return true;
+}
+
+/**
+ * @brief 中断データ破棄
+ * @return なし
+ * @details 新しいゲームの開始時に呼ぶ。未再開の中断データが残っていれば無効化し、次回起動時に古いゲームへ戻らないようにする
+ *          中断データが無い・再開済みの場合はフラッシュを読むだけで書き込まない
+ */
+void tetris_discard_suspended_game()
+{
+    uint8_t page;
+    const suspend_data_t *data_ptr = find_latest_data(&page);
+
+    if (NULL != data_ptr && SUSPEND_VALID == data_ptr->is_valid)
+        invalidate_page(page);
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief 最後に書いた中断データの検索
+ * @param page_ptr 見つかったページ番号の格納先
+ * @return 中断データ（XIP領域上のアドレス。1ページも書いていなければNULL）
+ * @details ページは先頭から順に使うので、識別値が消去済みでない最後のページが最新
+ */
+static const suspend_data_t *find_latest_data(uint8_t *page_ptr)
+{
+    for (uint8_t page = SUSPEND_PAGES_PER_SECTOR; page; page--)
+    {
+        const suspend_data_t *data_ptr = (const suspend_data_t *)FLASH_get_read_address(get_page_offset(page - 1));
+        if (0xFF != data_ptr->magic)
+        {
+            *page_ptr = page - 1;
+            return data_ptr;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief ページ消去済み判定
+ * @param page ページ番号
+ * @return true：全byteが消去済み（0xFF）で、そのまま書き込める
+ * @details フラッシュの書き込みは1→0の変化しかできないので、0xFF以外が残っているページに書くとデータが壊れる
+ */
+static bool check_page_blank(uint8_t page)
+{
+    const uint8_t *byte_ptr = FLASH_get_read_address(get_page_offset(page));
+
+    for (uint16_t i = 0; i < FLASH_PAGE_SIZE; i++)
+    {
+        if (0xFF != byte_ptr[i])
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief ページ無効化
+ * @param page ページ番号
+ * @return なし
+ * @details 有効フラグのみ0を書き込み、他のbyteは0xFFで書き込んで変化させない
+ */
+static void invalidate_page(uint8_t page)
+{
+    for (uint16_t i = 0; i < FLASH_PAGE_SIZE; i++)
+        page_buffer.bytes[i] = 0xFF;
+    page_buffer.data.is_valid = SUSPEND_INVALID;
+    FLASH_program_page(get_page_offset(page), page_buffer.bytes);
+}
+
+/**
+ * @brief チェックサム計算
+ * @param data_ptr 中断データ
+ * @return チェックサム（識別値・ゲームモード・サイズ・経過時間・演算状態の全byteの和の反転）
+ * @details 有効フラグは再開時に書き換えるので含めない
+ */
+static uint16_t calculate_checksum(const suspend_data_t *data_ptr)
+{
+    uint16_t sum = data_ptr->magic + data_ptr->game_mode;
+    const uint8_t *byte_ptr = (const uint8_t *)&data_ptr->serialized_size;
+
+    for (uint16_t i = 0; i < sizeof(suspend_data_t) - offsetof(suspend_data_t, serialized_size); i++)
+        sum += byte_ptr[i];
+
+    return (uint16_t)~sum;
+}
+
+/**
+ * @brief ページのオフセット取得
+ * @param page ページ番号
+ * @return フラッシュ先頭からのオフセット
+ */
+static uint32_t get_page_offset(uint8_t page)
+{
+    return SUSPEND_FLASH_OFFSET + page * FLASH_PAGE_SIZE;
+}
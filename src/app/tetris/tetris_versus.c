@@ -0,0 +1,122 @@
+/**
+ * @file   tetris_versus.c
+ * @brief  tetris・CPU対戦処理実装
+ * @details 対戦相手の盤面を演算ステートをもう1つ持って動かし、行消去によるせり上がりを両盤面の間で受け渡す
+ *          対戦相手の入力はゲームコアの自動操作で生成する。10msタスク内で2盤面分を処理するため、
+ *          対戦相手はネクストミノを読まない配置探索とし、オートシフトはステップ直前に実経過時間分まとめて進める（1msタスクは自分の盤面のみ）
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris.h"
+#include "tetris_internal.h"
+#include "tetris_core.h"
+#include "typedef.h"
+#include "timer.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define VERSUS_CPU_LOOKAHEAD_ENABLE false // 対戦相手の配置探索でネクストミノまで読むか（処理時間を抑えるため読まない）
+#define VERSUS_CPU_REACTION_US 300000     // 対戦相手がミノ出現から操作を始めるまでの時間[us]（CPUの強さ調整）
+#define VERSUS_SEED_SALT 0x5A5A5A5A       // 対戦相手のミノ順を自分と異なるものにするためのシード加工値
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static void decide_cpu_input(tetris_opponent_state_t *opponent_state_ptr, TETRIS_CORE_input_t *core_input_ptr);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief CPU対戦相手初期化
+ * @param opponent_state_ptr 対戦相手ステート格納先
+ * @return なし
+ * @details ゲーム開始時＆ゲームオーバー後のゲームリスタート時に、自分の演算状態と合わせて呼ぶ
+ */
+void tetris_initialize_versus(tetris_opponent_state_t *opponent_state_ptr)
+{
+    tetris_compute_state_t *compute_state_ptr = &opponent_state_ptr->compute_state;
+
+    TETRIS_CORE_initialize(&compute_state_ptr->core_state, (uint32_t)TIMER_get_time_us() ^ VERSUS_SEED_SALT);
+    compute_state_ptr->core_state.auto_shift.is_external = true; // 自分の盤面と同じく実経過時間で進める
+    compute_state_ptr->auto_shift_time_us = TIMER_get_time_us();
+    compute_state_ptr->is_display_changed = true;
+
+    TETRIS_CORE_ai_initialize_player(&opponent_state_ptr->cpu_player, VERSUS_CPU_LOOKAHEAD_ENABLE);
+    opponent_state_ptr->reaction_end_time_us = VERSUS_CPU_REACTION_US;
+}
+
+/**
+ * @brief CPU対戦 演算処理
+ * @param compute_state_ptr 自分の演算状態（今回のステップを処理済みであること）
+ * @param opponent_state_ptr 対戦相手ステート
+ * @param player_state_next 自分の盤面の次ゲームステート
+ * @return 次ゲームステート
+ * @details 対戦相手の盤面を前回からの実経過時間分進めてから1ステップ演算し、両盤面が今回送ったせり上がりを相手の受け取り待ちに積む
+ *          受け取り待ち行数は両盤面に表示しているため、受け渡しがあれば両方の表示更新を要求する
+ *          どちらかの盤面がゲームオーバーになれば対戦終了
+ */
+tetris_game_state_t tetris_data_compute_versus(tetris_compute_state_t *compute_state_ptr, tetris_opponent_state_t *opponent_state_ptr, tetris_game_state_t player_state_next)
+{
+    tetris_compute_state_t *opponent_compute_ptr = &opponent_state_ptr->compute_state;
+
+    TETRIS_CORE_input_t cpu_input;
+    decide_cpu_input(opponent_state_ptr, &cpu_input);
+    tetris_advance_game_time(opponent_compute_ptr, &cpu_input);
+    TETRIS_CORE_step_result_t opponent_result = tetris_data_compute_step(opponent_compute_ptr, &cpu_input);
+
+    // せり上がり受け渡し
+    uint8_t rows_to_opponent = TETRIS_CORE_take_outgoing_garbage(&compute_state_ptr->core_state);
+    uint8_t rows_to_player = TETRIS_CORE_take_outgoing_garbage(&opponent_compute_ptr->core_state);
+    if (rows_to_opponent || rows_to_player)
+    {
+        TETRIS_CORE_receive_garbage(&opponent_compute_ptr->core_state, rows_to_opponent);
+        TETRIS_CORE_receive_garbage(&compute_state_ptr->core_state, rows_to_player);
+        compute_state_ptr->is_display_changed = true;
+        opponent_compute_ptr->is_display_changed = true;
+    }
+
+    // ステート移行判定：どちらかがゲームオーバーなら対戦終了
+    return (game_over == player_state_next || core_game_over == opponent_result) ? game_over : game_running;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief 対戦相手入力決定
+ * @param opponent_state_ptr 対戦相手ステート
+ * @param core_input_ptr ゲームコア入力格納先
+ * @return なし
+ * @details ミノ出現から一定時間（ゲーム経過時間）は入力無しとし、以降は自動操作の入力を使う（人の反応時間を模してCPUを弱める）
+ *          操作ミノ無しのステップでは自動操作に次のミノの探索準備をさせるため、待ち中でも自動操作を呼ぶ
+ */
+static void decide_cpu_input(tetris_opponent_state_t *opponent_state_ptr, TETRIS_CORE_input_t *core_input_ptr)
+{
+    const TETRIS_CORE_state_t *core_state_ptr = &opponent_state_ptr->compute_state.core_state;
+
+    if (core_state_ptr->mino_parameter.is_next_mino_generate)
+    {
+        TETRIS_CORE_ai_decide_input(&opponent_state_ptr->cpu_player, core_state_ptr, &TETRIS_CORE_ai_weight_default, core_input_ptr);
+        opponent_state_ptr->reaction_end_time_us = core_state_ptr->time_us + VERSUS_CPU_REACTION_US;
+    }
+    else if (core_state_ptr->time_us < opponent_state_ptr->reaction_end_time_us)
+    {
+        *core_input_ptr = (TETRIS_CORE_input_t){false};
+    }
+    else
+    {
+        TETRIS_CORE_ai_decide_input(&opponent_state_ptr->cpu_player, core_state_ptr, &TETRIS_CORE_ai_weight_default, core_input_ptr);
+    }
+}
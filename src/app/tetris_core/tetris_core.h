@@ -0,0 +1,452 @@
+/**
+ * @file   tetris_core.h
+ * @brief  tetrisゲームコア・外部公開定義
+ * @details ミノ生成・移動・回転・接地・行消去・スコア・レベル更新のゲームルール演算を行う
+ *          ドライバ層・定数ビットマップに依存しないため、ターゲット外（Linux等のホスト環境）でも単体ビルドできる
+ */
+
+#ifndef __TETRIS_CORE_H__
+#define __TETRIS_CORE_H__
+
+//======================================================
+// インクルード
+//======================================================
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+// フィールド定義（フィールドの寸法はここでのみ定義し、演算・描画とも以下のマクロから導出する）
+// 上から順に、描画範囲外のバッファ行（末尾4行が操作ミノ生成位置）、ブロック描画範囲の行が並ぶ
+// 標準的な10×40フィールド（描画範囲20行）とする場合はTETRIS_CORE_FIELD_HIDDEN_ROWSを20にする
+#define TETRIS_CORE_FIELD_WIDTH 10        // フィールド幅（壁を除くブロック数、4～12）
+#define TETRIS_CORE_FIELD_HIDDEN_ROWS 4   // 描画範囲より上のバッファ行数（4以上）
+#define TETRIS_CORE_FIELD_VISIBLE_ROWS 20 // 描画範囲の行数
+
+// フィールド高さ（床を除く行数）・描画範囲の先頭行
+#define TETRIS_CORE_FIELD_HEIGHT (TETRIS_CORE_FIELD_HIDDEN_ROWS + TETRIS_CORE_FIELD_VISIBLE_ROWS)
+#define TETRIS_CORE_FIELD_VISIBLE_TOP TETRIS_CORE_FIELD_HIDDEN_ROWS
+
+// フィールド行ビットマスク：bit15が列0（左壁）、bit14から下位にフィールド幅分が列1～（ブロック）、残りの下位ビットが右壁
+#define TETRIS_CORE_ROW_BLOCK_SHIFT (15 - TETRIS_CORE_FIELD_WIDTH) // 右壁のビット数（最右列のブロックのビット位置）
+#define TETRIS_CORE_ROW_BLOCK_MASK ((uint16_t)(((1u << TETRIS_CORE_FIELD_WIDTH) - 1) << TETRIS_CORE_ROW_BLOCK_SHIFT))
+#define TETRIS_CORE_ROW_WALL_MASK ((uint16_t)~TETRIS_CORE_ROW_BLOCK_MASK)
+
+// 右壁は最右列からはみ出したブロックの列（1列）まで必要。行数は基準点（int8_t）で表せる範囲
+#if (TETRIS_CORE_FIELD_WIDTH < 4) || (12 < TETRIS_CORE_FIELD_WIDTH)
+#error "TETRIS_CORE_FIELD_WIDTH must be 4 to 12"
+#endif
+#if (TETRIS_CORE_FIELD_HIDDEN_ROWS < 4) || (100 < TETRIS_CORE_FIELD_HEIGHT)
+#error "TETRIS_CORE_FIELD_HIDDEN_ROWS must be 4 or more, and TETRIS_CORE_FIELD_HEIGHT must be 100 or less"
+#endif
+
+// ミノ定義パラメータ（1ミノを5×5の32bitマスクで表現する。bit24が左上、行優先で1行5bit）
+#define TETRIS_CORE_MINO_LENGTH 5
+#define TETRIS_CORE_MINO_ROW_MASK ((1u << TETRIS_CORE_MINO_LENGTH) - 1)
+#define TETRIS_CORE_MINO_CELL_BIT(row, column) (1u << (TETRIS_CORE_MINO_LENGTH * (TETRIS_CORE_MINO_LENGTH - 1 - (row)) + (TETRIS_CORE_MINO_LENGTH - 1 - (column))))
+#define TETRIS_CORE_NUMBER_MINO_TYPES 19 // 全ピースセットのミノ種別数
+#define TETRIS_CORE_NUMBER_PIECE_SETS 2
+
+// ネクストミノの先読み数（ネクスト表示数）
+#define TETRIS_CORE_NEXT_QUEUE_LENGTH 5
+
+// 一度に消去可能な最大行数（得点・攻撃・統計の表の範囲。ペントミノの5行消去はこの行数として扱う）
+#define TETRIS_CORE_ERASE_ROW_MAX 4
+
+// ゲーム最大レベル（レベル10以降は1ステップに1マス以上落下する高速落下レベル）
+#define TETRIS_CORE_MAXIMUM_LEVEL 15
+
+// せり上がり（対戦時に相手から送られるブロック行）の受け取り待ち行数の上限
+#define TETRIS_CORE_GARBAGE_PENDING_MAX 20
+
+// 演算状態スナップショットの保存世代数（練習モードのアンドゥで戻れるミノ数）
+#define TETRIS_CORE_SNAPSHOT_RING_LENGTH 8
+
+// 演算状態シリアライズ後のサイズ[byte]（フィールドはブロックのビットのみ詰めて格納する）
+#define TETRIS_CORE_SERIALIZED_FIELD_SIZE ((TETRIS_CORE_FIELD_WIDTH * TETRIS_CORE_FIELD_HEIGHT + 7) / 8)
+#define TETRIS_CORE_SERIALIZED_SIZE (64 + TETRIS_CORE_NEXT_QUEUE_LENGTH + TETRIS_CORE_SERIALIZED_FIELD_SIZE)
+
+// スコア上限（表示桁数7桁）
+#define TETRIS_CORE_SCORE_MAX 9999999
+
+// 自由落下速度の単位（ステップ周期あたりの落下量を1/256マス単位の固定小数点で表す。20G = 20 * 256）
+#define TETRIS_CORE_GRAVITY_ONE_CELL 256
+
+// ゲームコア1ステップの周期[us]（オートシフトをステップ内で進める場合の経過時間。自由落下速度の時間単位）
+#define TETRIS_CORE_STEP_PERIOD_US 10000
+
+//======================================================
+// 型定義
+//======================================================
+/**
+ * @brief ミノ種別定義
+ */
+typedef enum
+{
+    mino_I = 0, /**< I字型ミノ */
+    mino_J,     /**< J字型ミノ */
+    mino_L,     /**< L字型ミノ */
+    mino_O,     /**< O字型ミノ */
+    mino_S,     /**< S字型ミノ */
+    mino_T,     /**< T字型ミノ */
+    mino_Z,     /**< Z字型ミノ */
+    mino_F5,    /**< F字型ペントミノ */
+    mino_I5,    /**< I字型ペントミノ */
+    mino_L5,    /**< L字型ペントミノ */
+    mino_N5,    /**< N字型ペントミノ */
+    mino_P5,    /**< P字型ペントミノ */
+    mino_T5,    /**< T字型ペントミノ */
+    mino_U5,    /**< U字型ペントミノ */
+    mino_V5,    /**< V字型ペントミノ */
+    mino_W5,    /**< W字型ペントミノ */
+    mino_X5,    /**< X字型ペントミノ */
+    mino_Y5,    /**< Y字型ペントミノ */
+    mino_Z5,    /**< Z字型ペントミノ */
+} TETRIS_CORE_mino_type_t;
+
+/**
+ * @brief ピースセット定義
+ * @details ネクストミノとして抽選するミノ種別の組。ゲームモード毎に選択する
+ */
+typedef enum
+{
+    piece_set_tetromino = 0, /**< テトリミノ7種（mino_I～mino_Z） */
+    piece_set_pentomino,     /**< ペントミノ12種（mino_F5～mino_Z5） */
+} TETRIS_CORE_piece_set_t;
+
+/**
+ * @brief ミノ回転状態定義
+ */
+typedef enum
+{
+    r_no_turn = 0, /**< 回転無し（基準状態） */
+    r_1_turn,      /**< 右に1回転の状態 */
+    r_2_turn,      /**< 右に2回転の状態 */
+    r_3_turn,      /**< 右に3回転の状態 */
+} TETRIS_CORE_mino_turn_state_t;
+
+/**
+ * @brief ゲームコア入力定義
+ * @details 1ステップ（1フレーム）分の入力。入力デバイスとの対応付けは呼び出し側で行う
+ */
+typedef struct
+{
+    bool is_input_R;     /**< 右移動入力 */
+    bool is_input_L;     /**< 左移動入力 */
+    bool is_input_U;     /**< 上入力（ハードドロップ。押した瞬間のみ有効なので押しっぱなしでよい） */
+    bool is_input_D;     /**< 下移動（高速落下）入力 */
+    bool is_input_turnR; /**< 右回転入力（押下直後の1ステップのみtrueとすること） */
+    bool is_input_turnL; /**< 左回転入力（押下直後の1ステップのみtrueとすること） */
+    bool is_input_hold;  /**< ホールド入力（押下直後の1ステップのみtrueとすること） */
+} TETRIS_CORE_input_t;
+
+/**
+ * @brief ミノ演算パラメータ定義
+ * @note 基準点はミノ定義5×5の左上がフィールド上のどこにあるかを示す
+ */
+typedef struct
+{
+    int8_t reference_x;                                                     /**< ミノの基準点（X軸） */
+    int8_t reference_y;                                                     /**< ミノの基準点（Y軸） */
+    uint8_t distance_to_landing;                                            /**< ミノの現在地点から着地点までの距離（ミノの移動・回転の度に更新される） */
+    TETRIS_CORE_mino_turn_state_t turn_state;                               /**< ミノの回転状態 */
+    TETRIS_CORE_mino_type_t mino_type;                                      /**< ミノの種別 */
+    TETRIS_CORE_mino_type_t next_mino_queue[TETRIS_CORE_NEXT_QUEUE_LENGTH]; /**< ネクストミノの種別（先頭が次に生成されるミノ） */
+    TETRIS_CORE_mino_type_t hold_mino_type;                                 /**< ホールド中のミノの種別（is_holdingがtrueの時のみ有効） */
+    bool is_holding;                                                        /**< ホールド中のミノ有無 */
+    bool is_hold_available;                                                 /**< ホールド可能フラグ（ホールドはミノ1つにつき1回まで） */
+    bool is_next_mino_generate;                                             /**< 次回ステップでのミノ新規生成フラグ（trueの間は操作ミノ無し） */
+    bool is_last_move_turn;                                                 /**< 最後に成功した操作が回転か（移動・落下でfalse。Tスピン判定用） */
+} TETRIS_CORE_mino_parameter_t;
+
+/**
+ * @brief フィールド演算パラメータ定義
+ * @details 1行を16bitマスクで表現する（壁のビットを含む）。フィールド外（床）は全ビット埋まっている扱い
+ */
+typedef struct
+{
+    uint16_t row[TETRIS_CORE_FIELD_HEIGHT]; /**< フィールド各行のビットマスク */
+} TETRIS_CORE_field_parameter_t;
+
+/**
+ * @brief Tスピン種別定義
+ */
+typedef enum
+{
+    t_spin_none = 0, /**< Tスピン無し */
+    t_spin_mini,     /**< Tスピンミニ（凸側の隅が片方のみ埋まっている） */
+    t_spin_full,     /**< Tスピン */
+} TETRIS_CORE_t_spin_t;
+
+/**
+ * @brief ゲーム制御パラメータ定義
+ */
+typedef struct
+{
+    uint8_t level;                      /**< ゲームレベル */
+    uint16_t row_deleted;               /**< 合計消去行数 */
+    uint32_t score;                     /**< ゲームスコア（TETRIS_CORE_SCORE_MAXで頭打ち） */
+    uint8_t combo;                      /**< 連続で行消去したミノ数（行消去の無いミノの固定で0に戻る） */
+    bool is_back_to_back;               /**< 直前の行消去が難しい消去（4行消去・行消去を伴うTスピン）だった */
+    TETRIS_CORE_t_spin_t latest_t_spin; /**< 直近に固定したミノのTスピン種別 */
+    bool is_updated;                    /**< ゲーム制御パラメータ更新有無 */
+} TETRIS_CORE_game_parameter_t;
+
+/**
+ * @brief ミノ移動カウンター定義
+ * @details 自由落下もゲーム経過時間で進める（ステップ数では数えない）。落下量は落下速度[1/256マス/ステップ周期]×経過時間[us]で積算する
+ */
+typedef struct
+{
+    uint32_t D;            /**< 下移動カウンタ（1マス未満の落下量の端数[1/256マス×us]。TETRIS_CORE_GRAVITY_ONE_CELL×TETRIS_CORE_STEP_PERIOD_USで1マス） */
+    uint64_t fall_time_us; /**< 前回自由落下を処理したゲーム経過時間[us] */
+} TETRIS_CORE_move_counter_t;
+
+/**
+ * @brief オートシフト設定定義
+ * @details 左右移動：押下直後に1マス移動し、DAS経過後はARR毎に1マスずつ移動する（ARRが0の場合は壁・ブロックまで一気に移動）
+ *          高速落下：押下直後に1マス落下し、以降soft_drop_us毎に1マスずつ落下する（0の場合は着地点まで一気に落下）
+ */
+typedef struct
+{
+    uint32_t das_us;       /**< 左右移動のリピート開始までの時間（DAS）[us] */
+    uint32_t arr_us;       /**< 左右移動のリピート間隔（ARR）[us] */
+    uint32_t soft_drop_us; /**< 高速落下の1マスあたりの時間[us] */
+} TETRIS_CORE_auto_shift_config_t;
+
+/**
+ * @brief オートシフト状態定義
+ */
+typedef struct
+{
+    int8_t direction;       /**< 左右移動入力の方向（-1：左、0：入力無し、1：右） */
+    int32_t shift_timer_us; /**< 次の左右移動までの残り時間[us] */
+    bool is_soft_dropping;  /**< 高速落下中フラグ */
+    int32_t drop_timer_us;  /**< 次の高速落下までの残り時間[us] */
+    bool is_external;       /**< ステップ外の周期処理から駆動するか（falseの場合はステップ毎にステップ周期分進める） */
+} TETRIS_CORE_auto_shift_t;
+
+/**
+ * @brief 接地猶予（ロックディレイ）設定定義
+ * @details 接地中に移動・回転できた場合はreset_limit回まで猶予時間を計り直す
+ */
+typedef struct
+{
+    uint32_t lock_delay_us; /**< 接地してから固定するまでの猶予時間[us] */
+    uint8_t reset_limit;    /**< 移動・回転による猶予延長の上限回数（ミノ毎） */
+} TETRIS_CORE_lock_delay_config_t;
+
+/**
+ * @brief 接地猶予状態定義
+ */
+typedef struct
+{
+    bool is_grounded;            /**< 接地中フラグ */
+    bool has_grounded;           /**< このミノが1回以上接地したか（2回目以降の接地は延長として数える） */
+    uint64_t grounded_time_us;   /**< 最初に接地した時刻[us]（統計用） */
+    uint64_t lock_start_time_us; /**< 猶予時間の計測開始時刻[us]（最初の接地時刻または最後に延長した時刻） */
+    uint8_t reset_count;         /**< 猶予延長回数（再接地を含む） */
+} TETRIS_CORE_lock_delay_t;
+
+/**
+ * @brief 固定タイミング統計定義
+ * @details 遅れは固定期限から実際に固定したステップまでの時間。負荷試験で固定タイミングの精度を確認するために使う
+ */
+typedef struct
+{
+    uint32_t lock_count;         /**< 固定したミノ数 */
+    uint32_t latest_grounded_us; /**< 直近のミノの最初の接地から固定までの時間[us] */
+    uint8_t latest_reset_count;  /**< 直近のミノの猶予延長回数 */
+    uint32_t latest_late_us;     /**< 直近のミノの固定期限からの遅れ[us] */
+    uint32_t max_late_us;        /**< 固定期限からの遅れの最大値[us] */
+} TETRIS_CORE_lock_statistics_t;
+
+/**
+ * @brief プレイ統計定義
+ * @details 入力の押下とミノの固定の度に加算する（固定毎にO(1)）。PPS・KPPは読み出し時に割り算で求める
+ */
+typedef struct
+{
+    uint64_t start_time_us;                              /**< 計測開始のゲーム経過時間[us] */
+    uint64_t last_lock_time_us;                          /**< 最後にミノを固定したゲーム経過時間[us] */
+    uint32_t piece_count;                                /**< 固定したミノ数 */
+    uint32_t input_count;                                /**< 入力数（左右移動・高速落下の押下、回転・ハードドロップ・ホールド） */
+    uint32_t finesse_fault_count;                        /**< 最少手順を超えた入力数の累計 */
+    uint16_t clear_count[TETRIS_CORE_ERASE_ROW_MAX + 1]; /**< 消去行数毎の行消去回数（[0]は未使用） */
+    uint16_t t_spin_clear_count;                         /**< 行消去を伴うTスピン（ミニを含む）の回数 */
+    uint8_t piece_input_count;                           /**< 操作中のミノへの入力数 */
+    bool is_finesse_exempt;                              /**< 操作中のミノを最少手順の判定から除外する（高速落下を使った） */
+} TETRIS_CORE_play_statistics_t;
+
+/**
+ * @brief 難易度テーブル定義
+ * @details レベル曲線とスコア計算の定数。ホストツールで別のテーブルと比較できるよう、演算状態からポインタで参照する
+ */
+typedef struct
+{
+    uint16_t gravity[TETRIS_CORE_MAXIMUM_LEVEL + 1];              /**< レベル毎の自由落下速度[1/256マス/ステップ周期]（TETRIS_CORE_GRAVITY_ONE_CELLで1マス/ステップ周期） */
+    uint8_t score_power_rate[TETRIS_CORE_ERASE_ROW_MAX + 1];      /**< 消去行数毎のスコア倍率 */
+    uint16_t next_level_need_row[TETRIS_CORE_MAXIMUM_LEVEL];      /**< レベル毎のレベルアップに必要な合計消去行数（この値を超えたらレベルアップ） */
+} TETRIS_CORE_difficulty_t;
+
+/**
+ * @brief せり上がり状態定義
+ * @details 対戦相手との受け渡しは呼び出し側で行う（TETRIS_CORE_take_outgoing_garbage → TETRIS_CORE_receive_garbage）
+ */
+typedef struct
+{
+    uint8_t pending;       /**< 受け取り待ちの行数（行消去無しでミノを固定した時にフィールドへ加える） */
+    uint8_t outgoing;      /**< 相手に送る行数（取り出されるまで積算する） */
+    uint32_t random_state; /**< 穴の位置決定用の疑似乱数状態（ミノ順とは独立） */
+} TETRIS_CORE_garbage_t;
+
+/**
+ * @brief ゲームコア演算状態定義
+ * @details 1ゲーム分の状態を全て保持する。ファイル内グローバルな状態は持たないため、複数インスタンスを同時に扱える
+ */
+typedef struct
+{
+    TETRIS_CORE_mino_parameter_t mino_parameter;                  /**< ミノ演算パラメータ */
+    TETRIS_CORE_field_parameter_t field_parameter;                /**< フィールド演算パラメータ */
+    TETRIS_CORE_game_parameter_t game_parameter;                  /**< ゲーム制御パラメータ */
+    TETRIS_CORE_move_counter_t move_counter;                      /**< ミノ移動演算用カウンタ */
+    uint8_t row_erased;                                           /**< ミノ接地により消去された行数（スコア計算用） */
+    bool allow_down_shift;                                        /**< 下入力による高速落下の許可フラグ */
+    bool allow_hard_drop;                                         /**< 上入力によるハードドロップの許可フラグ（上入力を離すと許可） */
+    uint32_t random_state;                                        /**< ネクストミノ決定用の疑似乱数状態 */
+    TETRIS_CORE_piece_set_t piece_set;                            /**< ネクストミノの抽選対象のピースセット（初期化時はテトリミノ） */
+    const TETRIS_CORE_difficulty_t *difficulty_ptr;               /**< 難易度テーブル（初期化時は既定値） */
+    TETRIS_CORE_auto_shift_t auto_shift;                          /**< オートシフト状態 */
+    const TETRIS_CORE_auto_shift_config_t *auto_shift_config_ptr; /**< オートシフト設定（初期化時は既定値） */
+    uint64_t time_us;                                             /**< ゲーム経過時間[us]（オートシフト処理に渡された経過時間の累計。ポーズ中は進まない。接地猶予・自由落下の時間基準） */
+    TETRIS_CORE_lock_delay_t lock_delay;                          /**< 接地猶予状態 */
+    const TETRIS_CORE_lock_delay_config_t *lock_delay_config_ptr; /**< 接地猶予設定（初期化時は既定値） */
+    TETRIS_CORE_lock_statistics_t lock_statistics;                /**< 固定タイミング統計 */
+    TETRIS_CORE_play_statistics_t play_statistics;                /**< プレイ統計 */
+    TETRIS_CORE_garbage_t garbage;                                /**< せり上がり状態 */
+    bool is_changed;                                              /**< 前回ステップ以降に表示対象（ミノ・フィールド・ゲームパラメータ）が変化した（ステップ終了時にクリア） */
+} TETRIS_CORE_state_t;
+
+/**
+ * @brief 演算状態スナップショット定義
+ */
+typedef struct
+{
+    TETRIS_CORE_state_t state; /**< 保存した演算状態 */
+    uint64_t time_us;          /**< 保存時刻[us]（保存時に呼び出し側が指定） */
+} TETRIS_CORE_snapshot_t;
+
+/**
+ * @brief 演算状態スナップショットリング定義
+ * @details 最新TETRIS_CORE_SNAPSHOT_RING_LENGTH世代分を保持し、一杯になれば最も古いものから上書きする
+ */
+typedef struct
+{
+    TETRIS_CORE_snapshot_t entry[TETRIS_CORE_SNAPSHOT_RING_LENGTH]; /**< スナップショット格納領域 */
+    uint8_t head;                                                   /**< 次に保存する位置 */
+    uint8_t count;                                                  /**< 保存済みのスナップショット数 */
+} TETRIS_CORE_snapshot_ring_t;
+
+/**
+ * @brief ステップ実行結果定義
+ */
+typedef enum
+{
+    core_running = 0, /**< ゲーム継続 */
+    core_game_over,   /**< ゲームオーバー */
+    core_idle,        /**< ゲーム継続（前回ステップから表示対象の変化無し。再描画不要） */
+} TETRIS_CORE_step_result_t;
+
+/**
+ * @brief 自動操作 盤面評価重み定義
+ * @details 盤面評価値 = Σ(重み × 特徴量)。FPUの無いターゲットでも高速に評価できるよう整数で持つ
+ */
+typedef struct
+{
+    int16_t lines;            /**< 消去行数の重み */
+    int16_t aggregate_height; /**< 各列の高さの合計の重み */
+    int16_t holes;            /**< 穴（上をブロックで塞がれた空きマス）の数の重み */
+    int16_t bumpiness;        /**< 隣接列の高さの差の合計の重み */
+} TETRIS_CORE_ai_weight_t;
+
+/**
+ * @brief 自動操作 配置候補定義
+ */
+typedef struct
+{
+    int8_t reference_x;                       /**< 配置先の基準点（X軸） */
+    TETRIS_CORE_mino_turn_state_t turn_state; /**< 配置先の回転状態 */
+    int32_t evaluation;                       /**< 配置後の盤面評価値 */
+    bool is_found;                            /**< 配置候補が見つかったか */
+} TETRIS_CORE_ai_placement_t;
+
+/**
+ * @brief 自動操作 プレイヤー状態定義
+ * @details ミノ1つにつき1回だけ配置探索を行い、以降は目標配置に向けた入力を生成する
+ */
+typedef struct
+{
+    TETRIS_CORE_ai_placement_t target; /**< 現在の操作ミノの目標配置 */
+    bool is_planned;                   /**< 現在の操作ミノの配置探索済みフラグ */
+    bool is_lookahead_enabled;         /**< ネクストミノまで含めた2手読みの有効フラグ */
+    bool was_turn_input;               /**< 前ステップで回転入力したか（回転入力は押下直後の1ステップのみとするため） */
+    bool was_shift_input;              /**< 前ステップで左右移動入力したか（DASを待たずに連打で移動するため） */
+} TETRIS_CORE_ai_player_t;
+
+//======================================================
+// グローバル変数・定数extern宣言
+//======================================================
+/* ctrl */
+extern const TETRIS_CORE_difficulty_t TETRIS_CORE_difficulty_default;
+
+/* shift */
+extern const TETRIS_CORE_auto_shift_config_t TETRIS_CORE_auto_shift_config_default;
+
+/* lock */
+extern const TETRIS_CORE_lock_delay_config_t TETRIS_CORE_lock_delay_config_default;
+
+/* ai */
+extern const TETRIS_CORE_ai_weight_t TETRIS_CORE_ai_weight_default;
+
+//======================================================
+// グローバル関数extern宣言
+//======================================================
+/* init */
+extern void TETRIS_CORE_initialize(TETRIS_CORE_state_t *state_ptr, uint32_t seed);
+
+/* ctrl */
+extern TETRIS_CORE_step_result_t TETRIS_CORE_step(TETRIS_CORE_state_t *state_ptr, const TETRIS_CORE_input_t *input_ptr);
+
+/* shift */
+extern void TETRIS_CORE_auto_shift(TETRIS_CORE_state_t *state_ptr, const TETRIS_CORE_input_t *input_ptr, uint32_t elapsed_us);
+
+/* ops */
+extern uint32_t TETRIS_CORE_get_mino_row_mask(uint32_t mino_shape, uint8_t mino_row, int8_t reference_x);
+
+/* piece */
+extern uint32_t TETRIS_CORE_get_mino_shape(TETRIS_CORE_mino_type_t mino_type, TETRIS_CORE_mino_turn_state_t turn);
+extern void TETRIS_CORE_select_piece_set(TETRIS_CORE_state_t *state_ptr, TETRIS_CORE_piece_set_t piece_set);
+
+/* garbage */
+extern void TETRIS_CORE_receive_garbage(TETRIS_CORE_state_t *state_ptr, uint8_t rows);
+extern uint8_t TETRIS_CORE_take_outgoing_garbage(TETRIS_CORE_state_t *state_ptr);
+
+/* snapshot */
+extern void TETRIS_CORE_initialize_snapshot_ring(TETRIS_CORE_snapshot_ring_t *ring_ptr);
+extern void TETRIS_CORE_save_snapshot(TETRIS_CORE_snapshot_ring_t *ring_ptr, const TETRIS_CORE_state_t *state_ptr, uint64_t time_us);
+extern const TETRIS_CORE_snapshot_t *TETRIS_CORE_restore_snapshot(TETRIS_CORE_snapshot_ring_t *ring_ptr, uint8_t generations_back, TETRIS_CORE_state_t *state_ptr);
+
+/* serialize */
+extern void TETRIS_CORE_serialize(const TETRIS_CORE_state_t *state_ptr, uint8_t *buffer);
+extern bool TETRIS_CORE_deserialize(TETRIS_CORE_state_t *state_ptr, const uint8_t *buffer);
+
+/* stats */
+extern uint32_t TETRIS_CORE_get_pieces_per_second_x100(const TETRIS_CORE_play_statistics_t *statistics_ptr);
+extern uint32_t TETRIS_CORE_get_inputs_per_piece_x100(const TETRIS_CORE_play_statistics_t *statistics_ptr);
+
+/* ai */
+extern void TETRIS_CORE_ai_search_placement(const TETRIS_CORE_state_t *state_ptr, const TETRIS_CORE_ai_weight_t *weight_ptr, bool is_lookahead_enabled, TETRIS_CORE_ai_placement_t *placement_ptr);
+extern void TETRIS_CORE_ai_initialize_player(TETRIS_CORE_ai_player_t *player_ptr, bool is_lookahead_enabled);
+extern bool TETRIS_CORE_ai_decide_input(TETRIS_CORE_ai_player_t *player_ptr, const TETRIS_CORE_state_t *state_ptr, const TETRIS_CORE_ai_weight_t *weight_ptr, TETRIS_CORE_input_t *input_ptr);
+
+#endif /* __TETRIS_CORE_H__ */
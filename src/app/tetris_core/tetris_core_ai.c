@@ -0,0 +1,375 @@
+/**
+ * @file   tetris_core_ai.c
+ * @brief  tetrisゲームコア・自動操作（配置探索）実装
+ * @details 操作ミノ（＋ネクストミノ）の到達可能な全ての回転状態・列について接地後の盤面を評価し、最良の配置へ向かう入力を生成する
+ *          盤面は1行16bitのフィールドをそのまま複製して使うため、1候補あたりの評価は行数分のビット演算で済む
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris_core.h"
+#include "tetris_core_internal.h"
+#include "tetris_core_ai_weight.h"
+#include "typedef.h"
+#include "math_lib.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define EVALUATION_GAME_OVER (INT32_MIN / 2) // ゲームオーバーになる配置の評価値（加算してもオーバーフローしない値）
+// 隣接列ペアの比較結果を取り出すマスク：(covered ^ (covered >> 1))のbit kはbit kとbit k+1（左隣の列）の比較なので、
+// 左隣もブロック列であるビットのみ取り出す（幅10なら列1&2～列9&10のbit13～5。壁との比較は含めない）
+#define ADJACENT_COLUMN_PAIR_MASK ((uint16_t)(TETRIS_CORE_ROW_BLOCK_MASK & (TETRIS_CORE_ROW_BLOCK_MASK >> 1)))
+
+// 隣接列ペアはフィールド幅 - 1組で、最右列のブロックのビット位置から並ぶ
+_Static_assert(ADJACENT_COLUMN_PAIR_MASK == (((1u << (TETRIS_CORE_FIELD_WIDTH - 1)) - 1) << TETRIS_CORE_ROW_BLOCK_SHIFT), "ADJACENT_COLUMN_PAIR_MASK must cover TETRIS_CORE_FIELD_WIDTH - 1 column pairs");
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+// 評価重みの既定値（tetris_core_ai_weight.hで定義。ホストツールでの調整結果を反映する）
+const TETRIS_CORE_ai_weight_t TETRIS_CORE_ai_weight_default = {
+    .lines = TETRIS_CORE_AI_WEIGHT_LINES,
+    .aggregate_height = TETRIS_CORE_AI_WEIGHT_AGGREGATE_HEIGHT,
+    .holes = TETRIS_CORE_AI_WEIGHT_HOLES,
+    .bumpiness = TETRIS_CORE_AI_WEIGHT_BUMPINESS,
+};
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static int32_t search_best_evaluation(const TETRIS_CORE_field_parameter_t *field_ptr, TETRIS_CORE_mino_type_t mino_type, TETRIS_CORE_mino_turn_state_t turn_state, int8_t reference_x, int8_t reference_y,
+                                      uint8_t lines_before, const TETRIS_CORE_ai_weight_t *weight_ptr, const TETRIS_CORE_mino_type_t *next_mino_type_ptr, TETRIS_CORE_ai_placement_t *placement_ptr);
+static bool check_turn_reachable(const TETRIS_CORE_field_parameter_t *field_ptr, TETRIS_CORE_mino_type_t mino_type, TETRIS_CORE_mino_turn_state_t turn_from, TETRIS_CORE_mino_turn_state_t turn_to, int8_t reference_x, int8_t reference_y);
+static int8_t get_spawn_reference_y(const TETRIS_CORE_field_parameter_t *field_ptr, uint32_t mino_shape, int8_t reference_x);
+static int8_t get_top_block_row(const TETRIS_CORE_field_parameter_t *field_ptr);
+static bool check_row_filled(const TETRIS_CORE_field_parameter_t *field_ptr, int8_t reference_y);
+static int32_t evaluate_field(const TETRIS_CORE_field_parameter_t *field_ptr, uint8_t lines, const TETRIS_CORE_ai_weight_t *weight_ptr);
+static int8_t get_turn_direction(TETRIS_CORE_mino_turn_state_t turn_from, TETRIS_CORE_mino_turn_state_t turn_to);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief 最良配置探索
+ * @param state_ptr ゲームコア演算状態
+ * @param weight_ptr 盤面評価重み
+ * @param is_lookahead_enabled true：ネクストミノの配置まで含めて評価する（2手読み）
+ * @param placement_ptr 探索結果格納先
+ * @return なし
+ * @details 操作ミノの現在位置から、その場での回転と左右移動のみで到達できる配置を全て列挙する
+ *          2手読み時はネクストミノを出現位置から同様に全列挙し、2手後の盤面の最良評価値を1手目の評価値とする
+ */
+void TETRIS_CORE_ai_search_placement(const TETRIS_CORE_state_t *state_ptr, const TETRIS_CORE_ai_weight_t *weight_ptr, bool is_lookahead_enabled, TETRIS_CORE_ai_placement_t *placement_ptr)
+{
+    const TETRIS_CORE_mino_parameter_t *mino_ptr = &state_ptr->mino_parameter;
+
+    placement_ptr->is_found = false;
+    placement_ptr->evaluation = EVALUATION_GAME_OVER;
+    placement_ptr->reference_x = mino_ptr->reference_x;
+    placement_ptr->turn_state = mino_ptr->turn_state;
+
+    search_best_evaluation(&state_ptr->field_parameter, mino_ptr->mino_type, mino_ptr->turn_state, mino_ptr->reference_x, mino_ptr->reference_y,
+                           0, weight_ptr, (is_lookahead_enabled) ? &mino_ptr->next_mino_queue[0] : NULL, placement_ptr);
+}
+
+/**
+ * @brief 自動操作プレイヤー初期化
+ * @param player_ptr 自動操作プレイヤー状態
+ * @param is_lookahead_enabled ネクストミノまで含めた2手読みの有効フラグ
+ * @return なし
+ */
+void TETRIS_CORE_ai_initialize_player(TETRIS_CORE_ai_player_t *player_ptr, bool is_lookahead_enabled)
+{
+    player_ptr->is_planned = false;
+    player_ptr->is_lookahead_enabled = is_lookahead_enabled;
+    player_ptr->was_turn_input = false;
+    player_ptr->was_shift_input = false;
+    player_ptr->target.is_found = false;
+}
+
+/**
+ * @brief 自動操作入力生成
+ * @param player_ptr 自動操作プレイヤー状態
+ * @param state_ptr ゲームコア演算状態
+ * @param weight_ptr 盤面評価重み
+ * @param input_ptr 入力格納先
+ * @return true：今回の呼び出しで配置探索を実行した（処理時間計測用）
+ * @details 操作ミノ毎に最初の呼び出しで配置探索を行い、以降は目標配置へ回転・左右移動し、揃ったら上入力でハードドロップさせる
+ *          回転・左右入力は押下直後の1ステップで1回分動くので、目標に着くまで1ステップおきに押し直す（DASは使わない）
+ */
+bool TETRIS_CORE_ai_decide_input(TETRIS_CORE_ai_player_t *player_ptr, const TETRIS_CORE_state_t *state_ptr, const TETRIS_CORE_ai_weight_t *weight_ptr, TETRIS_CORE_input_t *input_ptr)
+{
+    const TETRIS_CORE_mino_parameter_t *mino_ptr = &state_ptr->mino_parameter;
+
+    *input_ptr = (TETRIS_CORE_input_t){false};
+
+    // 操作ミノ無し（次ステップで新規生成）→ 入力無しで生成を待つ（下入力継続による高速落下禁止を避ける）
+    if (mino_ptr->is_next_mino_generate)
+    {
+        player_ptr->is_planned = false;
+        player_ptr->was_turn_input = false;
+        player_ptr->was_shift_input = false;
+        return false;
+    }
+
+    // 操作ミノ毎に1回だけ配置探索
+    bool is_searched = false;
+    if (!player_ptr->is_planned)
+    {
+        TETRIS_CORE_ai_search_placement(state_ptr, weight_ptr, player_ptr->is_lookahead_enabled, &player_ptr->target);
+        player_ptr->is_planned = true;
+        is_searched = true;
+    }
+
+    // 配置候補無し（どこに置いてもゲームオーバー）→ そのまま落とす
+    const TETRIS_CORE_ai_placement_t *target_ptr = &player_ptr->target;
+    if (!target_ptr->is_found)
+    {
+        input_ptr->is_input_D = true;
+        return is_searched;
+    }
+
+    // 回転：押下直後の1ステップのみ有効なので、連続で回転させる場合は1ステップ空ける
+    if (mino_ptr->turn_state != target_ptr->turn_state && !player_ptr->was_turn_input)
+    {
+        int8_t turn_direction = get_turn_direction(mino_ptr->turn_state, target_ptr->turn_state);
+        input_ptr->is_input_turnR = (0 < turn_direction);
+        input_ptr->is_input_turnL = (turn_direction < 0);
+    }
+    player_ptr->was_turn_input = input_ptr->is_input_turnR || input_ptr->is_input_turnL;
+
+    // 左右移動：押下直後に1マス移動するので、DASを待たずに1ステップおきに押し直す
+    if (!player_ptr->was_shift_input)
+    {
+        input_ptr->is_input_R = (mino_ptr->reference_x < target_ptr->reference_x);
+        input_ptr->is_input_L = (target_ptr->reference_x < mino_ptr->reference_x);
+    }
+    player_ptr->was_shift_input = input_ptr->is_input_R || input_ptr->is_input_L;
+
+    // 目標配置に揃ったらハードドロップ（ミノ生成待ちの間は入力無しなので、ミノ毎に上入力を押し直したことになる）
+    input_ptr->is_input_U = (mino_ptr->turn_state == target_ptr->turn_state) && (mino_ptr->reference_x == target_ptr->reference_x);
+
+    return is_searched;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief 到達可能配置の全列挙＆最良評価値探索
+ * @param field_ptr フィールド演算パラメータ
+ * @param mino_type 配置するミノ種別
+ * @param turn_state ミノの現在の回転状態
+ * @param reference_x ミノの現在の基準点（X軸）
+ * @param reference_y ミノの現在の基準点（Y軸）
+ * @param lines_before これまでの手で消去した行数
+ * @param weight_ptr 盤面評価重み
+ * @param next_mino_type_ptr 続けて配置するミノ種別（NULLの場合は1手で評価する）
+ * @param placement_ptr 最良配置の格納先（NULLの場合は評価値のみ返す）
+ * @return 最良評価値（到達可能な配置が無い場合はゲームオーバー評価値）
+ */
+static int32_t search_best_evaluation(const TETRIS_CORE_field_parameter_t *field_ptr, TETRIS_CORE_mino_type_t mino_type, TETRIS_CORE_mino_turn_state_t turn_state, int8_t reference_x, int8_t reference_y,
+                                      uint8_t lines_before, const TETRIS_CORE_ai_weight_t *weight_ptr, const TETRIS_CORE_mino_type_t *next_mino_type_ptr, TETRIS_CORE_ai_placement_t *placement_ptr)
+{
+    int32_t best_evaluation = EVALUATION_GAME_OVER;
+    uint32_t searched_shape[r_3_turn + 1];
+    uint8_t number_of_searched_shape = 0;
+
+    // 積まれているブロックの最上段より上は壁のみなので、落下判定はその直上から始めればよい
+    int8_t drop_start_y = get_top_block_row(field_ptr) - TETRIS_CORE_MINO_LENGTH;
+    if (drop_start_y < reference_y)
+        drop_start_y = reference_y;
+
+    for (TETRIS_CORE_mino_turn_state_t turn = r_no_turn; turn <= r_3_turn; turn++)
+    {
+        // 同一形状の回転状態（I,S,Z,Oミノ等）は1度だけ探索する
+        uint32_t mino_shape = TETRIS_CORE_get_mino_shape(mino_type, turn);
+        bool is_duplicated = false;
+        for (uint8_t i = 0; i < number_of_searched_shape; i++)
+        {
+            is_duplicated |= (searched_shape[i] == mino_shape);
+        }
+        if (is_duplicated || !check_turn_reachable(field_ptr, mino_type, turn_state, turn, reference_x, reference_y))
+            continue;
+        searched_shape[number_of_searched_shape++] = mino_shape;
+
+        // 左端→右端の順に、その場から左右移動で到達できる列を探索する
+        int8_t x_left = reference_x;
+        while (!tetris_core_check_collision(field_ptr, mino_shape, x_left - 1, reference_y))
+            x_left--;
+
+        for (int8_t x = x_left; !tetris_core_check_collision(field_ptr, mino_shape, x, reference_y); x++)
+        {
+            // 接地位置まで落として盤面を確定
+            int8_t y = drop_start_y;
+            while (!tetris_core_check_collision(field_ptr, mino_shape, x, y + 1))
+                y++;
+
+            TETRIS_CORE_field_parameter_t field_after = *field_ptr;
+            tetris_core_put_mino(&field_after, mino_shape, x, y);
+            uint8_t lines = lines_before;
+            if (check_row_filled(&field_after, y)) // 揃う行はミノを置いた行にしか無いので、先にその行だけ判定する
+                lines += tetris_core_erase_field_row(&field_after);
+
+            int32_t evaluation;
+            if (y < TETRIS_CORE_GAME_OVER_LINE && tetris_core_check_is_game_over(&field_after)) // 配置前の盤面はゲームオーバーライン内が空なので、ミノがかかった場合のみ判定する
+            {
+                evaluation = EVALUATION_GAME_OVER;
+            }
+            else if (next_mino_type_ptr) // 2手読み：ネクストミノを出現位置から探索
+            {
+                int8_t next_x = tetris_core_get_spawn_reference_x(*next_mino_type_ptr);
+                int8_t next_y = get_spawn_reference_y(&field_after, TETRIS_CORE_get_mino_shape(*next_mino_type_ptr, r_no_turn), next_x);
+                evaluation = search_best_evaluation(&field_after, *next_mino_type_ptr, r_no_turn, next_x, next_y, lines, weight_ptr, NULL, NULL);
+            }
+            else
+            {
+                evaluation = evaluate_field(&field_after, lines, weight_ptr);
+            }
+
+            if (best_evaluation < evaluation)
+            {
+                best_evaluation = evaluation;
+                if (placement_ptr)
+                {
+                    placement_ptr->reference_x = x;
+                    placement_ptr->turn_state = turn;
+                    placement_ptr->evaluation = evaluation;
+                    placement_ptr->is_found = true;
+                }
+            }
+        }
+    }
+
+    return best_evaluation;
+}
+
+/**
+ * @brief 回転到達可否判定
+ * @param field_ptr フィールド演算パラメータ
+ * @param mino_type ミノ種別
+ * @param turn_from 現在の回転状態
+ * @param turn_to 目標の回転状態
+ * @param reference_x ミノの基準点（X軸）
+ * @param reference_y ミノの基準点（Y軸）
+ * @return true：その場での回転で到達可能
+ * @details 回転入力と同じ向き（3回右回転は1回左回転）で1回ずつ回し、途中の回転状態も含めて衝突しないかを判定する
+ */
+static bool check_turn_reachable(const TETRIS_CORE_field_parameter_t *field_ptr, TETRIS_CORE_mino_type_t mino_type, TETRIS_CORE_mino_turn_state_t turn_from, TETRIS_CORE_mino_turn_state_t turn_to, int8_t reference_x, int8_t reference_y)
+{
+    int8_t turn_direction = get_turn_direction(turn_from, turn_to);
+    TETRIS_CORE_mino_turn_state_t turn = turn_from;
+
+    while (turn != turn_to)
+    {
+        turn = MATH_modulo(turn + turn_direction, r_3_turn + 1);
+        if (tetris_core_check_collision(field_ptr, TETRIS_CORE_get_mino_shape(mino_type, turn), reference_x, reference_y))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief ミノ出現位置算出
+ * @param field_ptr フィールド演算パラメータ
+ * @param mino_shape 5×5ミノ形状マスク
+ * @param reference_x 出現時の基準点（X軸）
+ * @return 出現直後の基準点（Y軸）
+ * @details ゲームコアのミノ生成と同じく、生成位置から初期位置まで1ブロックずつ下げた位置を返す
+ */
+static int8_t get_spawn_reference_y(const TETRIS_CORE_field_parameter_t *field_ptr, uint32_t mino_shape, int8_t reference_x)
+{
+    int8_t reference_y = TETRIS_CORE_MINO_Y_GENERATE;
+    while (reference_y < TETRIS_CORE_MINO_Y_INITIAL && !tetris_core_check_collision(field_ptr, mino_shape, reference_x, reference_y + 1))
+        reference_y++;
+
+    return reference_y;
+}
+
+/**
+ * @brief ブロック最上段取得
+ * @param field_ptr フィールド演算パラメータ
+ * @return ブロックが存在する最も上の行（ブロックが無い場合はフィールド高さ）
+ */
+static int8_t get_top_block_row(const TETRIS_CORE_field_parameter_t *field_ptr)
+{
+    int8_t y = 0;
+    while (y < TETRIS_CORE_FIELD_HEIGHT && !(field_ptr->row[y] & TETRIS_CORE_ROW_BLOCK_MASK))
+        y++;
+
+    return y;
+}
+
+/**
+ * @brief ミノ配置行の行揃い判定
+ * @param field_ptr フィールド演算パラメータ
+ * @param reference_y 配置したミノの基準点（Y軸）
+ * @return true：ミノ定義5行の範囲に揃った行がある
+ */
+static bool check_row_filled(const TETRIS_CORE_field_parameter_t *field_ptr, int8_t reference_y)
+{
+    for (int8_t y = reference_y; y < reference_y + TETRIS_CORE_MINO_LENGTH && y < TETRIS_CORE_FIELD_HEIGHT; y++)
+    {
+        if (0 <= y && (field_ptr->row[y] & TETRIS_CORE_ROW_BLOCK_MASK) == TETRIS_CORE_ROW_BLOCK_MASK)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief 盤面評価
+ * @param field_ptr フィールド演算パラメータ
+ * @param lines 消去行数
+ * @param weight_ptr 盤面評価重み
+ * @return 盤面評価値
+ * @details 上の行から順に「これまでにブロックがあった列」のマスク（covered）を積み上げ、列毎のループ無しで特徴量を求める
+ *            高さの合計：各行のcoveredのビット数の総和（列はその列の最上段から床まで数えられる）
+ *            穴の数    ：高さの合計 - ブロック数（coveredの内、ブロックで埋まっていないマス）
+ *            凹凸      ：隣接列でcoveredが一致しない行数の総和（= 隣接列の高さの差の合計）
+ */
+static int32_t evaluate_field(const TETRIS_CORE_field_parameter_t *field_ptr, uint8_t lines, const TETRIS_CORE_ai_weight_t *weight_ptr)
+{
+    uint16_t covered = 0;
+    int32_t aggregate_height = 0;
+    int32_t number_of_blocks = 0;
+    int32_t bumpiness = 0;
+
+    for (uint8_t y = get_top_block_row(field_ptr); y < TETRIS_CORE_FIELD_HEIGHT; y++)
+    {
+        uint16_t blocks = field_ptr->row[y] & TETRIS_CORE_ROW_BLOCK_MASK;
+        covered |= blocks;
+
+        aggregate_height += MATH_count_bits(covered);
+        number_of_blocks += MATH_count_bits(blocks);
+        bumpiness += MATH_count_bits((covered ^ (covered >> 1)) & ADJACENT_COLUMN_PAIR_MASK);
+    }
+
+    int32_t holes = aggregate_height - number_of_blocks;
+
+    return weight_ptr->lines * (int32_t)lines + weight_ptr->aggregate_height * aggregate_height + weight_ptr->holes * holes + weight_ptr->bumpiness * bumpiness;
+}
+
+/**
+ * @brief 回転方向算出
+ * @param turn_from 現在の回転状態
+ * @param turn_to 目標の回転状態
+ * @return 1：右回転、-1：左回転、0：回転不要
+ * @details 右に3回回す場合は左に1回回す
+ */
+static int8_t get_turn_direction(TETRIS_CORE_mino_turn_state_t turn_from, TETRIS_CORE_mino_turn_state_t turn_to)
+{
+    int turn_count = MATH_modulo((int)turn_to - (int)turn_from, r_3_turn + 1);
+
+    if (!turn_count)
+        return 0;
+
+    return (r_3_turn == turn_count) ? -1 : 1;
+}
@@ -0,0 +1,18 @@
+/**
+ * @file   tetris_core_ai_weight.h
+ * @brief  tetrisゲームコア・自動操作 盤面評価重み定義
+ * @details tools/tetris_tunerの出力で置き換える（-oオプション）。手動で調整する場合も同じ書式を保つこと
+ */
+
+#ifndef __TETRIS_CORE_AI_WEIGHT_H__
+#define __TETRIS_CORE_AI_WEIGHT_H__
+
+//======================================================
+// マクロ定義
+//======================================================
+#define TETRIS_CORE_AI_WEIGHT_LINES 760             // 消去行数の重み
+#define TETRIS_CORE_AI_WEIGHT_AGGREGATE_HEIGHT -510 // 各列の高さの合計の重み
+#define TETRIS_CORE_AI_WEIGHT_HOLES -360            // 穴の数の重み
+#define TETRIS_CORE_AI_WEIGHT_BUMPINESS -185        // 隣接列の高さの差の合計の重み
+
+#endif /* __TETRIS_CORE_AI_WEIGHT_H__ */
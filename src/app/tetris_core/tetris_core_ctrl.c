@@ -0,0 +1,342 @@
+/**
+ * @file   tetris_core_ctrl.c
+ * @brief  tetrisゲームコア・ステップ演算実装
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris_core.h"
+#include "tetris_core_internal.h"
+#include "typedef.h"
+#include "math_lib.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+// 消去行数に対するスコア倍率
+#define SCORE_POWER_RATE_1ROW 10
+#define SCORE_POWER_RATE_2ROW 13
+#define SCORE_POWER_RATE_3ROW 20
+#define SCORE_POWER_RATE_4ROW 30
+
+// ハードドロップの落下1行あたりのスコア（行消去の得点はtetris_core_score.c）
+#define SCORE_HARD_DROP_PER_ROW 2
+
+// 1マス落下に必要な下移動カウンタの積算量[1/256マス×us]
+#define FALL_AMOUNT_ONE_CELL ((uint64_t)TETRIS_CORE_GRAVITY_ONE_CELL * TETRIS_CORE_STEP_PERIOD_US)
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+// 難易度テーブルの既定値（実機のゲームはこのテーブルで動作する）
+const TETRIS_CORE_difficulty_t TETRIS_CORE_difficulty_default = {
+    .gravity = {0, 12, 17, 23, 32, 37, 51, 64, 85, 128, 256, 512, 768, 1280, 2560, 5120}, // 自由落下速度（レベル10で1G、レベル15で20G）
+    .score_power_rate = {0, SCORE_POWER_RATE_1ROW, SCORE_POWER_RATE_2ROW, SCORE_POWER_RATE_3ROW, SCORE_POWER_RATE_4ROW},
+    .next_level_need_row = {0, 3, 6, 9, 13, 17, 21, 28, 35, 45, 55, 65, 80, 95, 110},
+};
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static void generate_new_mino(TETRIS_CORE_state_t *state_ptr);
+static void hold_mino(TETRIS_CORE_state_t *state_ptr);
+static void place_new_mino(TETRIS_CORE_state_t *state_ptr, TETRIS_CORE_mino_type_t mino_type);
+static void move_mino_initial_position(TETRIS_CORE_state_t *state_ptr);
+static void turn_mino(TETRIS_CORE_state_t *state_ptr, const TETRIS_CORE_input_t *input_ptr);
+static bool hard_drop_mino(TETRIS_CORE_state_t *state_ptr, const TETRIS_CORE_input_t *input_ptr);
+static bool move_mino(TETRIS_CORE_state_t *state_ptr);
+static void lock_mino(TETRIS_CORE_state_t *state_ptr);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief ゲームコア 1ステップ演算
+ * @param state_ptr ゲームコア演算状態
+ * @param input_ptr 今回ステップの入力
+ * @return ステップ実行結果
+ * @details 1フレーム分の演算フロー全体を処理する
+ *          ミノ生成・ホールド・回転・移動・接地判定・行消去・ゲームパラメータ更新を実行し、ゲーム継続可否を返す
+ *          接地したミノは接地猶予（TETRIS_CORE_lock_delay_config_t）の経過後に固定する。ハードドロップしたミノはそのステップで固定する
+ *          前回ステップ以降（ステップ外のオートシフトを含む）に移動・回転・落下・固定のいずれも無ければcore_idleを返す
+ *          入力も落下も無いステップは各処理の入口の判定だけで抜けるので、ほぼ処理時間がかからない
+ */
+TETRIS_CORE_step_result_t TETRIS_CORE_step(TETRIS_CORE_state_t *state_ptr, const TETRIS_CORE_input_t *input_ptr)
+{
+    // ミノの生成と初期配置（ゲーム開始直後 or 前回ステップでミノが接地した場合に実行）
+    if (state_ptr->mino_parameter.is_next_mino_generate)
+    {
+        generate_new_mino(state_ptr);          // 描画範囲の直上に新ミノ生成
+        move_mino_initial_position(state_ptr); // 初期位置にミノをシフト
+        state_ptr->allow_down_shift = false;   // 下シフト禁止（直前の入力からの誤入力防止）
+        state_ptr->auto_shift.is_soft_dropping = false;
+        tetris_core_initialize_lock_delay(state_ptr);
+        tetris_core_start_piece_statistics(state_ptr);
+    }
+
+    // ホールド処理（ホールドから出したミノはこのステップから操作できる）
+    if (input_ptr->is_input_hold)
+        hold_mino(state_ptr);
+
+    // ミノ回転処理
+    turn_mino(state_ptr, input_ptr);
+
+    // 左右移動・高速落下（ステップ外から駆動していない場合はここでステップ周期分進める）
+    if (!state_ptr->auto_shift.is_external)
+        TETRIS_CORE_auto_shift(state_ptr, input_ptr, TETRIS_CORE_STEP_PERIOD_US);
+
+    // ハードドロップ処理
+    bool is_hard_dropped = hard_drop_mino(state_ptr, input_ptr);
+
+    // 自由落下処理＆下面接地判定
+    bool is_grounded = move_mino(state_ptr);
+
+    bool is_gameover = false;
+    if (is_hard_dropped || tetris_core_update_lock_delay(state_ptr, is_grounded))
+    {
+        // ハードドロップ or 接地猶予切れ → 固定してゲームオーバー判定＆得点処理
+        TETRIS_CORE_t_spin_t t_spin = tetris_core_check_t_spin(state_ptr);             // Tスピン判定（固定前の位置・直前の操作で判定）
+        lock_mino(state_ptr);                                                          // フィールドにミノを加え、操作ミノを消去する
+        uint8_t row_erased = tetris_core_erase_field_row(&state_ptr->field_parameter); // ブロック行消去判定
+        state_ptr->row_erased += row_erased;
+        tetris_core_update_play_statistics(state_ptr, row_erased, t_spin, is_hard_dropped);
+        tetris_core_update_game_parameter(state_ptr, t_spin); // スコア等更新処理
+        if (is_hard_dropped)
+            state_ptr->game_parameter.is_updated = true; // 行消去が無くてもハードドロップの加点をUIに反映させる
+        if (!row_erased)
+            tetris_core_apply_garbage(state_ptr); // 行消去が無ければ受け取り待ちのせり上がりを加える
+
+        is_gameover = tetris_core_check_is_game_over(&state_ptr->field_parameter); // ゲームオーバー判定
+    }
+
+    TETRIS_CORE_step_result_t result = (is_gameover) ? core_game_over : (state_ptr->is_changed) ? core_running : core_idle;
+    state_ptr->is_changed = false;
+    return result;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief 新規ミノ生成
+ * @param state_ptr ゲームコア演算状態
+ * @return なし
+ * @details ネクストミノ列の先頭からミノを生成し、列を1つ詰めて末尾に疑似乱数で次のミノを追加する
+ *          ネクストミノ列は乱数列の先読みなので、列の長さに関わらず同じシードなら同じミノ順になる
+ */
+static void generate_new_mino(TETRIS_CORE_state_t *state_ptr)
+{
+    TETRIS_CORE_mino_parameter_t *mino_ptr = &state_ptr->mino_parameter;
+    TETRIS_CORE_mino_type_t mino_type = mino_ptr->next_mino_queue[0];
+
+    // ネクストミノ列の更新
+    for (uint8_t i = 0; i < TETRIS_CORE_NEXT_QUEUE_LENGTH - 1; i++)
+    {
+        mino_ptr->next_mino_queue[i] = mino_ptr->next_mino_queue[i + 1];
+    }
+    mino_ptr->next_mino_queue[TETRIS_CORE_NEXT_QUEUE_LENGTH - 1] = tetris_core_get_random_mino_type(&state_ptr->random_state, state_ptr->piece_set);
+
+    place_new_mino(state_ptr, mino_type);
+    mino_ptr->is_hold_available = true; // 新しいミノ毎にホールドを1回許可
+}
+
+/**
+ * @brief ホールド処理
+ * @param state_ptr ゲームコア演算状態
+ * @return なし
+ * @details 操作ミノをホールドし、ホールド中のミノがあればそれを、無ければネクストミノを初期位置に生成する
+ *          ホールドから出したミノは再度ホールドできない（次のミノが生成されるまで）
+ */
+static void hold_mino(TETRIS_CORE_state_t *state_ptr)
+{
+    TETRIS_CORE_mino_parameter_t *mino_ptr = &state_ptr->mino_parameter;
+    if (mino_ptr->is_next_mino_generate || !mino_ptr->is_hold_available)
+        return;
+
+    TETRIS_CORE_mino_type_t current_mino_type = mino_ptr->mino_type;
+    if (mino_ptr->is_holding)
+        place_new_mino(state_ptr, mino_ptr->hold_mino_type);
+    else
+        generate_new_mino(state_ptr);
+    move_mino_initial_position(state_ptr);
+
+    mino_ptr->hold_mino_type = current_mino_type;
+    mino_ptr->is_holding = true;
+    mino_ptr->is_hold_available = false;
+    tetris_core_count_input(state_ptr, false);
+    tetris_core_start_piece_statistics(state_ptr); // ホールド入力は前のミノの入力として数える
+    state_ptr->move_counter.D = 0;
+    state_ptr->allow_down_shift = false; // 新規生成時と同様に下入力継続による高速落下を禁止
+    state_ptr->auto_shift.is_soft_dropping = false;
+    tetris_core_initialize_lock_delay(state_ptr);
+}
+
+/**
+ * @brief ミノ配置
+ * @param state_ptr ゲームコア演算状態
+ * @param mino_type 配置するミノ種別
+ * @return なし
+ * @details 指定種別のミノを生成位置（描画範囲直上の4行）に配置し、着地点までの距離を求める（初期位置への移動はmove_mino_initial_positionで行う）
+ */
+static void place_new_mino(TETRIS_CORE_state_t *state_ptr, TETRIS_CORE_mino_type_t mino_type)
+{
+    TETRIS_CORE_mino_parameter_t *mino_ptr = &state_ptr->mino_parameter;
+
+    mino_ptr->mino_type = mino_type;
+    mino_ptr->reference_x = tetris_core_get_spawn_reference_x(mino_type); // プレイフィールドの中央に寄せる
+    mino_ptr->reference_y = TETRIS_CORE_MINO_Y_GENERATE;
+    mino_ptr->turn_state = r_no_turn;
+    mino_ptr->is_next_mino_generate = false;
+    mino_ptr->is_last_move_turn = false;
+    mino_ptr->distance_to_landing = tetris_core_calculate_distance_to_landing(state_ptr);
+    state_ptr->is_changed = true;
+}
+
+/**
+ * @brief ミノ初期位置移動
+ * @param state_ptr ゲームコア演算状態
+ * @return なし
+ * @details ミノは新規生成直後は描画範囲の直上に位置しているため、初期位置（ゲームオーバーラインの中央真上）に移動する
+ *          既に積まれているブロックに移動を阻害される場合はその位置で止める（接地後にゲームオーバーになる）
+ */
+static void move_mino_initial_position(TETRIS_CORE_state_t *state_ptr)
+{
+    // Y方向に移動（接触の可能性があるので1つずつずらす）
+    uint8_t y_shift_counter = TETRIS_CORE_MINO_Y_INITIAL - TETRIS_CORE_MINO_Y_GENERATE;
+    while (y_shift_counter)
+    {
+        if (tetris_core_shift_mino(state_ptr, 0, 1))
+            break;
+
+        y_shift_counter--;
+    }
+}
+
+/**
+ * @brief ミノ回転処理
+ * @param state_ptr ゲームコア演算状態
+ * @param input_ptr 入力
+ * @return なし
+ * @details 入力に応じてミノを90°回転させる。回転後にフィールドと衝突しない場合のみ回転状態を反映する
+ *          接地中に回転できた場合は接地猶予を延長する。固定期限を過ぎた後は回転しない
+ */
+static void turn_mino(TETRIS_CORE_state_t *state_ptr, const TETRIS_CORE_input_t *input_ptr)
+{
+    // 回転数算出（正で右回転、負で左回転）
+    int turnR_value = (int)(input_ptr->is_input_turnR) - (int)(input_ptr->is_input_turnL);
+    if (!turnR_value || tetris_core_is_lock_expired(state_ptr)) // 回転無し or 固定待ち→処理せず即リターン
+        return;
+    tetris_core_count_input(state_ptr, false); // 回転できなくても入力として数える
+
+    // 回転後のミノとフィールドの衝突判定＝回転させられるか判定する
+    TETRIS_CORE_mino_parameter_t *mino_ptr = &state_ptr->mino_parameter;
+    TETRIS_CORE_mino_turn_state_t state_after_turned = MATH_modulo(mino_ptr->turn_state + turnR_value, r_3_turn + 1);
+    uint32_t turned_mino = TETRIS_CORE_get_mino_shape(mino_ptr->mino_type, state_after_turned);
+
+    // 衝突しない場合のみ回転状態を更新
+    if (!tetris_core_check_collision(&state_ptr->field_parameter, turned_mino, mino_ptr->reference_x, mino_ptr->reference_y))
+    {
+        mino_ptr->turn_state = state_after_turned;
+        mino_ptr->is_last_move_turn = true;
+        mino_ptr->distance_to_landing = tetris_core_calculate_distance_to_landing(state_ptr);
+        state_ptr->is_changed = true;
+        tetris_core_reset_lock_delay(state_ptr);
+    }
+}
+
+/**
+ * @brief ハードドロップ処理
+ * @param state_ptr ゲームコア演算状態
+ * @param input_ptr 入力
+ * @return true：ハードドロップした（このステップで固定する）
+ * @details 上入力を押した瞬間に、ミノを着地点までの距離だけ一度に落とし、落下した行数に応じてスコアを加算する
+ *          押しっぱなしで次のミノまで落とさないよう、一度上入力を離すまで次のハードドロップは受け付けない
+ *          固定期限を過ぎたミノは次のステップで固定されるので、ハードドロップ扱いにしない
+ */
+static bool hard_drop_mino(TETRIS_CORE_state_t *state_ptr, const TETRIS_CORE_input_t *input_ptr)
+{
+    TETRIS_CORE_mino_parameter_t *mino_ptr = &state_ptr->mino_parameter;
+    bool is_hard_drop = input_ptr->is_input_U && state_ptr->allow_hard_drop && !tetris_core_is_lock_expired(state_ptr);
+
+    state_ptr->allow_hard_drop = !input_ptr->is_input_U;
+    if (!is_hard_drop)
+        return false;
+    tetris_core_count_input(state_ptr, false);
+
+    if (mino_ptr->distance_to_landing) // 落下した場合は最後の操作が回転でなくなる（その場で固定ならTスピンを維持）
+        mino_ptr->is_last_move_turn = false;
+    mino_ptr->reference_y += mino_ptr->distance_to_landing;
+    tetris_core_add_score(state_ptr, SCORE_HARD_DROP_PER_ROW * mino_ptr->distance_to_landing);
+    mino_ptr->distance_to_landing = 0;
+    state_ptr->is_changed = true;
+
+    return true;
+}
+
+/**
+ * @brief ミノ落下処理
+ * @param state_ptr ゲームコア演算状態
+ * @return true：接地している（1つ下に移動できない）
+ * @details 自由落下と接地判定を行う。左右移動・高速落下そのものはオートシフト（TETRIS_CORE_auto_shift）で行う
+ *          自由落下は前回からのゲーム経過時間×レベル毎の落下速度を下移動カウンタに加え、整数マス分をまとめて落下させる（端数は持ち越す）
+ *          ステップ数ではなく経過時間で進めるので、処理落ちでステップが間引かれても落下速度は変わらない（次のステップでまとめて落ちる）
+ *          ステップ内でオートシフトを進める場合は毎ステップ1ステップ周期分となり、従来のステップ毎の加算と同じ結果になる
+ *          落下量は移動・回転の度に更新されている着地点までの距離で頭打ちにするので、1ステップで何マス落ちても衝突判定が不要（20Gでも処理時間一定）
+ *          高速落下中も自由落下は止めない（落下速度の方が速い高レベルで高速落下が遅くならないようにするため）
+ *          着地点までの距離0が接地（固定するかどうかは接地猶予で判定する）
+ */
+static bool move_mino(TETRIS_CORE_state_t *state_ptr)
+{
+    TETRIS_CORE_move_counter_t *counter_ptr = &state_ptr->move_counter;
+    TETRIS_CORE_mino_parameter_t *mino_ptr = &state_ptr->mino_parameter;
+    uint8_t distance_to_landing = mino_ptr->distance_to_landing;
+
+    // カウンターのインクリメント（前回からの経過時間分）
+    uint64_t elapsed_us = state_ptr->time_us - counter_ptr->fall_time_us;
+    uint64_t fall_amount = counter_ptr->D + (uint64_t)state_ptr->difficulty_ptr->gravity[state_ptr->game_parameter.level] * elapsed_us;
+    counter_ptr->fall_time_us = state_ptr->time_us;
+
+    // カウンターに応じた下移動処理（着地点より下には落とさない）
+    uint8_t fall_cells;
+    if (distance_to_landing < fall_amount / FALL_AMOUNT_ONE_CELL)
+    {
+        fall_cells = distance_to_landing;
+        counter_ptr->D = 0; // 接地したら端数は捨てる
+    }
+    else
+    {
+        fall_cells = (uint8_t)(fall_amount / FALL_AMOUNT_ONE_CELL);
+        counter_ptr->D = (uint32_t)(fall_amount % FALL_AMOUNT_ONE_CELL);
+    }
+    if (!fall_cells) // 落下無し（低レベルではほとんどのステップ）
+        return (0 == distance_to_landing);
+
+    mino_ptr->reference_y += (int8_t)fall_cells;
+    mino_ptr->distance_to_landing = distance_to_landing - fall_cells;
+    mino_ptr->is_last_move_turn = false;
+    state_ptr->is_changed = true;
+
+    return (0 == mino_ptr->distance_to_landing);
+}
+
+/**
+ * @brief ミノ接地処理
+ * @param state_ptr ゲームコア演算状態
+ * @return なし
+ * @details 操作ミノをフィールドに書き込み、次ステップでのミノ再生成を予約する
+ *          再生成までの間は操作ミノ無しの扱いとなる
+ */
+static void lock_mino(TETRIS_CORE_state_t *state_ptr)
+{
+    TETRIS_CORE_mino_parameter_t *mino_ptr = &state_ptr->mino_parameter;
+    uint32_t mino_shape = TETRIS_CORE_get_mino_shape(mino_ptr->mino_type, mino_ptr->turn_state);
+
+    tetris_core_put_mino(&state_ptr->field_parameter, mino_shape, mino_ptr->reference_x, mino_ptr->reference_y);
+    mino_ptr->is_next_mino_generate = true;
+    state_ptr->is_changed = true;
+}
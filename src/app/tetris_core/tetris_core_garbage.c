@@ -0,0 +1,158 @@
+/**
+ * @file   tetris_core_garbage.c
+ * @brief  tetrisゲームコア・せり上がり（対戦用お邪魔ブロック）実装
+ * @details 行消去に応じて相手に送る行数（攻撃）を求め、相手から受け取った行数を次の固定時にフィールド下端から加える
+ *          送る前に自分の受け取り待ち行数と相殺する。対戦相手との受け渡しは呼び出し側で行う（ゲームコアは1盤面分の状態のみ持つ）
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris_core.h"
+#include "tetris_core_internal.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define GARBAGE_APPLY_MAX 8           // 1回の固定で加えるせり上がり行数の上限（残りは次の固定に持ち越す）
+#define GARBAGE_RANDOM_SALT 0x9E3779B9 // 穴の位置用の疑似乱数をミノ順と独立させるためのシード加工値
+#define GARBAGE_COMBO_TABLE_LENGTH 12  // コンボによる攻撃の加算表の長さ（以降は最後の値）
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+// 消去行数毎の攻撃行数
+static const uint8_t attack_by_row[TETRIS_CORE_ERASE_ROW_MAX + 1] = {0, 0, 1, 2, 4};
+
+// Tスピン種別・消去行数毎の攻撃行数（Tスピンで消去した場合は消去行数毎の攻撃行数の代わりに使う）
+static const uint8_t attack_by_t_spin[t_spin_full + 1][TETRIS_CORE_ERASE_ROW_MAX + 1] = {
+    {0, 0, 0, 0, 0}, // Tスピン無し（未使用）
+    {0, 0, 1, 2, 2}, // Tスピンミニ
+    {0, 2, 4, 6, 6}, // Tスピン
+};
+
+// コンボ数（2連続目を1とする）毎の攻撃の加算行数
+static const uint8_t attack_by_combo[GARBAGE_COMBO_TABLE_LENGTH] = {0, 1, 1, 2, 2, 3, 3, 4, 4, 4, 5, 5};
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief せり上がり受け取り
+ * @param state_ptr ゲームコア演算状態
+ * @param rows 相手から送られた行数
+ * @return なし
+ * @details 受け取り待ちに積むだけで、フィールドには次に行消去無しで固定した時に加える（TETRIS_CORE_GARBAGE_PENDING_MAXで頭打ち）
+ */
+void TETRIS_CORE_receive_garbage(TETRIS_CORE_state_t *state_ptr, uint8_t rows)
+{
+    TETRIS_CORE_garbage_t *garbage_ptr = &state_ptr->garbage;
+
+    garbage_ptr->pending = (TETRIS_CORE_GARBAGE_PENDING_MAX - garbage_ptr->pending < rows) ? TETRIS_CORE_GARBAGE_PENDING_MAX : garbage_ptr->pending + rows;
+    state_ptr->is_changed = true; // 受け取り待ち行数の表示更新
+}
+
+/**
+ * @brief 送信せり上がり取り出し
+ * @param state_ptr ゲームコア演算状態
+ * @return 相手に送る行数（前回の取り出し以降の合計）
+ * @details 取り出した分は0に戻す。対戦しない場合は呼ばなくてよい（送信待ちが溜まるだけ）
+ */
+uint8_t TETRIS_CORE_take_outgoing_garbage(TETRIS_CORE_state_t *state_ptr)
+{
+    uint8_t rows = state_ptr->garbage.outgoing;
+    state_ptr->garbage.outgoing = 0;
+
+    return rows;
+}
+
+/**
+ * @brief せり上がり状態初期化
+ * @param state_ptr ゲームコア演算状態
+ * @param seed 疑似乱数シード
+ * @return なし
+ */
+void tetris_core_initialize_garbage(TETRIS_CORE_state_t *state_ptr, uint32_t seed)
+{
+    TETRIS_CORE_garbage_t *garbage_ptr = &state_ptr->garbage;
+
+    garbage_ptr->pending = 0;
+    garbage_ptr->outgoing = 0;
+    garbage_ptr->random_state = (seed ^ GARBAGE_RANDOM_SALT) ? (seed ^ GARBAGE_RANDOM_SALT) : GARBAGE_RANDOM_SALT;
+}
+
+/**
+ * @brief せり上がり送信
+ * @param state_ptr ゲームコア演算状態
+ * @param row_erased 消去行数（1以上）
+ * @param t_spin Tスピン種別
+ * @param is_back_to_back_bonus Back to Backが成立したか
+ * @return なし
+ * @details 消去行数・Tスピン・Back to Back（+1行）・コンボから攻撃行数を求め、受け取り待ちと相殺した残りを送信待ちに積む
+ */
+void tetris_core_send_garbage(TETRIS_CORE_state_t *state_ptr, uint8_t row_erased, TETRIS_CORE_t_spin_t t_spin, bool is_back_to_back_bonus)
+{
+    TETRIS_CORE_garbage_t *garbage_ptr = &state_ptr->garbage;
+    uint8_t combo_index = state_ptr->game_parameter.combo - 1;
+    uint8_t row_index = (TETRIS_CORE_ERASE_ROW_MAX < row_erased) ? TETRIS_CORE_ERASE_ROW_MAX : row_erased; // ペントミノの5行消去は4行消去と同じ攻撃
+
+    uint8_t attack = (t_spin_none != t_spin) ? attack_by_t_spin[t_spin][row_index] : attack_by_row[row_index];
+    attack += (is_back_to_back_bonus) ? 1 : 0;
+    attack += attack_by_combo[(combo_index < GARBAGE_COMBO_TABLE_LENGTH) ? combo_index : GARBAGE_COMBO_TABLE_LENGTH - 1];
+
+    // 受け取り待ちと相殺
+    uint8_t offset = (attack < garbage_ptr->pending) ? attack : garbage_ptr->pending;
+    garbage_ptr->pending -= offset;
+    attack -= offset;
+
+    garbage_ptr->outgoing = (UINT8_MAX - garbage_ptr->outgoing < attack) ? UINT8_MAX : garbage_ptr->outgoing + attack;
+    if (offset)
+        state_ptr->is_changed = true; // 受け取り待ち行数の表示更新
+}
+
+/**
+ * @brief せり上がり適用
+ * @param state_ptr ゲームコア演算状態
+ * @return なし
+ * @details 行消去無しでミノを固定した後に呼び、受け取り待ちの行をフィールド下端から加える（上端からはみ出た行は捨てる）
+ *          1回に加えた行は全て同じ列に穴を空ける。操作ミノ無しの状態で呼ぶこと（操作ミノとの重なりを考慮しない）
+ */
+void tetris_core_apply_garbage(TETRIS_CORE_state_t *state_ptr)
+{
+    TETRIS_CORE_garbage_t *garbage_ptr = &state_ptr->garbage;
+    uint16_t *row = state_ptr->field_parameter.row;
+    if (!garbage_ptr->pending)
+        return;
+
+    uint8_t rows = (garbage_ptr->pending < GARBAGE_APPLY_MAX) ? garbage_ptr->pending : GARBAGE_APPLY_MAX;
+    garbage_ptr->pending -= rows;
+
+    // 既存の行を押し上げる
+    for (uint8_t y = 0; y < TETRIS_CORE_FIELD_HEIGHT - rows; y++)
+    {
+        row[y] = row[y + rows];
+    }
+
+    // 穴を1つ空けたブロック行を下端に加える（穴の列は1～フィールド幅、bit15が列0）
+    uint8_t hole_column = 1 + tetris_core_get_random_value(&garbage_ptr->random_state) % TETRIS_CORE_FIELD_WIDTH;
+    uint16_t garbage_row = TETRIS_CORE_ROW_WALL_MASK | (TETRIS_CORE_ROW_BLOCK_MASK & ~(uint16_t)(0x8000 >> hole_column));
+    for (uint8_t y = TETRIS_CORE_FIELD_HEIGHT - rows; y < TETRIS_CORE_FIELD_HEIGHT; y++)
+    {
+        row[y] = garbage_row;
+    }
+
+    state_ptr->is_changed = true;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
@@ -0,0 +1,106 @@
+/**
+ * @file   tetris_core_init.c
+ * @brief  tetrisゲームコア・初期化実装
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris_core.h"
+#include "tetris_core_internal.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define RANDOM_SEED_DEFAULT 0x2545F491 // シード0指定時の代替値（xorshiftは状態0から抜けられないため）
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief ゲームコア演算状態初期化
+ * @param state_ptr ゲームコア演算状態格納先
+ * @param seed 疑似乱数シード
+ * @return なし
+ * @details 各種演算用パラメータをゲーム開始時の初期値へ設定する
+ *          シードはミノ順の決定にのみ使われる。同じシードを与えれば同じゲームを再現できる
+ */
+void TETRIS_CORE_initialize(TETRIS_CORE_state_t *state_ptr, uint32_t seed)
+{
+    // 疑似乱数初期化
+    state_ptr->random_state = (seed) ? seed : RANDOM_SEED_DEFAULT;
+
+    // 難易度テーブル初期化（別のテーブルを使う場合は初期化後に差し替える）
+    state_ptr->difficulty_ptr = &TETRIS_CORE_difficulty_default;
+
+    // ミノパラメータ初期化（ネクスト・ホールド以外はミノ生成時に初期化されるので不要。別のピースセットを使う場合は初期化後にTETRIS_CORE_select_piece_setで選択する）
+    state_ptr->piece_set = piece_set_tetromino;
+    for (uint8_t i = 0; i < TETRIS_CORE_NEXT_QUEUE_LENGTH; i++)
+    {
+        state_ptr->mino_parameter.next_mino_queue[i] = tetris_core_get_random_mino_type(&state_ptr->random_state, piece_set_tetromino);
+    }
+    state_ptr->mino_parameter.hold_mino_type = mino_I;
+    state_ptr->mino_parameter.is_holding = false;
+    state_ptr->mino_parameter.is_hold_available = true;
+    state_ptr->mino_parameter.is_next_mino_generate = true;
+    state_ptr->mino_parameter.distance_to_landing = 0;
+
+    // フィールドパラメータ初期化（壁のみの状態）
+    for (uint8_t y = 0; y < TETRIS_CORE_FIELD_HEIGHT; y++)
+    {
+        state_ptr->field_parameter.row[y] = TETRIS_CORE_ROW_WALL_MASK;
+    }
+
+    // ゲームパラメータ初期化
+    state_ptr->game_parameter.level = 1;
+    state_ptr->game_parameter.row_deleted = 0;
+    state_ptr->game_parameter.score = 0;
+    state_ptr->game_parameter.combo = 0;
+    state_ptr->game_parameter.is_back_to_back = false;
+    state_ptr->game_parameter.latest_t_spin = t_spin_none;
+    state_ptr->game_parameter.is_updated = true; // UIを表示させる必要があるためtrue
+
+    // 内部演算用パラメータ初期化
+    state_ptr->move_counter.D = 0;
+    state_ptr->move_counter.fall_time_us = 0;
+    state_ptr->row_erased = 0;
+    state_ptr->allow_down_shift = false;
+    state_ptr->allow_hard_drop = false;
+
+    // オートシフト初期化（ステップ外から駆動する場合は初期化後にis_externalをtrueにする）
+    state_ptr->auto_shift.direction = 0;
+    state_ptr->auto_shift.shift_timer_us = 0;
+    state_ptr->auto_shift.is_soft_dropping = false;
+    state_ptr->auto_shift.drop_timer_us = 0;
+    state_ptr->auto_shift.is_external = false;
+    state_ptr->auto_shift_config_ptr = &TETRIS_CORE_auto_shift_config_default;
+
+    // 接地猶予初期化（ミノ毎の状態はミノ生成時に初期化される）
+    state_ptr->time_us = 0;
+    state_ptr->lock_delay_config_ptr = &TETRIS_CORE_lock_delay_config_default;
+    tetris_core_initialize_lock_delay(state_ptr);
+    state_ptr->lock_statistics = (TETRIS_CORE_lock_statistics_t){0};
+    tetris_core_initialize_play_statistics(state_ptr);
+
+    // せり上がり初期化
+    tetris_core_initialize_garbage(state_ptr, seed);
+
+    state_ptr->is_changed = true; // 初回ステップで画面全体を表示させる必要があるためtrue
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
@@ -0,0 +1,87 @@
+/**
+ * @file   tetris_core_internal.h
+ * @brief  tetrisゲームコア・内部公開定義
+ */
+
+#ifndef __TETRIS_CORE_INTERNAL_H__
+#define __TETRIS_CORE_INTERNAL_H__
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris_core.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+// ミノの初期位置定義（生成位置：描画範囲直上の4行、初期位置：そこから1ブロックずつ下げた位置。いずれも描画範囲の先頭行が基準）
+// X軸はミノ種別毎にプレイフィールドの中央に寄せる（tetris_core_get_spawn_reference_x）
+#define TETRIS_CORE_SPAWN_ROWS 4
+#define TETRIS_CORE_MINO_Y_GENERATE (TETRIS_CORE_FIELD_VISIBLE_TOP - TETRIS_CORE_SPAWN_ROWS)
+#define TETRIS_CORE_MINO_Y_INITIAL (TETRIS_CORE_FIELD_VISIBLE_TOP + 1)
+
+// 行消去判定の対象範囲（この行より下が対象）
+#define TETRIS_CORE_ERASE_ROW_TOP (TETRIS_CORE_FIELD_VISIBLE_TOP + 1)
+
+// ゲームオーバーライン（この行より上にブロックが接地したらゲームオーバー）
+#define TETRIS_CORE_GAME_OVER_LINE (TETRIS_CORE_FIELD_VISIBLE_TOP + TETRIS_CORE_SPAWN_ROWS)
+
+//======================================================
+// 型定義
+//======================================================
+/**
+ * @brief ミノ衝突判定定義
+ */
+typedef enum
+{
+    not_collided = 0, /**< 衝突無し */
+    collided,         /**< 衝突有り */
+} tetris_core_is_collide_t;
+
+//======================================================
+// グローバル変数・定数extern宣言
+//======================================================
+
+//======================================================
+// グローバル関数extern宣言
+//======================================================
+/* ctrl, ai → ops */
+extern tetris_core_is_collide_t tetris_core_check_collision(const TETRIS_CORE_field_parameter_t *field_ptr, uint32_t mino_shape, int8_t reference_x, int8_t reference_y);
+extern tetris_core_is_collide_t tetris_core_shift_mino(TETRIS_CORE_state_t *state_ptr, int8_t shift_x_level, int8_t shift_y_level);
+extern void tetris_core_put_mino(TETRIS_CORE_field_parameter_t *field_ptr, uint32_t mino_shape, int8_t reference_x, int8_t reference_y);
+extern uint8_t tetris_core_calculate_distance_to_landing(const TETRIS_CORE_state_t *state_ptr);
+extern uint8_t tetris_core_erase_field_row(TETRIS_CORE_field_parameter_t *field_ptr);
+extern bool tetris_core_check_is_game_over(const TETRIS_CORE_field_parameter_t *field_ptr);
+extern uint32_t tetris_core_get_random_value(uint32_t *random_state_ptr);
+
+/* init, ctrl, ai, stats, serialize → piece */
+extern int8_t tetris_core_get_spawn_reference_x(TETRIS_CORE_mino_type_t mino_type);
+extern TETRIS_CORE_mino_type_t tetris_core_get_random_mino_type(uint32_t *random_state_ptr, TETRIS_CORE_piece_set_t piece_set);
+extern bool tetris_core_is_mino_in_piece_set(uint8_t mino_type, TETRIS_CORE_piece_set_t piece_set);
+
+/* ctrl, shift → lock */
+extern void tetris_core_initialize_lock_delay(TETRIS_CORE_state_t *state_ptr);
+extern bool tetris_core_update_lock_delay(TETRIS_CORE_state_t *state_ptr, bool is_grounded);
+extern void tetris_core_reset_lock_delay(TETRIS_CORE_state_t *state_ptr);
+extern bool tetris_core_is_lock_expired(const TETRIS_CORE_state_t *state_ptr);
+
+/* serialize → lock */
+extern uint32_t tetris_core_get_elapsed_time(uint64_t time_us, uint64_t since_us);
+
+/* ctrl → score */
+extern TETRIS_CORE_t_spin_t tetris_core_check_t_spin(const TETRIS_CORE_state_t *state_ptr);
+extern void tetris_core_update_game_parameter(TETRIS_CORE_state_t *state_ptr, TETRIS_CORE_t_spin_t t_spin);
+extern void tetris_core_add_score(TETRIS_CORE_state_t *state_ptr, uint32_t points);
+
+/* init, ctrl, shift, serialize → stats */
+extern void tetris_core_initialize_play_statistics(TETRIS_CORE_state_t *state_ptr);
+extern void tetris_core_start_piece_statistics(TETRIS_CORE_state_t *state_ptr);
+extern void tetris_core_count_input(TETRIS_CORE_state_t *state_ptr, bool is_finesse_exempt);
+extern void tetris_core_update_play_statistics(TETRIS_CORE_state_t *state_ptr, uint8_t row_erased, TETRIS_CORE_t_spin_t t_spin, bool is_hard_dropped);
+
+/* init, ctrl, score → garbage */
+extern void tetris_core_initialize_garbage(TETRIS_CORE_state_t *state_ptr, uint32_t seed);
+extern void tetris_core_send_garbage(TETRIS_CORE_state_t *state_ptr, uint8_t row_erased, TETRIS_CORE_t_spin_t t_spin, bool is_back_to_back_bonus);
+extern void tetris_core_apply_garbage(TETRIS_CORE_state_t *state_ptr);
+
+#endif /* __TETRIS_CORE_INTERNAL_H__ */
@@ -0,0 +1,153 @@
+/**
+ * @file   tetris_core_lock.c
+ * @brief  tetrisゲームコア・接地猶予（ロックディレイ）実装
+ * @details 接地してから固定するまでの猶予をゲームコアの経過時間[us]で管理する
+ *          固定期限は最初の接地時刻（移動・回転・再接地による延長時はその時刻）からの絶対時刻で判定するため、
+ *          ステップの実行が遅れても猶予が伸び縮みしない。期限を過ぎた後の移動・回転は受け付けない
+ *          接地が外れてから再度接地した場合も延長1回として数えるので、段差の乗り降りで延長回数の上限を超えて猶予を伸ばすことはできない
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris_core.h"
+#include "tetris_core_internal.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+// 接地猶予設定の既定値
+const TETRIS_CORE_lock_delay_config_t TETRIS_CORE_lock_delay_config_default = {
+    .lock_delay_us = 500000,
+    .reset_limit = 15,
+};
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief 接地猶予状態初期化
+ * @param state_ptr ゲームコア演算状態
+ * @return なし
+ * @details ミノ生成毎（ホールドからの生成を含む）に呼ぶ。延長回数はミノ毎に数える
+ */
+void tetris_core_initialize_lock_delay(TETRIS_CORE_state_t *state_ptr)
+{
+    TETRIS_CORE_lock_delay_t *lock_ptr = &state_ptr->lock_delay;
+
+    lock_ptr->is_grounded = false;
+    lock_ptr->has_grounded = false;
+    lock_ptr->grounded_time_us = 0;
+    lock_ptr->lock_start_time_us = 0;
+    lock_ptr->reset_count = 0;
+}
+
+/**
+ * @brief 接地猶予更新
+ * @param state_ptr ゲームコア演算状態
+ * @param is_grounded 操作ミノが接地しているか（1つ下に移動できないか）
+ * @return true：固定期限を過ぎたので固定する
+ * @details ミノが最初に接地した時刻から猶予時間の計測を始める。接地が外れている間は固定しない
+ *          再度接地した場合は延長1回として数え、延長回数の上限までは再接地した時刻から計測し直す（上限後は元の期限のまま）
+ *          固定する場合は固定タイミングの統計を更新する
+ */
+bool tetris_core_update_lock_delay(TETRIS_CORE_state_t *state_ptr, bool is_grounded)
+{
+    TETRIS_CORE_lock_delay_t *lock_ptr = &state_ptr->lock_delay;
+
+    if (!is_grounded)
+    {
+        lock_ptr->is_grounded = false;
+        return false;
+    }
+
+    if (!lock_ptr->is_grounded) // 接地した瞬間
+    {
+        lock_ptr->is_grounded = true;
+        if (!lock_ptr->has_grounded) // ミノの最初の接地（接地時刻は統計用）
+        {
+            lock_ptr->has_grounded = true;
+            lock_ptr->grounded_time_us = state_ptr->time_us;
+            lock_ptr->lock_start_time_us = state_ptr->time_us;
+        }
+        else // 再接地：延長として数える
+        {
+            tetris_core_reset_lock_delay(state_ptr);
+        }
+    }
+
+    if (!tetris_core_is_lock_expired(state_ptr))
+        return false;
+
+    // 固定タイミング統計（期限からの遅れ＝ステップ周期・処理遅延による固定の遅れ）
+    TETRIS_CORE_lock_statistics_t *statistics_ptr = &state_ptr->lock_statistics;
+    uint32_t late_us = tetris_core_get_elapsed_time(state_ptr->time_us, lock_ptr->lock_start_time_us) - state_ptr->lock_delay_config_ptr->lock_delay_us;
+    statistics_ptr->lock_count++;
+    statistics_ptr->latest_grounded_us = tetris_core_get_elapsed_time(state_ptr->time_us, lock_ptr->grounded_time_us);
+    statistics_ptr->latest_reset_count = lock_ptr->reset_count;
+    statistics_ptr->latest_late_us = late_us;
+    statistics_ptr->max_late_us = (statistics_ptr->max_late_us < late_us) ? late_us : statistics_ptr->max_late_us;
+
+    return true;
+}
+
+/**
+ * @brief 接地猶予延長
+ * @param state_ptr ゲームコア演算状態
+ * @return なし
+ * @details 接地中に移動・回転できた場合と、再接地した場合に呼ぶ。延長回数の上限までは猶予時間を計り直す（上限後は何もしない）
+ *          期限切れ後は移動・回転自体を受け付けないので、ここで期限を過ぎた猶予が復活することは無い
+ */
+void tetris_core_reset_lock_delay(TETRIS_CORE_state_t *state_ptr)
+{
+    TETRIS_CORE_lock_delay_t *lock_ptr = &state_ptr->lock_delay;
+
+    if (!lock_ptr->is_grounded || state_ptr->lock_delay_config_ptr->reset_limit <= lock_ptr->reset_count)
+        return;
+
+    lock_ptr->lock_start_time_us = state_ptr->time_us;
+    lock_ptr->reset_count++;
+}
+
+/**
+ * @brief 固定期限切れ判定
+ * @param state_ptr ゲームコア演算状態
+ * @return true：接地中かつ固定期限を過ぎている（次のステップで固定される）
+ */
+bool tetris_core_is_lock_expired(const TETRIS_CORE_state_t *state_ptr)
+{
+    const TETRIS_CORE_lock_delay_t *lock_ptr = &state_ptr->lock_delay;
+
+    return lock_ptr->is_grounded && state_ptr->lock_delay_config_ptr->lock_delay_us <= tetris_core_get_elapsed_time(state_ptr->time_us, lock_ptr->lock_start_time_us);
+}
+
+/**
+ * @brief 経過時間算出
+ * @param time_us 現在時刻[us]
+ * @param since_us 基準時刻[us]
+ * @return 経過時間[us]（32bitに収まらない場合は上限値）
+ * @details 接地猶予の判定と、シリアライズ時の時刻の差の格納で共用する
+ */
+uint32_t tetris_core_get_elapsed_time(uint64_t time_us, uint64_t since_us)
+{
+    uint64_t elapsed_us = time_us - since_us;
+
+    return (UINT32_MAX < elapsed_us) ? UINT32_MAX : (uint32_t)elapsed_us;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
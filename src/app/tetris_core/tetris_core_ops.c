@@ -0,0 +1,245 @@
+/**
+ * @file   tetris_core_ops.c
+ * @brief  tetrisゲームコア・ミノ/フィールド操作実装
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris_core.h"
+#include "tetris_core_internal.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define LANDING_DISTANCE_MAX 127 // 落下距離算出の上限（バグによる無限ループ防止）
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief ミノ行マスク取得
+ * @param mino_shape 5×5ミノ形状マスク
+ * @param mino_row ミノ定義内の行（0～4）
+ * @param reference_x ミノの基準点（X軸）
+ * @return フィールド行ビット配置に合わせたミノ1行分のマスク
+ * @details 戻り値のbit15～0はフィールド行ビットマスクと同じ配置となる
+ *          bit16以上はフィールド左外にはみ出したブロックを表すため、衝突判定では壁として扱う
+ *          ミノ定義1行を上位16bitに置いてから右シフトするので、右壁より右に出たミノ定義の空白列は切り捨てられる（シフト量は常に正）
+ */
+uint32_t TETRIS_CORE_get_mino_row_mask(uint32_t mino_shape, uint8_t mino_row, int8_t reference_x)
+{
+    uint32_t mino_row_bits = (mino_shape >> (TETRIS_CORE_MINO_LENGTH * (TETRIS_CORE_MINO_LENGTH - 1 - mino_row))) & TETRIS_CORE_MINO_ROW_MASK;
+
+    return (mino_row_bits << 16) >> (reference_x + TETRIS_CORE_MINO_LENGTH);
+}
+
+/**
+ * @brief ミノ衝突判定
+ * @param field_ptr フィールド演算パラメータ
+ * @param mino_shape 5×5ミノ形状マスク
+ * @param reference_x ミノの基準点（X軸）
+ * @param reference_y ミノの基準点（Y軸）
+ * @return 衝突判定結果
+ * @details ミノの各行とフィールドの対応する行のANDを取るだけで判定する。床より下は全て衝突扱い
+ */
+tetris_core_is_collide_t tetris_core_check_collision(const TETRIS_CORE_field_parameter_t *field_ptr, uint32_t mino_shape, int8_t reference_x, int8_t reference_y)
+{
+    for (uint8_t mino_row = 0; mino_row < TETRIS_CORE_MINO_LENGTH; mino_row++)
+    {
+        uint32_t row_mask = TETRIS_CORE_get_mino_row_mask(mino_shape, mino_row, reference_x);
+        if (!row_mask) // ブロックの無い行は判定不要
+            continue;
+
+        int8_t field_y = reference_y + mino_row;
+        if (TETRIS_CORE_FIELD_HEIGHT <= field_y) // 床に衝突
+            return collided;
+
+        uint32_t field_row = (field_y < 0) ? TETRIS_CORE_ROW_WALL_MASK : field_ptr->row[field_y]; // フィールド上端より上は壁のみ
+        if (row_mask & (0xFFFF0000 | field_row))
+            return collided;
+    }
+
+    return not_collided;
+}
+
+/**
+ * @brief ミノシフト処理
+ * @param state_ptr ゲームコア演算状態
+ * @param shift_x_level X方向シフト量
+ * @param shift_y_level Y方向シフト量
+ * @return シフト時衝突判定結果
+ * @details 衝突時は状態更新を行わない
+ *          着地点までの距離は常に現在位置に対する値を保つ（左右移動時は算出し直し、下移動時は移動量を引く）
+ */
+tetris_core_is_collide_t tetris_core_shift_mino(TETRIS_CORE_state_t *state_ptr, int8_t shift_x_level, int8_t shift_y_level)
+{
+    TETRIS_CORE_mino_parameter_t *mino_ptr = &state_ptr->mino_parameter;
+    uint32_t mino_shape = TETRIS_CORE_get_mino_shape(mino_ptr->mino_type, mino_ptr->turn_state);
+
+    if (tetris_core_check_collision(&state_ptr->field_parameter, mino_shape, mino_ptr->reference_x + shift_x_level, mino_ptr->reference_y + shift_y_level))
+    {
+        return collided;
+    }
+
+    mino_ptr->reference_x += shift_x_level;
+    mino_ptr->reference_y += shift_y_level;
+    mino_ptr->is_last_move_turn = false;
+    state_ptr->is_changed = true;
+    if (shift_x_level)
+        mino_ptr->distance_to_landing = tetris_core_calculate_distance_to_landing(state_ptr);
+    else
+        mino_ptr->distance_to_landing -= shift_y_level;
+    return not_collided;
+}
+
+/**
+ * @brief ミノのフィールド書き込み
+ * @param field_ptr フィールド演算パラメータ
+ * @param mino_shape 5×5ミノ形状マスク
+ * @param reference_x ミノの基準点（X軸）
+ * @param reference_y ミノの基準点（Y軸）
+ * @return なし
+ * @note 衝突しない位置であることは呼び出し側で保証すること
+ */
+void tetris_core_put_mino(TETRIS_CORE_field_parameter_t *field_ptr, uint32_t mino_shape, int8_t reference_x, int8_t reference_y)
+{
+    for (uint8_t mino_row = 0; mino_row < TETRIS_CORE_MINO_LENGTH; mino_row++)
+    {
+        int8_t field_y = reference_y + mino_row;
+        if (field_y < 0 || TETRIS_CORE_FIELD_HEIGHT <= field_y)
+            continue;
+
+        field_ptr->row[field_y] |= (uint16_t)TETRIS_CORE_get_mino_row_mask(mino_shape, mino_row, reference_x);
+    }
+}
+
+/**
+ * @brief 落下予測距離算出
+ * @param state_ptr ゲームコア演算状態
+ * @return 接地までの落下距離[ブロック]
+ * @details 現在操作中のミノを1ブロックずつ下げて、フィールドと衝突するまでの距離をカウントする
+ *          ミノの行マスクは位置を下げても変わらないので先に求めておき、各位置ではフィールド行とのANDのみ行う
+ *          （20G等で毎ステップ呼ばれてもフィールド高さ分のAND演算で済む）
+ */
+uint8_t tetris_core_calculate_distance_to_landing(const TETRIS_CORE_state_t *state_ptr)
+{
+    const TETRIS_CORE_mino_parameter_t *mino_ptr = &state_ptr->mino_parameter;
+    uint32_t mino_shape = TETRIS_CORE_get_mino_shape(mino_ptr->mino_type, mino_ptr->turn_state);
+
+    // ブロックのある行の行マスク（フィールド左外は壁として扱う）
+    uint32_t row_masks[TETRIS_CORE_MINO_LENGTH];
+    uint8_t mino_rows[TETRIS_CORE_MINO_LENGTH];
+    uint8_t number_of_rows = 0;
+    for (uint8_t mino_row = 0; mino_row < TETRIS_CORE_MINO_LENGTH; mino_row++)
+    {
+        uint32_t row_mask = TETRIS_CORE_get_mino_row_mask(mino_shape, mino_row, mino_ptr->reference_x);
+        if (!row_mask)
+            continue;
+
+        row_masks[number_of_rows] = row_mask;
+        mino_rows[number_of_rows] = mino_row;
+        number_of_rows++;
+    }
+
+    uint8_t falling_counter = 0;
+    while (falling_counter < LANDING_DISTANCE_MAX)
+    {
+        int8_t next_y = mino_ptr->reference_y + falling_counter + 1;
+        for (uint8_t i = 0; i < number_of_rows; i++)
+        {
+            int8_t field_y = next_y + mino_rows[i];
+            if (TETRIS_CORE_FIELD_HEIGHT <= field_y) // 床に衝突
+                return falling_counter;
+
+            uint32_t field_row = (field_y < 0) ? TETRIS_CORE_ROW_WALL_MASK : state_ptr->field_parameter.row[field_y]; // フィールド上端より上は壁のみ
+            if (row_masks[i] & (0xFFFF0000 | field_row))
+                return falling_counter;
+        }
+
+        falling_counter++;
+    }
+
+    return falling_counter;
+}
+
+/**
+ * @brief フィールド行消去処理
+ * @param field_ptr フィールド演算パラメータ
+ * @return 消去した行数
+ * @details 横1列にブロックが揃っている行を検出して消去し、上の行を段下げする
+ *          消去した行数はスコア等の更新処理に使われる
+ */
+uint8_t tetris_core_erase_field_row(TETRIS_CORE_field_parameter_t *field_ptr)
+{
+    uint16_t *row = field_ptr->row;
+    uint8_t row_erased = 0;
+
+    for (int y_check = TETRIS_CORE_FIELD_HEIGHT - 1; TETRIS_CORE_ERASE_ROW_TOP < y_check; y_check--)
+    {
+        // 行が揃っているかの判定（1行1マスクなので比較1回で済む）
+        if ((row[y_check] & TETRIS_CORE_ROW_BLOCK_MASK) != TETRIS_CORE_ROW_BLOCK_MASK)
+            continue;
+
+        // 揃った行の消去＆段下げ
+        for (int y_update = y_check; TETRIS_CORE_ERASE_ROW_TOP < y_update; y_update--)
+        {
+            row[y_update] = row[y_update - 1];
+        }
+
+        y_check++;    // これが無いと消えた行に下がってきた行を判定できない
+        row_erased++; // 消去した行数。スコア計算用
+    }
+
+    return row_erased;
+}
+
+/**
+ * @brief ゲームオーバー判定
+ * @param field_ptr フィールド演算パラメータ
+ * @return ゲームオーバー判定結果
+ * @details ゲームオーバーラインより上の行にブロックが1つでもあればゲームオーバーとする
+ */
+bool tetris_core_check_is_game_over(const TETRIS_CORE_field_parameter_t *field_ptr)
+{
+    for (uint8_t y = 0; y < TETRIS_CORE_GAME_OVER_LINE; y++)
+    {
+        if (field_ptr->row[y] & TETRIS_CORE_ROW_BLOCK_MASK)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief 疑似乱数取得
+ * @param random_state_ptr 疑似乱数状態（0以外）
+ * @return 疑似乱数（xorshift32）
+ */
+uint32_t tetris_core_get_random_value(uint32_t *random_state_ptr)
+{
+    uint32_t x = *random_state_ptr;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *random_state_ptr = x;
+
+    return x;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
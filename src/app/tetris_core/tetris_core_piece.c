@@ -0,0 +1,179 @@
+/**
+ * @file   tetris_core_piece.c
+ * @brief  tetrisゲームコア・ミノ定義（ピースセット）実装
+ * @details ミノはブロックのセル座標と回転枠のリストで定義し、回転状態毎の形状マスク（5×5を32bitで表現）・出現位置はリストからコンパイル時に定数表を生成する
+ *          衝突判定等のステップ毎の処理は定数表を引くだけなので、ミノの大きさ・種類数に関わらず処理時間は変わらない
+ *          表は書き換えないので、複数のゲームを別スレッドで同時に演算しても（シミュレータ）共有する可変状態は無い
+ *          ピースセットはネクストミノの抽選対象となるミノ種別の範囲で、ゲームモード毎に選択する（ミノ種別の番号は全セット共通）
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris_core.h"
+#include "tetris_core_internal.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+// clang-format off
+// ミノ定義リスト（TETRIS_CORE_mino_type_tの順）
+// MINO(ブロックのセル座標x0, y0 ～ x4, y4, 回転枠の左上のセル座標x, y, 回転枠の一辺, 異なる回転状態の数, 180°回転時の上下の補正)
+// ・セル座標は回転無しの配置（ミノ定義内、左上が(0, 0)）。4ブロックのミノは先頭のブロックを重ねて5つにする
+// ・テトリミノは従来の4×4の形状定義（bitmap/tetrimino_compute.png）と同じ配置になるよう、5×5の左上4×4に置く
+// ・右回転は回転枠内で(x, y) → (枠の一辺 - 1 - y, x)とする。異なる回転状態が2つのミノ（I・S・Zミノ等）は、右1回転の状態と回転無しの状態を交互に取る
+// ・J・Lミノの180°回転は従来の形状定義で枠より1行上に置かれているため、上下の補正で合わせる（上が負）
+#define MINO_DEFINITION_LIST(MINO) \
+    /* テトリミノ */ \
+    MINO(0, 2, 1, 2, 2, 2, 3, 2, 0, 2, 0, 0, 4, 2, 0)  /* I */ \
+    MINO(0, 1, 0, 2, 1, 2, 2, 2, 0, 1, 0, 1, 3, 4, -1) /* J */ \
+    MINO(2, 1, 0, 2, 1, 2, 2, 2, 2, 1, 0, 1, 3, 4, -1) /* L */ \
+    MINO(1, 1, 2, 1, 1, 2, 2, 2, 1, 1, 0, 0, 4, 1, 0)  /* O */ \
+    MINO(1, 1, 2, 1, 0, 2, 1, 2, 1, 1, 0, 0, 3, 2, 0)  /* S */ \
+    MINO(1, 1, 0, 2, 1, 2, 2, 2, 1, 1, 0, 1, 3, 4, 0)  /* T */ \
+    MINO(0, 1, 1, 1, 1, 2, 2, 2, 0, 1, 0, 0, 3, 2, 0)  /* Z */ \
+    /* ペントミノ */ \
+    MINO(1, 0, 2, 0, 0, 1, 1, 1, 1, 2, 0, 0, 3, 4, 0)  /* F */ \
+    MINO(0, 2, 1, 2, 2, 2, 3, 2, 4, 2, 0, 0, 5, 2, 0)  /* I */ \
+    MINO(3, 1, 0, 2, 1, 2, 2, 2, 3, 2, 0, 0, 4, 4, 0)  /* L */ \
+    MINO(0, 1, 1, 1, 1, 2, 2, 2, 3, 2, 0, 0, 4, 4, 0)  /* N */ \
+    MINO(0, 1, 1, 1, 2, 1, 0, 2, 1, 2, 0, 0, 3, 4, 0)  /* P */ \
+    MINO(1, 0, 1, 1, 0, 2, 1, 2, 2, 2, 0, 0, 3, 4, 0)  /* T */ \
+    MINO(0, 1, 2, 1, 0, 2, 1, 2, 2, 2, 0, 0, 3, 4, 0)  /* U */ \
+    MINO(0, 0, 0, 1, 0, 2, 1, 2, 2, 2, 0, 0, 3, 4, 0)  /* V */ \
+    MINO(0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 0, 0, 3, 4, 0)  /* W */ \
+    MINO(1, 0, 0, 1, 1, 1, 2, 1, 1, 2, 0, 0, 3, 1, 0)  /* X */ \
+    MINO(2, 1, 0, 2, 1, 2, 2, 2, 3, 2, 0, 0, 4, 4, 0)  /* Y */ \
+    MINO(0, 0, 1, 0, 1, 1, 1, 2, 2, 2, 0, 0, 3, 2, 0)  /* Z */
+
+// 回転枠内の座標(u, v)を右にturn回（0～3）回転した座標
+#define TURNED_U(u, v, length, turn) (((turn) == 0) ? (u) : ((turn) == 1) ? (length) - 1 - (v) : ((turn) == 2) ? (length) - 1 - (u) : (v))
+#define TURNED_V(u, v, length, turn) (((turn) == 0) ? (v) : ((turn) == 1) ? (u) : ((turn) == 2) ? (length) - 1 - (v) : (length) - 1 - (u))
+
+// ブロック1つの形状マスク：回転枠内の座標で右回転してからミノ定義内の座標に戻す（stateは回転状態数で折り返した回転回数）
+#define CELL_SHAPE(x, y, box_x, box_y, length, state, offset_y_180) \
+    TETRIS_CORE_MINO_CELL_BIT(TURNED_V((x) - (box_x), (y) - (box_y), length, state) + (box_y) + (((state) == 2) ? (offset_y_180) : 0), \
+                              TURNED_U((x) - (box_x), (y) - (box_y), length, state) + (box_x))
+
+// ミノ1つ・回転状態1つの形状マスク
+#define MINO_SHAPE(x0, y0, x1, y1, x2, y2, x3, y3, x4, y4, box_x, box_y, length, state_number, offset_y_180, turn) \
+    (CELL_SHAPE(x0, y0, box_x, box_y, length, (turn) % (state_number), offset_y_180) | \
+     CELL_SHAPE(x1, y1, box_x, box_y, length, (turn) % (state_number), offset_y_180) | \
+     CELL_SHAPE(x2, y2, box_x, box_y, length, (turn) % (state_number), offset_y_180) | \
+     CELL_SHAPE(x3, y3, box_x, box_y, length, (turn) % (state_number), offset_y_180) | \
+     CELL_SHAPE(x4, y4, box_x, box_y, length, (turn) % (state_number), offset_y_180))
+
+// 形状マスク表の1ミノ分（全回転状態）
+#define MINO_SHAPE_ENTRY(...) {MINO_SHAPE(__VA_ARGS__, 0), MINO_SHAPE(__VA_ARGS__, 1), MINO_SHAPE(__VA_ARGS__, 2), MINO_SHAPE(__VA_ARGS__, 3)},
+
+// 出現位置表の1ミノ分：回転枠をプレイフィールドの中央に寄せる（テトリミノは従来の初期位置と同じ列になる）
+#define MINO_SPAWN_X_ENTRY(x0, y0, x1, y1, x2, y2, x3, y3, x4, y4, box_x, box_y, length, state_number, offset_y_180) \
+    (1 + (TETRIS_CORE_FIELD_WIDTH - (length)) / 2 - (box_x)),
+// clang-format on
+
+//======================================================
+// 型定義
+//======================================================
+/**
+ * @brief ピースセット定義
+ */
+typedef struct
+{
+    TETRIS_CORE_mino_type_t first_mino_type; /**< セットの先頭のミノ種別 */
+    uint8_t mino_type_number;                /**< セットのミノ種別数（先頭から連続した番号） */
+} piece_set_definition_t;
+
+//======================================================
+// 変数・定数
+//======================================================
+// ピースセット定義（TETRIS_CORE_piece_set_tの順）
+static const piece_set_definition_t piece_set_definition[TETRIS_CORE_NUMBER_PIECE_SETS] = {
+    {mino_I, mino_Z - mino_I + 1},       // テトリミノ
+    {mino_F5, mino_Z5 - mino_F5 + 1},    // ペントミノ
+};
+
+// ミノ種別・回転状態毎の形状マスク（ミノ定義リストからコンパイル時に生成）
+static const uint32_t mino_shape_table[TETRIS_CORE_NUMBER_MINO_TYPES][r_3_turn + 1] = {MINO_DEFINITION_LIST(MINO_SHAPE_ENTRY)};
+
+// ミノ種別毎の出現時の基準点（X軸）（ミノ定義リストからコンパイル時に生成）
+static const int8_t mino_spawn_x_table[TETRIS_CORE_NUMBER_MINO_TYPES] = {MINO_DEFINITION_LIST(MINO_SPAWN_X_ENTRY)};
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief ミノ形状取得
+ * @param mino_type ミノ種別
+ * @param turn 回転状態
+ * @return 5×5ミノ形状マスク（bit24が左上、行優先）
+ * @details 定数表を引くだけ
+ */
+uint32_t TETRIS_CORE_get_mino_shape(TETRIS_CORE_mino_type_t mino_type, TETRIS_CORE_mino_turn_state_t turn)
+{
+    return mino_shape_table[mino_type][turn];
+}
+
+/**
+ * @brief ピースセット選択
+ * @param state_ptr ゲームコア演算状態
+ * @param piece_set ピースセット
+ * @return なし
+ * @details ゲーム開始前（TETRIS_CORE_initializeの直後）に呼ぶ。初期化時に抽選したネクストミノ列を、選択したセットから引き直す
+ *          引き直しも同じ疑似乱数状態から続けて抽選するので、同じシード・同じセットからは同じミノ順になる
+ */
+void TETRIS_CORE_select_piece_set(TETRIS_CORE_state_t *state_ptr, TETRIS_CORE_piece_set_t piece_set)
+{
+    state_ptr->piece_set = piece_set;
+    for (uint8_t i = 0; i < TETRIS_CORE_NEXT_QUEUE_LENGTH; i++)
+    {
+        state_ptr->mino_parameter.next_mino_queue[i] = tetris_core_get_random_mino_type(&state_ptr->random_state, piece_set);
+    }
+    state_ptr->mino_parameter.hold_mino_type = piece_set_definition[piece_set].first_mino_type;
+}
+
+/**
+ * @brief 出現位置取得（X軸）
+ * @param mino_type ミノ種別
+ * @return 出現時の基準点（X軸）
+ */
+int8_t tetris_core_get_spawn_reference_x(TETRIS_CORE_mino_type_t mino_type)
+{
+    return mino_spawn_x_table[mino_type];
+}
+
+/**
+ * @brief 疑似乱数ミノ種別取得
+ * @param random_state_ptr 疑似乱数状態
+ * @param piece_set ピースセット
+ * @return ミノ種別（セット内のいずれか）
+ * @details 疑似乱数状態を更新し、ミノ種別に変換する
+ *          状態はゲーム毎に保持するため、同じシードからは同じミノ順になる（シミュレーションの再現用）
+ */
+TETRIS_CORE_mino_type_t tetris_core_get_random_mino_type(uint32_t *random_state_ptr, TETRIS_CORE_piece_set_t piece_set)
+{
+    const piece_set_definition_t *set_ptr = &piece_set_definition[piece_set];
+
+    return (TETRIS_CORE_mino_type_t)(set_ptr->first_mino_type + tetris_core_get_random_value(random_state_ptr) % set_ptr->mino_type_number);
+}
+
+/**
+ * @brief ピースセット所属判定
+ * @param mino_type ミノ種別
+ * @param piece_set ピースセット
+ * @return true：ミノ種別がセットに含まれる
+ */
+bool tetris_core_is_mino_in_piece_set(uint8_t mino_type, TETRIS_CORE_piece_set_t piece_set)
+{
+    const piece_set_definition_t *set_ptr = &piece_set_definition[piece_set];
+
+    return (set_ptr->first_mino_type <= mino_type) && (mino_type < set_ptr->first_mino_type + set_ptr->mino_type_number);
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
@@ -0,0 +1,197 @@
+/**
+ * @file   tetris_core_score.c
+ * @brief  tetrisゲームコア・得点（Tスピン・コンボ・Back to Back）実装
+ * @details ミノ固定時の行消去数・Tスピン種別・連続消去状況からスコアとレベルを更新する
+ *          得点はいずれも「基本点×(9 + レベル)」で、レベル1で一般的なガイドラインの得点になるよう基本点を決めている
+ *          Tスピン判定はフィールド行ビットマスクから四隅の4bitを切り出して表引きするだけなので、固定毎に呼んでも処理時間一定
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris_core.h"
+#include "tetris_core_internal.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+// Tスピン判定の四隅：T字ミノの中心（ミノ定義5×5の列1・行2）の斜め4マス＝ミノ定義の行1・3の列0・2
+#define T_SPIN_CORNER_ROW_TOP 1
+#define T_SPIN_CORNER_ROW_BOTTOM 3
+// ミノ定義1行分（最下行と同じbit配置。列0が最上位bit）の列0・列2
+#define T_SPIN_CORNER_COLUMN_MASK (TETRIS_CORE_MINO_CELL_BIT(TETRIS_CORE_MINO_LENGTH - 1, 0) | TETRIS_CORE_MINO_CELL_BIT(TETRIS_CORE_MINO_LENGTH - 1, 2))
+#define T_SPIN_CORNER_BITS_SHIFT (TETRIS_CORE_MINO_LENGTH - 4) // 列0を四隅の4bit配置のbit3に合わせるシフト量
+#define T_SPIN_CORNERS_MIN 3                                    // Tスピン成立に必要な埋まった角の数
+#define T_SPIN_ERASE_ROW_MAX 3                                  // T字ミノで一度に消去可能な最大行数
+
+// コンボ・Back to Backの加点
+#define SCORE_COMBO_RATE 5               // コンボ1回あたりの基本点（2連続目から加点）
+#define SCORE_BACK_TO_BACK_NUMERATOR 3   // Back to Back時の倍率（1.5倍）
+#define SCORE_BACK_TO_BACK_DENOMINATOR 2 // Back to Back時の倍率（1.5倍）
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+// 四隅の埋まり方（bit3：左上、bit2：左下、bit1：右上、bit0：右下）毎の埋まった角の数
+static const uint8_t t_spin_corner_count[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+// 回転状態毎のT字ミノの凸側の2隅（四隅のビット配置はt_spin_corner_countと同じ）
+static const uint8_t t_spin_front_corner[r_3_turn + 1] = {
+    0xA, // 凸が上：左上・右上
+    0x3, // 凸が右：右上・右下
+    0x5, // 凸が下：左下・右下
+    0xC, // 凸が左：左上・左下
+};
+
+// Tスピン種別・消去行数毎の基本点（Tスピンで消去した場合は通常の消去の得点の代わりに加点する）
+static const uint8_t t_spin_score[t_spin_full + 1][T_SPIN_ERASE_ROW_MAX + 1] = {
+    {0, 0, 0, 0},       // Tスピン無し（未使用）
+    {10, 20, 40, 40},   // Tスピンミニ
+    {40, 80, 120, 160}, // Tスピン
+};
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static uint8_t get_corner_bits(const TETRIS_CORE_field_parameter_t *field_ptr, int8_t field_y, int8_t reference_x);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief Tスピン判定
+ * @param state_ptr ゲームコア演算状態
+ * @return Tスピン種別
+ * @details 固定直前の操作ミノについて3コーナールールで判定する（ミノ固定前に呼ぶこと）
+ *          T字ミノで、最後に成功した操作が回転であり、中心の斜め4マスのうち3マス以上が埋まっていればTスピン
+ *          凸側の2隅が両方埋まっていればTスピン、片方のみならTスピンミニとする。壁・床は埋まっている扱い
+ */
+TETRIS_CORE_t_spin_t tetris_core_check_t_spin(const TETRIS_CORE_state_t *state_ptr)
+{
+    const TETRIS_CORE_mino_parameter_t *mino_ptr = &state_ptr->mino_parameter;
+    if (mino_ptr->mino_type != mino_T || !mino_ptr->is_last_move_turn)
+        return t_spin_none;
+
+    // 上側の2隅をbit3・bit1、下側の2隅をbit2・bit0に並べる
+    uint8_t top_bits = get_corner_bits(&state_ptr->field_parameter, mino_ptr->reference_y + T_SPIN_CORNER_ROW_TOP, mino_ptr->reference_x);
+    uint8_t bottom_bits = get_corner_bits(&state_ptr->field_parameter, mino_ptr->reference_y + T_SPIN_CORNER_ROW_BOTTOM, mino_ptr->reference_x);
+    uint8_t corners = top_bits | (bottom_bits >> 1);
+
+    if (t_spin_corner_count[corners] < T_SPIN_CORNERS_MIN)
+        return t_spin_none;
+
+    uint8_t front_corner = t_spin_front_corner[mino_ptr->turn_state];
+    return ((corners & front_corner) == front_corner) ? t_spin_full : t_spin_mini;
+}
+
+/**
+ * @brief ゲームパラメータ更新
+ * @param state_ptr ゲームコア演算状態
+ * @param t_spin 固定したミノのTスピン種別
+ * @return なし
+ * @details ミノの固定毎に呼び、行消去数・Tスピン種別に応じてスコアやレベルなどのゲームパラメータを更新する
+ *          コンボ：行消去が連続したミノ数。2連続目から加点し、行消去の無い固定で途切れる
+ *          Back to Back：4行消去・行消去を伴うTスピンが（間に他の行消去を挟まず）続いた場合、その消去の得点を1.5倍にする
+ *          行消去があれば対戦相手へのせり上がりも送る
+ */
+void tetris_core_update_game_parameter(TETRIS_CORE_state_t *state_ptr, TETRIS_CORE_t_spin_t t_spin)
+{
+    TETRIS_CORE_game_parameter_t *game_parameter_ptr = &state_ptr->game_parameter;
+    const TETRIS_CORE_difficulty_t *difficulty_ptr = state_ptr->difficulty_ptr;
+    uint8_t row_erased = state_ptr->row_erased;
+    uint8_t rate_index = (TETRIS_CORE_ERASE_ROW_MAX < row_erased) ? TETRIS_CORE_ERASE_ROW_MAX : row_erased; // ペントミノの5行消去は4行消去の倍率
+
+    game_parameter_ptr->latest_t_spin = t_spin;
+    if (!row_erased)
+        game_parameter_ptr->combo = 0; // 行消去の無い固定でコンボは途切れる（Back to Backは途切れない）
+
+    if (!row_erased && t_spin_none == t_spin) // 行の消去もTスピンも無し → パラメータ更新無し
+    {
+        game_parameter_ptr->is_updated = false;
+        return;
+    }
+
+    // 消去・Tスピンの基本点：一度に多くの行を消去する程スコア増
+    uint32_t points;
+    if (t_spin_none != t_spin)
+        points = t_spin_score[t_spin][(row_erased < T_SPIN_ERASE_ROW_MAX) ? row_erased : T_SPIN_ERASE_ROW_MAX];
+    else
+        points = difficulty_ptr->score_power_rate[rate_index] * row_erased;
+
+    if (row_erased)
+    {
+        // Back to Back：難しい消去が続いたら1.5倍（難しくない消去で途切れる）
+        bool is_difficult = (TETRIS_CORE_ERASE_ROW_MAX <= row_erased) || (t_spin_none != t_spin);
+        bool is_back_to_back_bonus = is_difficult && game_parameter_ptr->is_back_to_back;
+        if (is_back_to_back_bonus)
+            points = points * SCORE_BACK_TO_BACK_NUMERATOR / SCORE_BACK_TO_BACK_DENOMINATOR;
+        game_parameter_ptr->is_back_to_back = is_difficult;
+
+        // コンボ：2連続目から連続数に応じて加点
+        if (game_parameter_ptr->combo < UINT8_MAX)
+            game_parameter_ptr->combo++;
+        points += SCORE_COMBO_RATE * (game_parameter_ptr->combo - 1);
+
+        // 対戦相手へのせり上がり
+        tetris_core_send_garbage(state_ptr, row_erased, t_spin, is_back_to_back_bonus);
+
+        // 消去行総数更新
+        game_parameter_ptr->row_deleted += row_erased;
+        // レベル更新：消去行総数が一定を超える毎にレベルアップ
+        if ((game_parameter_ptr->level < TETRIS_CORE_MAXIMUM_LEVEL) && (difficulty_ptr->next_level_need_row[game_parameter_ptr->level] < game_parameter_ptr->row_deleted))
+        {
+            game_parameter_ptr->level++;
+        }
+    }
+
+    tetris_core_add_score(state_ptr, points * (9 + game_parameter_ptr->level));
+
+    state_ptr->row_erased = 0;             // 行消去数リセット
+    game_parameter_ptr->is_updated = true; // パラメータ更新したのでUIを更新させる必要があるためtrue
+}
+
+/**
+ * @brief スコア加算
+ * @param state_ptr ゲームコア演算状態
+ * @param points 加算する得点
+ * @return なし
+ * @details スコア上限（TETRIS_CORE_SCORE_MAX）で頭打ちにする
+ */
+void tetris_core_add_score(TETRIS_CORE_state_t *state_ptr, uint32_t points)
+{
+    TETRIS_CORE_game_parameter_t *game_parameter_ptr = &state_ptr->game_parameter;
+
+    game_parameter_ptr->score = (TETRIS_CORE_SCORE_MAX - game_parameter_ptr->score < points) ? TETRIS_CORE_SCORE_MAX : game_parameter_ptr->score + points;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief Tスピン判定用の角の切り出し
+ * @param field_ptr フィールド演算パラメータ
+ * @param field_y 切り出すフィールド行
+ * @param reference_x ミノの基準点（X軸）
+ * @return ミノ定義の列0・列2に当たる2マス（bit3：列0、bit1：列2。埋まっていれば1）
+ * @details フィールド行からTETRIS_CORE_get_mino_row_maskの逆変換でミノ定義1行分を切り出し、列0・列2をマスクするだけ
+ *          床より下は全て埋まっている扱い
+ */
+static uint8_t get_corner_bits(const TETRIS_CORE_field_parameter_t *field_ptr, int8_t field_y, int8_t reference_x)
+{
+    uint16_t field_row;
+    if (TETRIS_CORE_FIELD_HEIGHT <= field_y)
+        field_row = UINT16_MAX; // 床
+    else if (field_y < 0)
+        field_row = TETRIS_CORE_ROW_WALL_MASK; // フィールド上端より上は壁のみ
+    else
+        field_row = field_ptr->row[field_y];
+
+    uint32_t mino_row_bits = (((uint32_t)field_row << (reference_x + TETRIS_CORE_MINO_LENGTH)) >> 16) & TETRIS_CORE_MINO_ROW_MASK;
+
+    return (uint8_t)((mino_row_bits & T_SPIN_CORNER_COLUMN_MASK) >> T_SPIN_CORNER_BITS_SHIFT);
+}
@@ -0,0 +1,326 @@
+/**
+ * @file   tetris_core_serialize.c
+ * @brief  tetrisゲームコア・演算状態シリアライズ実装
+ * @details 演算状態を電源断を跨いで保存するための固定長バイト列（リトルエンディアン）に変換する（ゲームの中断・再開用）
+ *          フィールドは壁を除くブロックのビットのみを詰めて格納し、演算状態の構造体（パディング・ポインタを含む）をそのまま
+ *          保存するより小さくする。設定テーブルへのポインタはファームウェア毎にアドレスが変わるため保存せず、復元時に既定値とする
+ *          固定タイミング統計・プレイ統計は計測用なので保存しない（復元時に0から計り直す）
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris_core.h"
+#include "tetris_core_internal.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define SERIALIZE_FORMAT_VERSION 4 // 形式バージョン（形式を変えたら更新し、古い形式のデータは復元しない）
+
+// フラグ格納用のビット位置
+#define FLAG_IS_HOLDING 0x01
+#define FLAG_IS_HOLD_AVAILABLE 0x02
+#define FLAG_IS_NEXT_MINO_GENERATE 0x04
+#define FLAG_IS_LAST_MOVE_TURN 0x08
+#define FLAG_IS_BACK_TO_BACK 0x10
+#define FLAG_ALLOW_DOWN_SHIFT 0x20
+#define FLAG_ALLOW_HARD_DROP 0x40
+#define FLAG_IS_GROUNDED 0x80
+#define FLAG_IS_SOFT_DROPPING 0x01
+#define FLAG_IS_EXTERNAL 0x02
+#define FLAG_HAS_GROUNDED 0x04
+
+// ミノ基準点の復元可能範囲（行マスクのシフト量・フィールド行の添字が範囲内に収まる位置。壁・床との重なりは衝突判定で弾く）
+#define REFERENCE_X_MIN (1 - TETRIS_CORE_MINO_LENGTH)
+#define REFERENCE_X_MAX TETRIS_CORE_FIELD_WIDTH
+#define REFERENCE_Y_MIN (1 - TETRIS_CORE_MINO_LENGTH)
+#define REFERENCE_Y_MAX (TETRIS_CORE_FIELD_HEIGHT - 1)
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static uint8_t *put_value(uint8_t *buffer, uint64_t value, uint8_t bytes);
+static uint64_t get_value(const uint8_t **buffer_ptr, uint8_t bytes);
+static uint8_t *put_field(uint8_t *buffer, const TETRIS_CORE_field_parameter_t *field_ptr);
+static void get_field(const uint8_t **buffer_ptr, TETRIS_CORE_field_parameter_t *field_ptr);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief 演算状態シリアライズ
+ * @param state_ptr ゲームコア演算状態
+ * @param buffer 格納先（TETRIS_CORE_SERIALIZED_SIZE byte）
+ * @return なし
+ * @details 接地猶予・自由落下の時刻はゲーム経過時間からの差[us]として格納する
+ */
+void TETRIS_CORE_serialize(const TETRIS_CORE_state_t *state_ptr, uint8_t *buffer)
+{
+    const TETRIS_CORE_mino_parameter_t *mino_ptr = &state_ptr->mino_parameter;
+    const TETRIS_CORE_game_parameter_t *game_ptr = &state_ptr->game_parameter;
+    const TETRIS_CORE_auto_shift_t *auto_shift_ptr = &state_ptr->auto_shift;
+    const TETRIS_CORE_lock_delay_t *lock_ptr = &state_ptr->lock_delay;
+
+    uint8_t flags = 0;
+    flags |= (mino_ptr->is_holding) ? FLAG_IS_HOLDING : 0;
+    flags |= (mino_ptr->is_hold_available) ? FLAG_IS_HOLD_AVAILABLE : 0;
+    flags |= (mino_ptr->is_next_mino_generate) ? FLAG_IS_NEXT_MINO_GENERATE : 0;
+    flags |= (mino_ptr->is_last_move_turn) ? FLAG_IS_LAST_MOVE_TURN : 0;
+    flags |= (game_ptr->is_back_to_back) ? FLAG_IS_BACK_TO_BACK : 0;
+    flags |= (state_ptr->allow_down_shift) ? FLAG_ALLOW_DOWN_SHIFT : 0;
+    flags |= (state_ptr->allow_hard_drop) ? FLAG_ALLOW_HARD_DROP : 0;
+    flags |= (lock_ptr->is_grounded) ? FLAG_IS_GROUNDED : 0;
+    uint8_t auto_shift_flags = 0;
+    auto_shift_flags |= (auto_shift_ptr->is_soft_dropping) ? FLAG_IS_SOFT_DROPPING : 0;
+    auto_shift_flags |= (auto_shift_ptr->is_external) ? FLAG_IS_EXTERNAL : 0;
+    auto_shift_flags |= (lock_ptr->has_grounded) ? FLAG_HAS_GROUNDED : 0;
+
+    buffer = put_value(buffer, SERIALIZE_FORMAT_VERSION, 1);
+    buffer = put_value(buffer, flags, 1);
+    buffer = put_value(buffer, auto_shift_flags, 1);
+
+    // ミノ
+    buffer = put_value(buffer, state_ptr->piece_set, 1);
+    buffer = put_value(buffer, (uint8_t)mino_ptr->reference_x, 1);
+    buffer = put_value(buffer, (uint8_t)mino_ptr->reference_y, 1);
+    buffer = put_value(buffer, mino_ptr->distance_to_landing, 1);
+    buffer = put_value(buffer, mino_ptr->turn_state, 1);
+    buffer = put_value(buffer, mino_ptr->mino_type, 1);
+    buffer = put_value(buffer, mino_ptr->hold_mino_type, 1);
+    for (uint8_t i = 0; i < TETRIS_CORE_NEXT_QUEUE_LENGTH; i++)
+        buffer = put_value(buffer, mino_ptr->next_mino_queue[i], 1);
+
+    // フィールド
+    buffer = put_field(buffer, &state_ptr->field_parameter);
+
+    // ゲームパラメータ
+    buffer = put_value(buffer, game_ptr->level, 1);
+    buffer = put_value(buffer, game_ptr->row_deleted, 2);
+    buffer = put_value(buffer, game_ptr->score, 4);
+    buffer = put_value(buffer, game_ptr->combo, 1);
+    buffer = put_value(buffer, game_ptr->latest_t_spin, 1);
+
+    // 内部演算用パラメータ・疑似乱数
+    buffer = put_value(buffer, (uint32_t)state_ptr->move_counter.D, 4);
+    buffer = put_value(buffer, state_ptr->row_erased, 1);
+    buffer = put_value(buffer, state_ptr->random_state, 4);
+
+    // オートシフト・接地猶予
+    buffer = put_value(buffer, (uint8_t)auto_shift_ptr->direction, 1);
+    buffer = put_value(buffer, (uint32_t)auto_shift_ptr->shift_timer_us, 4);
+    buffer = put_value(buffer, (uint32_t)auto_shift_ptr->drop_timer_us, 4);
+    buffer = put_value(buffer, state_ptr->time_us, 8);
+    buffer = put_value(buffer, tetris_core_get_elapsed_time(state_ptr->time_us, lock_ptr->grounded_time_us), 4);
+    buffer = put_value(buffer, tetris_core_get_elapsed_time(state_ptr->time_us, lock_ptr->lock_start_time_us), 4);
+    buffer = put_value(buffer, tetris_core_get_elapsed_time(state_ptr->time_us, state_ptr->move_counter.fall_time_us), 4);
+    buffer = put_value(buffer, lock_ptr->reset_count, 1);
+
+    // せり上がり
+    buffer = put_value(buffer, state_ptr->garbage.pending, 1);
+    buffer = put_value(buffer, state_ptr->garbage.outgoing, 1);
+    buffer = put_value(buffer, state_ptr->garbage.random_state, 4);
+}
+
+/**
+ * @brief 演算状態デシリアライズ
+ * @param state_ptr 復元先のゲームコア演算状態
+ * @param buffer シリアライズ済みデータ（TETRIS_CORE_SERIALIZED_SIZE byte）
+ * @return 復元できた場合true（形式バージョン違い・範囲外の値を含む場合はfalseで、演算状態は変更しない）
+ * @details 設定テーブルは既定値、固定タイミング統計は0とし、初回ステップで画面全体を描画させる
+ *          操作中のミノは基準点が範囲外、またはフィールドと重なる場合に復元せず、着地点までの距離は復元したフィールドから算出し直す
+ */
+bool TETRIS_CORE_deserialize(TETRIS_CORE_state_t *state_ptr, const uint8_t *buffer)
+{
+    TETRIS_CORE_state_t state;
+    TETRIS_CORE_mino_parameter_t *mino_ptr = &state.mino_parameter;
+    TETRIS_CORE_game_parameter_t *game_ptr = &state.game_parameter;
+    TETRIS_CORE_auto_shift_t *auto_shift_ptr = &state.auto_shift;
+    TETRIS_CORE_lock_delay_t *lock_ptr = &state.lock_delay;
+    bool is_valid = true;
+
+    if (SERIALIZE_FORMAT_VERSION != get_value(&buffer, 1))
+        return false;
+    uint8_t flags = (uint8_t)get_value(&buffer, 1);
+    uint8_t auto_shift_flags = (uint8_t)get_value(&buffer, 1);
+
+    // ミノ（ミノ種別は選択中のピースセットに含まれること）
+    uint8_t piece_set = (uint8_t)get_value(&buffer, 1);
+    if (TETRIS_CORE_NUMBER_PIECE_SETS <= piece_set)
+        return false;
+    state.piece_set = (TETRIS_CORE_piece_set_t)piece_set;
+    mino_ptr->reference_x = (int8_t)get_value(&buffer, 1);
+    mino_ptr->reference_y = (int8_t)get_value(&buffer, 1);
+    mino_ptr->distance_to_landing = (uint8_t)get_value(&buffer, 1);
+    uint8_t turn_state = (uint8_t)get_value(&buffer, 1);
+    uint8_t mino_type = (uint8_t)get_value(&buffer, 1);
+    uint8_t hold_mino_type = (uint8_t)get_value(&buffer, 1);
+    is_valid &= (turn_state <= r_3_turn) && tetris_core_is_mino_in_piece_set(mino_type, state.piece_set) && tetris_core_is_mino_in_piece_set(hold_mino_type, state.piece_set);
+    mino_ptr->turn_state = (TETRIS_CORE_mino_turn_state_t)turn_state;
+    mino_ptr->mino_type = (TETRIS_CORE_mino_type_t)mino_type;
+    mino_ptr->hold_mino_type = (TETRIS_CORE_mino_type_t)hold_mino_type;
+    for (uint8_t i = 0; i < TETRIS_CORE_NEXT_QUEUE_LENGTH; i++)
+    {
+        uint8_t next_mino_type = (uint8_t)get_value(&buffer, 1);
+        is_valid &= tetris_core_is_mino_in_piece_set(next_mino_type, state.piece_set);
+        mino_ptr->next_mino_queue[i] = (TETRIS_CORE_mino_type_t)next_mino_type;
+    }
+    mino_ptr->is_holding = (flags & FLAG_IS_HOLDING);
+    mino_ptr->is_hold_available = (flags & FLAG_IS_HOLD_AVAILABLE);
+    mino_ptr->is_next_mino_generate = (flags & FLAG_IS_NEXT_MINO_GENERATE);
+    mino_ptr->is_last_move_turn = (flags & FLAG_IS_LAST_MOVE_TURN);
+
+    // フィールド
+    get_field(&buffer, &state.field_parameter);
+
+    // 操作中のミノの位置（ミノ種別・回転状態が有効な場合のみ形状を引いて確認する）
+    is_valid &= (REFERENCE_X_MIN <= mino_ptr->reference_x) && (mino_ptr->reference_x <= REFERENCE_X_MAX) && (REFERENCE_Y_MIN <= mino_ptr->reference_y) && (mino_ptr->reference_y <= REFERENCE_Y_MAX);
+    if (is_valid && !mino_ptr->is_next_mino_generate)
+    {
+        uint32_t mino_shape = TETRIS_CORE_get_mino_shape(mino_ptr->mino_type, mino_ptr->turn_state);
+        is_valid &= (not_collided == tetris_core_check_collision(&state.field_parameter, mino_shape, mino_ptr->reference_x, mino_ptr->reference_y));
+        mino_ptr->distance_to_landing = tetris_core_calculate_distance_to_landing(&state);
+    }
+
+    // ゲームパラメータ
+    game_ptr->level = (uint8_t)get_value(&buffer, 1);
+    game_ptr->row_deleted = (uint16_t)get_value(&buffer, 2);
+    game_ptr->score = (uint32_t)get_value(&buffer, 4);
+    game_ptr->combo = (uint8_t)get_value(&buffer, 1);
+    uint8_t latest_t_spin = (uint8_t)get_value(&buffer, 1);
+    is_valid &= (1 <= game_ptr->level) && (game_ptr->level <= TETRIS_CORE_MAXIMUM_LEVEL) && (latest_t_spin <= t_spin_full);
+    game_ptr->latest_t_spin = (TETRIS_CORE_t_spin_t)latest_t_spin;
+    game_ptr->is_back_to_back = (flags & FLAG_IS_BACK_TO_BACK);
+    game_ptr->is_updated = true;
+
+    // 内部演算用パラメータ・疑似乱数
+    state.move_counter.D = (uint32_t)get_value(&buffer, 4);
+    is_valid &= (state.move_counter.D < (uint32_t)TETRIS_CORE_GRAVITY_ONE_CELL * TETRIS_CORE_STEP_PERIOD_US);
+    state.row_erased = (uint8_t)get_value(&buffer, 1);
+    state.random_state = (uint32_t)get_value(&buffer, 4);
+    state.allow_down_shift = (flags & FLAG_ALLOW_DOWN_SHIFT);
+    state.allow_hard_drop = (flags & FLAG_ALLOW_HARD_DROP);
+
+    // オートシフト・接地猶予
+    auto_shift_ptr->direction = (int8_t)get_value(&buffer, 1);
+    auto_shift_ptr->shift_timer_us = (int32_t)(uint32_t)get_value(&buffer, 4);
+    auto_shift_ptr->drop_timer_us = (int32_t)(uint32_t)get_value(&buffer, 4);
+    auto_shift_ptr->is_soft_dropping = (auto_shift_flags & FLAG_IS_SOFT_DROPPING);
+    auto_shift_ptr->is_external = (auto_shift_flags & FLAG_IS_EXTERNAL);
+    state.time_us = get_value(&buffer, 8);
+    lock_ptr->grounded_time_us = state.time_us - get_value(&buffer, 4);
+    lock_ptr->lock_start_time_us = state.time_us - get_value(&buffer, 4);
+    state.move_counter.fall_time_us = state.time_us - get_value(&buffer, 4);
+    lock_ptr->reset_count = (uint8_t)get_value(&buffer, 1);
+    lock_ptr->is_grounded = (flags & FLAG_IS_GROUNDED);
+    lock_ptr->has_grounded = (auto_shift_flags & FLAG_HAS_GROUNDED);
+
+    // せり上がり
+    state.garbage.pending = (uint8_t)get_value(&buffer, 1);
+    state.garbage.outgoing = (uint8_t)get_value(&buffer, 1);
+    state.garbage.random_state = (uint32_t)get_value(&buffer, 4);
+
+    if (!is_valid)
+        return false;
+
+    // 保存しないパラメータ
+    state.difficulty_ptr = &TETRIS_CORE_difficulty_default;
+    state.auto_shift_config_ptr = &TETRIS_CORE_auto_shift_config_default;
+    state.lock_delay_config_ptr = &TETRIS_CORE_lock_delay_config_default;
+    state.lock_statistics = (TETRIS_CORE_lock_statistics_t){0};
+    tetris_core_initialize_play_statistics(&state);
+    state.is_changed = true;
+
+    *state_ptr = state;
+    return true;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief 値の格納
+ * @param buffer 格納先
+ * @param value 格納する値
+ * @param bytes 格納するbyte数（下位から）
+ * @return 格納した次の位置
+ */
+static uint8_t *put_value(uint8_t *buffer, uint64_t value, uint8_t bytes)
+{
+    for (uint8_t i = 0; i < bytes; i++)
+        *buffer++ = (uint8_t)(value >> (8 * i));
+
+    return buffer;
+}
+
+/**
+ * @brief 値の取り出し
+ * @param buffer_ptr 読み出し位置（取り出した次の位置に進める）
+ * @param bytes 取り出すbyte数
+ * @return 取り出した値
+ */
+static uint64_t get_value(const uint8_t **buffer_ptr, uint8_t bytes)
+{
+    uint64_t value = 0;
+
+    for (uint8_t i = 0; i < bytes; i++)
+        value |= (uint64_t)*(*buffer_ptr)++ << (8 * i);
+
+    return value;
+}
+
+/**
+ * @brief フィールドの格納
+ * @param buffer 格納先
+ * @param field_ptr フィールド演算パラメータ
+ * @return 格納した次の位置
+ * @details 各行のブロックのビット（TETRIS_CORE_FIELD_WIDTH bit）を上の行から順に隙間なく詰める
+ */
+static uint8_t *put_field(uint8_t *buffer, const TETRIS_CORE_field_parameter_t *field_ptr)
+{
+    uint32_t bit_buffer = 0;
+    uint8_t bit_count = 0;
+
+    for (uint8_t y = 0; y < TETRIS_CORE_FIELD_HEIGHT; y++)
+    {
+        bit_buffer |= (uint32_t)((field_ptr->row[y] & TETRIS_CORE_ROW_BLOCK_MASK) >> TETRIS_CORE_ROW_BLOCK_SHIFT) << bit_count;
+        bit_count += TETRIS_CORE_FIELD_WIDTH;
+        for (; 8 <= bit_count; bit_count -= 8, bit_buffer >>= 8)
+            *buffer++ = (uint8_t)bit_buffer;
+    }
+    if (bit_count)
+        *buffer++ = (uint8_t)bit_buffer;
+
+    return buffer;
+}
+
+/**
+ * @brief フィールドの取り出し
+ * @param buffer_ptr 読み出し位置（取り出した次の位置に進める）
+ * @param field_ptr フィールド演算パラメータ格納先
+ * @return なし
+ */
+static void get_field(const uint8_t **buffer_ptr, TETRIS_CORE_field_parameter_t *field_ptr)
+{
+    uint32_t bit_buffer = 0;
+    uint8_t bit_count = 0;
+
+    for (uint8_t y = 0; y < TETRIS_CORE_FIELD_HEIGHT; y++)
+    {
+        for (; bit_count < TETRIS_CORE_FIELD_WIDTH; bit_count += 8)
+            bit_buffer |= (uint32_t)*(*buffer_ptr)++ << bit_count;
+        uint16_t blocks = (uint16_t)(bit_buffer & ((1u << TETRIS_CORE_FIELD_WIDTH) - 1));
+        field_ptr->row[y] = TETRIS_CORE_ROW_WALL_MASK | (uint16_t)(blocks << TETRIS_CORE_ROW_BLOCK_SHIFT);
+        bit_buffer >>= TETRIS_CORE_FIELD_WIDTH;
+        bit_count -= TETRIS_CORE_FIELD_WIDTH;
+    }
+}
@@ -0,0 +1,137 @@
+/**
+ * @file   tetris_core_shift.c
+ * @brief  tetrisゲームコア・オートシフト（DAS/ARR・高速落下）実装
+ * @details 左右移動と高速落下を経過時間[us]で管理する。ステップ周期（10ms）とは独立に呼び出せるため、
+ *          より短い周期から呼び出せば移動の遅延がステップ周期に量子化されなくなる
+ *          ステップ外から駆動する場合はauto_shift.is_externalをtrueにすること（ステップ内で二重に進めないため）
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris_core.h"
+#include "tetris_core_internal.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+// オートシフト設定の既定値（リピート間隔・高速落下速度は従来の30ms・10ms毎を踏襲）
+const TETRIS_CORE_auto_shift_config_t TETRIS_CORE_auto_shift_config_default = {
+    .das_us = 150000,
+    .arr_us = 30000,
+    .soft_drop_us = 10000,
+};
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static bool repeat_shift(TETRIS_CORE_state_t *state_ptr, int32_t *timer_us_ptr, uint32_t interval_us, int8_t shift_x_level, int8_t shift_y_level, uint8_t repeat_max);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief オートシフト処理
+ * @param state_ptr ゲームコア演算状態
+ * @param input_ptr 現在の入力
+ * @param elapsed_us 前回呼び出しからの経過時間[us]
+ * @return なし
+ * @details ゲーム経過時間（接地猶予の時間基準）もここで進める
+ *          左右移動：入力方向が変わった瞬間に1マス移動してDASのタイマを開始し、タイマ満了後はARR毎に移動する
+ *          高速落下：下入力が許可されている間、押下直後に1マス落下し、以降soft_drop_us毎に落下する
+ *          操作ミノが無い間（接地～次ステップの生成まで）も入力の継続時間は数え続ける（DASを溜めておける）
+ *          高速落下で着地してもここでは接地させない。接地判定はステップ側で行う
+ *          接地中に左右移動できた場合は接地猶予を延長する。固定期限を過ぎた後は移動しない
+ */
+void TETRIS_CORE_auto_shift(TETRIS_CORE_state_t *state_ptr, const TETRIS_CORE_input_t *input_ptr, uint32_t elapsed_us)
+{
+    TETRIS_CORE_auto_shift_t *shift_ptr = &state_ptr->auto_shift;
+    const TETRIS_CORE_auto_shift_config_t *config_ptr = state_ptr->auto_shift_config_ptr;
+
+    state_ptr->time_us += elapsed_us;
+    bool is_mino_active = !state_ptr->mino_parameter.is_next_mino_generate && !tetris_core_is_lock_expired(state_ptr);
+
+    /* 左右移動 */
+    int8_t direction = (int8_t)input_ptr->is_input_R - (int8_t)input_ptr->is_input_L; // 左右同時押しは入力無し扱い
+    if (direction != shift_ptr->direction) // 押下・離す・反転
+    {
+        shift_ptr->direction = direction;
+        shift_ptr->shift_timer_us = (int32_t)config_ptr->das_us;
+        if (direction)
+            tetris_core_count_input(state_ptr, false);
+        if (direction && is_mino_active && !tetris_core_shift_mino(state_ptr, direction, 0))
+            tetris_core_reset_lock_delay(state_ptr);
+    }
+    else if (direction) // 押下継続
+    {
+        shift_ptr->shift_timer_us -= (int32_t)elapsed_us;
+        if (is_mino_active && repeat_shift(state_ptr, &shift_ptr->shift_timer_us, config_ptr->arr_us, direction, 0, TETRIS_CORE_FIELD_WIDTH))
+            tetris_core_reset_lock_delay(state_ptr);
+    }
+
+    /* 高速落下 */
+    if (!input_ptr->is_input_D) // ミノ生成後に一度下入力を離せば高速落下を許可する（直前のミノからの下入力継続による誤操作防止）
+        state_ptr->allow_down_shift = true;
+
+    bool is_soft_drop = input_ptr->is_input_D && state_ptr->allow_down_shift;
+    if (is_soft_drop != shift_ptr->is_soft_dropping) // 押下・離す
+    {
+        shift_ptr->is_soft_dropping = is_soft_drop;
+        shift_ptr->drop_timer_us = 0; // 押下直後に1マス落下させる
+        if (is_soft_drop)
+            tetris_core_count_input(state_ptr, true);
+    }
+    else if (is_soft_drop) // 押下継続
+    {
+        shift_ptr->drop_timer_us -= (int32_t)elapsed_us;
+    }
+    if (is_soft_drop && is_mino_active)
+        repeat_shift(state_ptr, &shift_ptr->drop_timer_us, config_ptr->soft_drop_us, 0, 1, TETRIS_CORE_FIELD_HEIGHT);
+
+    // 操作ミノ無しで移動できなかった分は持ち越さない（次のミノで一度にまとめて移動させないため）
+    if (shift_ptr->shift_timer_us < 0)
+        shift_ptr->shift_timer_us = 0;
+    if (shift_ptr->drop_timer_us < 0)
+        shift_ptr->drop_timer_us = 0;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief リピート移動
+ * @param state_ptr ゲームコア演算状態
+ * @param timer_us_ptr 次の移動までの残り時間[us]
+ * @param interval_us 移動間隔[us]
+ * @param shift_x_level X方向の移動量
+ * @param shift_y_level Y方向の移動量
+ * @param repeat_max 1回の呼び出しでの最大移動回数
+ * @return true：1マス以上移動した
+ * @details 残り時間が0以下の間、移動と残り時間への移動間隔の加算を繰り返す（呼び出し周期より短い間隔にも対応する）
+ *          壁・ブロックに阻まれた場合は残り時間を0にして、次回呼び出しで再度移動を試みる
+ */
+static bool repeat_shift(TETRIS_CORE_state_t *state_ptr, int32_t *timer_us_ptr, uint32_t interval_us, int8_t shift_x_level, int8_t shift_y_level, uint8_t repeat_max)
+{
+    uint8_t repeat_count = 0;
+    while (*timer_us_ptr <= 0 && repeat_count < repeat_max)
+    {
+        if (tetris_core_shift_mino(state_ptr, shift_x_level, shift_y_level))
+        {
+            *timer_us_ptr = 0;
+            break;
+        }
+        *timer_us_ptr += (int32_t)interval_us;
+        repeat_count++;
+    }
+
+    return (0 < repeat_count);
+}
@@ -0,0 +1,91 @@
+/**
+ * @file   tetris_core_snapshot.c
+ * @brief  tetrisゲームコア・演算状態スナップショット実装
+ * @details 演算状態を固定長のリングに保存し、任意の世代に巻き戻す（練習モードのアンドゥ・リプレイのシーク等に使う）
+ *          演算状態は1ゲーム分の状態を全て構造体内に持ち、ポインタは定数テーブルのみを指すので、保存・復元は構造体コピー1回で済む
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris_core.h"
+#include "tetris_core_internal.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief スナップショットリング初期化
+ * @param ring_ptr スナップショットリング格納先
+ * @return なし
+ * @details 保存済みのスナップショットを全て破棄する。ゲーム開始時に呼ぶ
+ */
+void TETRIS_CORE_initialize_snapshot_ring(TETRIS_CORE_snapshot_ring_t *ring_ptr)
+{
+    ring_ptr->head = 0;
+    ring_ptr->count = 0;
+}
+
+/**
+ * @brief スナップショット保存
+ * @param ring_ptr スナップショットリング
+ * @param state_ptr 保存するゲームコア演算状態
+ * @param time_us 保存時刻[us]（時刻の基準は呼び出し側で決める）
+ * @return なし
+ * @details リングが一杯の場合は最も古いスナップショットを上書きする
+ */
+void TETRIS_CORE_save_snapshot(TETRIS_CORE_snapshot_ring_t *ring_ptr, const TETRIS_CORE_state_t *state_ptr, uint64_t time_us)
+{
+    TETRIS_CORE_snapshot_t *snapshot_ptr = &ring_ptr->entry[ring_ptr->head];
+
+    snapshot_ptr->state = *state_ptr;
+    snapshot_ptr->time_us = time_us;
+
+    ring_ptr->head = (ring_ptr->head + 1) % TETRIS_CORE_SNAPSHOT_RING_LENGTH;
+    if (ring_ptr->count < TETRIS_CORE_SNAPSHOT_RING_LENGTH)
+        ring_ptr->count++;
+}
+
+/**
+ * @brief スナップショット復元
+ * @param ring_ptr スナップショットリング
+ * @param generations_back 巻き戻す世代数（0：最新のスナップショット、1：その1つ前 ...）
+ * @param state_ptr 復元先のゲームコア演算状態
+ * @return 復元したスナップショット（指定世代が残っていない場合はNULLで、リング・演算状態とも変更しない）
+ * @details 指定世代より新しいスナップショットはリングから破棄し、復元したスナップショットが最新として残る
+ *          続けて呼べば同じ世代をやり直せ、さらに前の世代へも順に戻れる
+ */
+const TETRIS_CORE_snapshot_t *TETRIS_CORE_restore_snapshot(TETRIS_CORE_snapshot_ring_t *ring_ptr, uint8_t generations_back, TETRIS_CORE_state_t *state_ptr)
+{
+    if (ring_ptr->count <= generations_back)
+        return NULL;
+
+    ring_ptr->count -= generations_back;
+    ring_ptr->head = (ring_ptr->head + TETRIS_CORE_SNAPSHOT_RING_LENGTH - generations_back) % TETRIS_CORE_SNAPSHOT_RING_LENGTH;
+
+    const TETRIS_CORE_snapshot_t *snapshot_ptr = &ring_ptr->entry[(ring_ptr->head + TETRIS_CORE_SNAPSHOT_RING_LENGTH - 1) % TETRIS_CORE_SNAPSHOT_RING_LENGTH];
+    *state_ptr = snapshot_ptr->state;
+
+    return snapshot_ptr;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
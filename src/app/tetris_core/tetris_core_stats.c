@@ -0,0 +1,242 @@
+/**
+ * @file   tetris_core_stats.c
+ * @brief  tetrisゲームコア・プレイ統計（PPS・KPP・最少手順・消去種別）実装
+ * @details 入力の押下とミノの固定の度にカウンタを加算するだけで、盤面の走査やビットマップ処理は行わない（固定毎にO(1)）
+ *          最少手順（フィネス）は、固定位置に出現位置から空のフィールドで到達する最少入力数（回転・左右移動・ハードドロップ）と
+ *          実際の入力数の差を数える。左右移動は1回ずつの移動と、壁まで押しっぱなし（1入力）からの戻しのうち少ない方とする
+ *          高速落下・Tスピンを使ったミノは最少手順が定まらないため判定から除外する
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris_core.h"
+#include "tetris_core_internal.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define ONE_SECOND_US 1000000
+#define LEFT_COLUMN_BIT (1u << (TETRIS_CORE_MINO_LENGTH - 1)) // ミノ定義1行の左端の列
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+// 回転状態毎の最少回転入力数（右回転・左回転のみ。180°は2入力）
+static const uint8_t turn_input_count[r_3_turn + 1] = {0, 1, 2, 1};
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static uint8_t calculate_optimal_input(const TETRIS_CORE_mino_parameter_t *mino_ptr);
+static uint8_t get_column_mask(uint32_t mino_shape);
+static uint8_t get_left_column(uint8_t column_mask);
+static uint8_t get_right_column(uint8_t column_mask);
+static uint32_t normalize_shape(uint32_t mino_shape);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief 毎秒ミノ数（PPS）取得
+ * @param statistics_ptr プレイ統計
+ * @return 毎秒ミノ数×100（計測開始から最後のミノ固定までのゲーム経過時間で割る。固定前は0）
+ */
+uint32_t TETRIS_CORE_get_pieces_per_second_x100(const TETRIS_CORE_play_statistics_t *statistics_ptr)
+{
+    uint64_t elapsed_us = statistics_ptr->last_lock_time_us - statistics_ptr->start_time_us;
+    if (!elapsed_us)
+        return 0;
+
+    return (uint32_t)((uint64_t)statistics_ptr->piece_count * 100 * ONE_SECOND_US / elapsed_us);
+}
+
+/**
+ * @brief ミノあたり入力数（KPP）取得
+ * @param statistics_ptr プレイ統計
+ * @return ミノあたり入力数×100（固定前は0）
+ */
+uint32_t TETRIS_CORE_get_inputs_per_piece_x100(const TETRIS_CORE_play_statistics_t *statistics_ptr)
+{
+    if (!statistics_ptr->piece_count)
+        return 0;
+
+    return (uint32_t)((uint64_t)statistics_ptr->input_count * 100 / statistics_ptr->piece_count);
+}
+
+/**
+ * @brief プレイ統計初期化
+ * @param state_ptr ゲームコア演算状態
+ * @return なし
+ * @details ゲーム開始時と、演算状態の復元時（統計は保存しない）に呼ぶ。現在のゲーム経過時間から計測を始める
+ */
+void tetris_core_initialize_play_statistics(TETRIS_CORE_state_t *state_ptr)
+{
+    state_ptr->play_statistics = (TETRIS_CORE_play_statistics_t){0};
+    state_ptr->play_statistics.start_time_us = state_ptr->time_us;
+    state_ptr->play_statistics.last_lock_time_us = state_ptr->time_us;
+}
+
+/**
+ * @brief ミノ毎の統計開始
+ * @param state_ptr ゲームコア演算状態
+ * @return なし
+ * @details ミノ生成毎（ホールドからの生成を含む）に呼ぶ。最少手順はミノ毎に判定する
+ */
+void tetris_core_start_piece_statistics(TETRIS_CORE_state_t *state_ptr)
+{
+    state_ptr->play_statistics.piece_input_count = 0;
+    state_ptr->play_statistics.is_finesse_exempt = false;
+}
+
+/**
+ * @brief 入力数加算
+ * @param state_ptr ゲームコア演算状態
+ * @param is_finesse_exempt このミノを最少手順の判定から除外するか（高速落下の押下時true）
+ * @return なし
+ * @details 左右移動・高速落下は押下（方向の切替を含む）毎、回転・ハードドロップ・ホールドは受け付け毎に1回呼ぶ
+ *          押しっぱなしによるリピート移動は数えない
+ */
+void tetris_core_count_input(TETRIS_CORE_state_t *state_ptr, bool is_finesse_exempt)
+{
+    TETRIS_CORE_play_statistics_t *statistics_ptr = &state_ptr->play_statistics;
+
+    statistics_ptr->input_count++;
+    if (statistics_ptr->piece_input_count < UINT8_MAX)
+        statistics_ptr->piece_input_count++;
+    statistics_ptr->is_finesse_exempt |= is_finesse_exempt;
+}
+
+/**
+ * @brief ミノ固定時の統計更新
+ * @param state_ptr ゲームコア演算状態（固定前の操作ミノの位置であること）
+ * @param row_erased 今回の固定で消去した行数
+ * @param t_spin 今回の固定のTスピン種別
+ * @param is_hard_dropped ハードドロップで固定したか
+ * @return なし
+ */
+void tetris_core_update_play_statistics(TETRIS_CORE_state_t *state_ptr, uint8_t row_erased, TETRIS_CORE_t_spin_t t_spin, bool is_hard_dropped)
+{
+    TETRIS_CORE_play_statistics_t *statistics_ptr = &state_ptr->play_statistics;
+
+    statistics_ptr->piece_count++;
+    statistics_ptr->last_lock_time_us = state_ptr->time_us;
+    if (row_erased)
+    {
+        statistics_ptr->clear_count[(TETRIS_CORE_ERASE_ROW_MAX < row_erased) ? TETRIS_CORE_ERASE_ROW_MAX : row_erased]++;
+        if (t_spin_none != t_spin)
+            statistics_ptr->t_spin_clear_count++;
+    }
+
+    // 最少手順判定
+    if (statistics_ptr->is_finesse_exempt || t_spin_none != t_spin)
+        return;
+    uint8_t optimal_input = calculate_optimal_input(&state_ptr->mino_parameter) + (is_hard_dropped ? 1 : 0);
+    if (optimal_input < statistics_ptr->piece_input_count)
+        statistics_ptr->finesse_fault_count += statistics_ptr->piece_input_count - optimal_input;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief 最少入力数算出（回転・左右移動）
+ * @param mino_ptr ミノ演算パラメータ（固定位置）
+ * @return 出現位置から固定位置のブロック配置に到達する最少入力数（ハードドロップを除く）
+ * @details 固定位置と同じブロック配置になる回転状態（Iミノの縦2状態等）をそれぞれ試し、少ない方を採る（4状態分の定数時間）
+ */
+static uint8_t calculate_optimal_input(const TETRIS_CORE_mino_parameter_t *mino_ptr)
+{
+    uint32_t locked_shape = TETRIS_CORE_get_mino_shape(mino_ptr->mino_type, mino_ptr->turn_state);
+    uint32_t locked_normalized = normalize_shape(locked_shape);
+    int8_t spawn_x = tetris_core_get_spawn_reference_x(mino_ptr->mino_type);
+    uint8_t locked_left = get_left_column(get_column_mask(locked_shape));
+    uint8_t optimal_input = UINT8_MAX;
+
+    for (uint8_t turn = r_no_turn; turn <= r_3_turn; turn++)
+    {
+        uint32_t mino_shape = TETRIS_CORE_get_mino_shape(mino_ptr->mino_type, (TETRIS_CORE_mino_turn_state_t)turn);
+        if (normalize_shape(mino_shape) != locked_normalized)
+            continue;
+
+        // この回転状態で同じ配置になる基準点と、左右の壁に押し付けた時の基準点（ブロックの列はフィールドの1～FIELD_WIDTH）
+        uint8_t column_mask = get_column_mask(mino_shape);
+        int8_t target_x = mino_ptr->reference_x + locked_left - get_left_column(column_mask);
+        int8_t left_wall_x = 1 - get_left_column(column_mask);
+        int8_t right_wall_x = TETRIS_CORE_FIELD_WIDTH - get_right_column(column_mask);
+
+        int8_t tap_count = target_x - spawn_x;
+        tap_count = (tap_count < 0) ? -tap_count : tap_count;
+        int8_t das_left_count = 1 + (target_x - left_wall_x);
+        int8_t das_right_count = 1 + (right_wall_x - target_x);
+        int8_t shift_count = tap_count;
+        shift_count = (das_left_count < shift_count) ? das_left_count : shift_count;
+        shift_count = (das_right_count < shift_count) ? das_right_count : shift_count;
+
+        uint8_t input = turn_input_count[turn] + (uint8_t)shift_count;
+        optimal_input = (input < optimal_input) ? input : optimal_input;
+    }
+
+    return optimal_input;
+}
+
+/**
+ * @brief 列マスク取得
+ * @param mino_shape 5×5ミノ形状マスク
+ * @return ブロックのある列（bit4が左端の列）
+ */
+static uint8_t get_column_mask(uint32_t mino_shape)
+{
+    uint32_t column_mask = 0;
+    for (uint8_t mino_row = 0; mino_row < TETRIS_CORE_MINO_LENGTH; mino_row++)
+        column_mask |= mino_shape >> (TETRIS_CORE_MINO_LENGTH * mino_row);
+
+    return (uint8_t)(column_mask & TETRIS_CORE_MINO_ROW_MASK);
+}
+
+/**
+ * @brief 左端列取得
+ * @param column_mask 列マスク
+ * @return ブロックのある最も左の列（0～4）
+ */
+static uint8_t get_left_column(uint8_t column_mask)
+{
+    uint8_t column = 0;
+    while (column < TETRIS_CORE_MINO_LENGTH - 1 && !(column_mask & (LEFT_COLUMN_BIT >> column)))
+        column++;
+
+    return column;
+}
+
+/**
+ * @brief 右端列取得
+ * @param column_mask 列マスク
+ * @return ブロックのある最も右の列（0～4）
+ */
+static uint8_t get_right_column(uint8_t column_mask)
+{
+    uint8_t column = TETRIS_CORE_MINO_LENGTH - 1;
+    while (column && !(column_mask & (LEFT_COLUMN_BIT >> column)))
+        column--;
+
+    return column;
+}
+
+/**
+ * @brief 形状の正規化
+ * @param mino_shape 5×5ミノ形状マスク
+ * @return ブロックを左上に寄せた形状（平行移動で重なる形状は同じ値になる）
+ */
+static uint32_t normalize_shape(uint32_t mino_shape)
+{
+    // 上端の行が空の間は1行ずつ上に寄せ、左端から空の列の数だけ左に寄せる（空の列は全行で空なので隣の行にはみ出さない）
+    while (!(mino_shape >> (TETRIS_CORE_MINO_LENGTH * (TETRIS_CORE_MINO_LENGTH - 1))))
+        mino_shape <<= TETRIS_CORE_MINO_LENGTH;
+
+    return mino_shape << get_left_column(get_column_mask(mino_shape));
+}
@@ -84,4 +84,20 @@ int MATH_modulo(int dividend, int divisor)
 
         return dividend;
     }
+}
+
+/**
+ * @brief 1のビット数算出
+ * @details 分岐・テーブル無しの並列加算で数える（popcount命令の無いCortex-M0+向け）
+ *          ビットマップの空きマス数の集計等に使う
+ * @param value 対象値（下位32bitのみ有効）
+ * @return 1のビット数
+ */
+int MATH_count_bits(unsigned int value)
+{
+    value = value - ((value >> 1) & 0x55555555u);
+    value = (value & 0x33333333u) + ((value >> 2) & 0x33333333u);
+    value = (value + (value >> 4)) & 0x0F0F0F0Fu;
+
+    return (int)((value * 0x01010101u) >> 24);
 }
\ No newline at end of file
@@ -27,5 +27,6 @@
 //======================================================
 extern int MATH_split_digits(int array_dst[], int num);
 extern int MATH_modulo(int dividend, int divisor);
+extern int MATH_count_bits(unsigned int value);
 
 #endif /* __MATH_LIB_H__ */
\ No newline at end of file
@@ -117,6 +117,10 @@ extern I2C_read_status_t I2C_read_RX_bytes(uint8_t *dst_bytes, uint8_t dst_bytes
 extern I2C_read_status_t I2C_pop_RX(uint8_t *dst_bytes, uint8_t dst_bytes_len, I2C_ch_t ch);
 extern void I2C_send_TX_bytes_as_slave(uint8_t *send_bytes, uint8_t send_bytes_len, I2C_ch_t ch);
 extern void I2C_response_rd_request(uint8_t *send_bytes, uint8_t send_bytes_len, I2C_ch_t ch);
+extern void I2C_push_TX_stream_master(I2C_ch_t ch, uint8_t data, I2C_master_cmd_t master_cmd, I2C_condition_control_t condition);
+extern void I2C_flush_TX_stream(I2C_ch_t ch);
+extern bool I2C_check_TX_stream_busy(I2C_ch_t ch);
+extern void I2C_abort_TX_stream(I2C_ch_t ch);
 
 /* ops */
 extern uint8_t I2C_read_RX_fifo_level(I2C_ch_t ch);
@@ -8,6 +8,7 @@
 //======================================================
 #include "I2C.h"
 #include "I2C_internal.h"
+#include "dma.h"
 #include "bit.h"
 #include "typedef.h"
 
@@ -17,17 +18,42 @@
 #define READ_RX_BYTES_MAX 8
 #define READ_TX_BYTES_MAX 8
 
+// 送信ストリーム：マスター送信のIC_DATA_CMD書き込み値を溜めるリングバッファ。DMAでTX FIFOへ転送する
+#define TX_STREAM_LENGTH 512                                      // リングバッファ長[IC_DATA_CMD数]（2のべき乗）
+#define TX_STREAM_INDEX(count) ((count) & (TX_STREAM_LENGTH - 1)) // 累計数→バッファ内の位置
+#define TX_STREAM_DMA_CH(ch) ((DMA_ch_t)(ch))                     // 送信ストリームに使うDMAチャネル（I2Cチャネルと同じ番号）
+
 //======================================================
 // 型定義
 //======================================================
+/**
+ * @brief 送信ストリーム
+ * @details 累計数はオーバーフロー許容（差分のみ使う。65536はバッファ長の倍数なので位置もずれない）
+ *          書き込み・確定はメイン処理のみ、送信済みは転送停止中以外は割り込みのみが更新する
+ */
+typedef struct
+{
+    volatile uint16_t data_cmd[TX_STREAM_LENGTH]; /**< IC_DATA_CMD書き込み値（DMAが読むのでvolatile） */
+    uint16_t write_count;                         /**< 書き込んだ累計数 */
+    volatile uint16_t commit_count;               /**< 送信を確定した累計数（ここまでDMAで送ってよい） */
+    volatile uint16_t sent_count;                 /**< TX FIFOへ転送し終えた累計数 */
+    volatile uint16_t transfer_length;            /**< 転送中の区間の長さ */
+    volatile bool is_transferring;                /**< DMA転送中（完了割り込みで次の区間を続けて転送する） */
+} tx_stream_t;
 
 //======================================================
 // 変数・定数
 //======================================================
+static tx_stream_t tx_stream[2]; // I2Cチャネル毎の送信ストリーム
 
 //======================================================
 // プロトタイプ宣言
 //======================================================
+static uint16_t get_TX_stream_free_length(I2C_ch_t ch);
+static void start_TX_stream_transfer(I2C_ch_t ch);
+static void complete_TX_stream_transfer(I2C_ch_t ch);
+static void complete_TX_stream_transfer_I2C0();
+static void complete_TX_stream_transfer_I2C1();
 
 //======================================================
 // 公開関数定義
@@ -110,6 +136,173 @@ void I2C_send_TX_bytes_as_slave(uint8_t *send_bytes, uint8_t send_bytes_len, I2C
     }
 }
 
+/**
+ * @brief I2C マスター送信ストリーム1バイト書き込み
+ * @param ch 対象I2Cチャネル
+ * @param data 送信データ
+ * @param master_cmd マスター送信コマンド種別
+ * @param condition STOP/RESTART制御
+ * @return なし
+ * @details I2C_set_TX_FIFO_data_masterと同じ書き込み値をRAM上の送信ストリームに溜める（I2C_flush_TX_streamまで送信しない）
+ *          ストリームが一杯の場合は、溜まっている分を確定して空きができるまで待つ（TXアボート発生時は未送信分を捨てる）
+ */
+void I2C_push_TX_stream_master(I2C_ch_t ch, uint8_t data, I2C_master_cmd_t master_cmd, I2C_condition_control_t condition)
+{
+    tx_stream_t *stream_ptr = &tx_stream[ch];
+
+    if (!get_TX_stream_free_length(ch))
+    {
+        I2C_flush_TX_stream(ch);
+        while (!get_TX_stream_free_length(ch))
+        {
+            // TXアボート中はDMA転送が進まないことがあるので、未送信分を捨てて書き込む（アボートは呼び出し側で検出する）
+            if (I2C_read_TX_abrt(ch))
+                I2C_abort_TX_stream(ch);
+        }
+    }
+
+    stream_ptr->data_cmd[TX_STREAM_INDEX(stream_ptr->write_count)] = i2c_make_master_data_cmd(data, master_cmd, condition);
+    stream_ptr->write_count++;
+}
+
+/**
+ * @brief I2C 送信ストリーム送信開始
+ * @param ch 対象I2Cチャネル
+ * @return なし
+ * @details 書き込み済みの分を確定し、DMA転送が止まっていれば開始する（完了を待たずに返る）
+ *          転送中の場合は完了割り込みで確定した分が続けて転送されるので、ここでは何もしない
+ * @note 確定の更新→転送中判定の順で行う。判定時に転送中なら完了割り込みが新しい確定位置を見て続きを送り、
+ *       転送中でなければ完了割り込みは発生しないため、割り込み禁止無しで二重に開始することはない
+ */
+void I2C_flush_TX_stream(I2C_ch_t ch)
+{
+    tx_stream_t *stream_ptr = &tx_stream[ch];
+
+    stream_ptr->commit_count = stream_ptr->write_count;
+    if (!stream_ptr->is_transferring && stream_ptr->commit_count != stream_ptr->sent_count)
+        start_TX_stream_transfer(ch);
+}
+
+/**
+ * @brief I2C 送信ストリーム送信中判定
+ * @param ch 対象I2Cチャネル
+ * @return true: 未送信データあり, false: 書き込んだ全データをバス上に送信済み
+ * @details 未確定・DMA転送中の分に加え、TX FIFOに残っている分も送信中とみなす
+ */
+bool I2C_check_TX_stream_busy(I2C_ch_t ch)
+{
+    tx_stream_t *stream_ptr = &tx_stream[ch];
+
+    return stream_ptr->is_transferring || (stream_ptr->write_count != stream_ptr->sent_count) || (0 != I2C_read_TX_fifo_level(ch));
+}
+
+/**
+ * @brief I2C 送信ストリーム破棄
+ * @param ch 対象I2Cチャネル
+ * @return なし
+ * @details DMA転送を中止し、未送信のデータを全て捨てる。TXアボート発生後、送り直す前に呼ぶ
+ */
+void I2C_abort_TX_stream(I2C_ch_t ch)
+{
+    tx_stream_t *stream_ptr = &tx_stream[ch];
+
+    DMA_abort_transfer(TX_STREAM_DMA_CH(ch));
+    stream_ptr->is_transferring = false;
+    stream_ptr->commit_count = stream_ptr->write_count;
+    stream_ptr->sent_count = stream_ptr->write_count;
+}
+
+/**
+ * @brief I2C 送信ストリーム初期化
+ * @param ch 対象I2Cチャネル
+ * @return なし
+ * @details 送信ストリームに使うDMAチャネルの完了コールバックを登録し、完了割り込みを有効にする
+ */
+void i2c_initialize_TX_stream(I2C_ch_t ch)
+{
+    DMA_callback_func_pointer_t callback_func = (I2C0 == ch) ? (DMA_callback_func_pointer_t)complete_TX_stream_transfer_I2C0 : (DMA_callback_func_pointer_t)complete_TX_stream_transfer_I2C1;
+
+    DMA_set_complete_callback_function(callback_func, TX_STREAM_DMA_CH(ch));
+    DMA_enable_complete_interrupt(true, TX_STREAM_DMA_CH(ch));
+}
+
 //======================================================
 // 内部関数定義
 //======================================================
+/**
+ * @brief 送信ストリーム空き数取得
+ * @param ch 対象I2Cチャネル
+ * @return 書き込み可能なIC_DATA_CMD数
+ */
+static uint16_t get_TX_stream_free_length(I2C_ch_t ch)
+{
+    tx_stream_t *stream_ptr = &tx_stream[ch];
+
+    return TX_STREAM_LENGTH - (uint16_t)(stream_ptr->write_count - stream_ptr->sent_count);
+}
+
+/**
+ * @brief 送信ストリームDMA転送開始
+ * @param ch 対象I2Cチャネル
+ * @return なし
+ * @details 送信済みの位置から確定位置までを転送する。バッファ末尾で折り返す場合は末尾までを転送し、残りは完了割り込みで続ける
+ *          転送先はIC_DATA_CMD固定で、TX FIFOに空きがある時だけ1つずつ書き込まれる（16bit転送。上位16bitには同じ値が複製されるが無視される）
+ */
+static void start_TX_stream_transfer(I2C_ch_t ch)
+{
+    tx_stream_t *stream_ptr = &tx_stream[ch];
+    uint16_t index = TX_STREAM_INDEX(stream_ptr->sent_count);
+    uint16_t length = stream_ptr->commit_count - stream_ptr->sent_count;
+
+    if (TX_STREAM_LENGTH - index < length)
+        length = TX_STREAM_LENGTH - index;
+
+    DMA_transfer_config_t config = {
+        .read_address = &stream_ptr->data_cmd[index],
+        .write_address = i2c_get_data_cmd_address(ch),
+        .transfer_count = length,
+        .transfer_size = transfer_size_16bit,
+        .is_read_increment = true,
+        .is_write_increment = false,
+        .treq = (I2C0 == ch) ? treq_I2C0_TX : treq_I2C1_TX,
+    };
+
+    stream_ptr->transfer_length = length;
+    stream_ptr->is_transferring = true;
+    DMA_start_transfer(&config, TX_STREAM_DMA_CH(ch));
+}
+
+/**
+ * @brief 送信ストリームDMA転送完了処理
+ * @param ch 対象I2Cチャネル
+ * @return なし
+ * @details 割り込みから呼ばれる。転送した区間を送信済みにし、確定済みの続きがあれば続けて転送する
+ */
+static void complete_TX_stream_transfer(I2C_ch_t ch)
+{
+    tx_stream_t *stream_ptr = &tx_stream[ch];
+
+    stream_ptr->sent_count += stream_ptr->transfer_length;
+    if (stream_ptr->commit_count != stream_ptr->sent_count)
+        start_TX_stream_transfer(ch);
+    else
+        stream_ptr->is_transferring = false;
+}
+
+/**
+ * @brief I2C0送信ストリームDMA完了コールバック関数
+ * @return なし
+ */
+static void complete_TX_stream_transfer_I2C0()
+{
+    complete_TX_stream_transfer(I2C0);
+}
+
+/**
+ * @brief I2C1送信ストリームDMA完了コールバック関数
+ * @return なし
+ */
+static void complete_TX_stream_transfer_I2C1()
+{
+    complete_TX_stream_transfer(I2C1);
+}
@@ -13,6 +13,7 @@
 //======================================================
 // マクロ定義
 //======================================================
+#define TX_DMA_REQUEST_LEVEL 4 // TX FIFOの格納数がこの値以下の間、送信ストリームのDMAに転送を要求する
 
 //======================================================
 // 型定義
@@ -78,6 +79,10 @@ static void initialize_master_mode(I2C_config_t config)
     // spike除去 (optional)
     I2Cn_IC_FS_SPKLEN(config.ch) = 1; // 10ns抑制など（条件により異なる）
 
+    // 送信ストリーム（DMAでTX FIFOへ書き込む）の設定
+    i2c_enable_TX_DMA(config.ch, TX_DMA_REQUEST_LEVEL);
+    i2c_initialize_TX_stream(config.ch);
+
     // I2Cを有効化
     i2c_set_enable(config.ch, ENABLE);
 }
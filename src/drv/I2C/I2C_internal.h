@@ -32,9 +32,15 @@ extern void i2c_select_master_or_slave(I2C_ch_t ch, I2C_mode_t mode);
 extern void i2c_set_speed(I2C_ch_t ch, I2C_speed_t speed);
 extern void i2c_set_addressing_mode(I2C_ch_t ch, I2C_mode_t mode, I2C_addressing_mode_t addressing_mode);
 extern void i2c_set_default_address(I2C_ch_t ch, I2C_mode_t mode, uint16_t default_address);
+extern void i2c_enable_TX_DMA(I2C_ch_t ch, uint8_t request_level);
+
+/* init → ctrl */
+extern void i2c_initialize_TX_stream(I2C_ch_t ch);
 
 /* ctrl → ops */
 extern void i2c_clear_rd_req(I2C_ch_t ch);
 extern bool i2c_check_rd_req(I2C_ch_t ch);
+extern uint16_t i2c_make_master_data_cmd(uint8_t data, I2C_master_cmd_t master_cmd, I2C_condition_control_t condition);
+extern volatile uint32_t *i2c_get_data_cmd_address(I2C_ch_t ch);
 
 #endif /* __I2C_INTERNAL_H__ */
\ No newline at end of file
@@ -93,24 +93,8 @@ bool I2C_check_TX_fifo_full(I2C_ch_t ch)
  */
 void I2C_set_TX_FIFO_data_master(I2C_ch_t ch, uint8_t data, I2C_master_cmd_t master_cmd, I2C_condition_control_t condition)
 {
-    bool stop_enable = false;
-    bool restart_enable = false;
-
-    if (stop_condition == condition || restart_and_stop_condition == condition)
-    {
-        stop_enable = true;
-    }
-    if (restart_condition == condition || restart_and_stop_condition == condition)
-    {
-        restart_enable = true;
-    }
-
     // 送信データ生成
-    uint16_t write_data = 0x0000;
-    write_data |= (data << 0);
-    write_data |= (master_cmd << 8);
-    write_data |= (stop_enable << 9);
-    write_data |= (restart_enable << 10);
+    uint16_t write_data = i2c_make_master_data_cmd(data, master_cmd, condition);
 
     // バッファ空き確認→送信
     while (I2C_check_TX_fifo_full(ch))
@@ -173,6 +157,18 @@ void i2c_set_enable(I2C_ch_t ch, bool is_enable)
     I2Cn_IC_ENABLE(ch) = (I2Cn_IC_ENABLE(ch) & ~(MASK_1BIT << 0)) | (is_enable << 0);
 }
 
+/**
+ * @brief I2C 送信DMA要求有効化
+ * @param ch 対象I2Cチャネル
+ * @param request_level DMA要求レベル（TX FIFOの格納数がこの値以下の間、DMAに転送を要求する）
+ * @return なし
+ */
+void i2c_enable_TX_DMA(I2C_ch_t ch, uint8_t request_level)
+{
+    I2Cn_IC_DMA_TDLR(ch) = (request_level & MASK_4BIT);
+    I2Cn_IC_DMA_CR(ch) = (I2Cn_IC_DMA_CR(ch) & ~(MASK_1BIT << 1)) | (1 << 1); // TDMAE：送信DMA有効
+}
+
 /**
  * @brief I2C マスター/スレーブモード設定
  * @param ch 対象I2Cチャネル
@@ -265,6 +261,46 @@ bool i2c_check_rd_req(I2C_ch_t ch)
     return ((I2Cn_IC_RAW_INTR_STAT(ch) >> 5) & MASK_1BIT); // trueで要求あり
 }
 
+/**
+ * @brief I2C マスター送信データ生成
+ * @param data 送信データ
+ * @param master_cmd マスター送信コマンド種別
+ * @param condition STOP/RESTART制御
+ * @return IC_DATA_CMDレジスタへの書き込み値
+ */
+uint16_t i2c_make_master_data_cmd(uint8_t data, I2C_master_cmd_t master_cmd, I2C_condition_control_t condition)
+{
+    bool stop_enable = false;
+    bool restart_enable = false;
+
+    if (stop_condition == condition || restart_and_stop_condition == condition)
+    {
+        stop_enable = true;
+    }
+    if (restart_condition == condition || restart_and_stop_condition == condition)
+    {
+        restart_enable = true;
+    }
+
+    uint16_t write_data = 0x0000;
+    write_data |= (data << 0);
+    write_data |= (master_cmd << 8);
+    write_data |= (stop_enable << 9);
+    write_data |= (restart_enable << 10);
+
+    return write_data;
+}
+
+/**
+ * @brief I2C 送受信データレジスタアドレス取得
+ * @param ch 対象I2Cチャネル
+ * @return IC_DATA_CMDレジスタのアドレス（DMAの転送先に使う）
+ */
+volatile uint32_t *i2c_get_data_cmd_address(I2C_ch_t ch)
+{
+    return &I2Cn_IC_DATA_CMD(ch);
+}
+
 //======================================================
 // 内部関数定義
 //======================================================
\ No newline at end of file
@@ -0,0 +1,103 @@
+/**
+ * @file   dma.h
+ * @brief  DMAコンポーネント・外部公開定義
+ * @details メモリ→ペリフェラル等の転送をCPUを介さずに行う。転送完了はDMA_IRQ_0割り込みからコールバックで通知する
+ */
+
+#ifndef __DMA_H__
+#define __DMA_H__
+
+//======================================================
+// インクルード
+//======================================================
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define DMA_CH_NUMBER 12 // DMAチャネル数
+
+//======================================================
+// 型定義
+//======================================================
+/**
+ * @brief DMAチャネル
+ */
+typedef enum
+{
+    DMA_CH0 = 0,
+    DMA_CH1,
+    DMA_CH2,
+    DMA_CH3,
+    DMA_CH4,
+    DMA_CH5,
+    DMA_CH6,
+    DMA_CH7,
+    DMA_CH8,
+    DMA_CH9,
+    DMA_CH10,
+    DMA_CH11,
+} DMA_ch_t;
+
+/**
+ * @brief 1回の転送サイズ
+ */
+typedef enum
+{
+    transfer_size_8bit = 0,
+    transfer_size_16bit,
+    transfer_size_32bit,
+} DMA_transfer_size_t;
+
+/**
+ * @brief 転送要求（DREQ）選択
+ * @details 転送先・転送元のペリフェラルが受け付け可能な時だけ1回ずつ転送する
+ * @note 参照：RP2040データシート 2.5.3.1 System DREQ Table
+ */
+typedef enum
+{
+    treq_I2C0_TX = 32,   /**< I2C0送信FIFO */
+    treq_I2C0_RX = 33,   /**< I2C0受信FIFO */
+    treq_I2C1_TX = 34,   /**< I2C1送信FIFO */
+    treq_I2C1_RX = 35,   /**< I2C1受信FIFO */
+    treq_permanent = 63, /**< 転送要求を待たずに連続転送（メモリ間転送用） */
+} DMA_treq_t;
+
+/**
+ * @brief DMA転送設定
+ */
+typedef struct
+{
+    const volatile void *read_address; /**< 転送元アドレス */
+    volatile void *write_address;      /**< 転送先アドレス */
+    uint32_t transfer_count;           /**< 転送回数（転送サイズ単位） */
+    DMA_transfer_size_t transfer_size; /**< 1回の転送サイズ */
+    bool is_read_increment;            /**< 転送毎に転送元アドレスを進める */
+    bool is_write_increment;           /**< 転送毎に転送先アドレスを進める */
+    DMA_treq_t treq;                   /**< 転送要求 */
+} DMA_transfer_config_t;
+
+/**
+ * @brief DMAコールバック関数設定用ポインタ
+ * @details 外部コンポーネントが転送完了コールバック関数を登録する際、関数ポインタをこの型にキャストして渡させる
+ */
+typedef void (*DMA_callback_func_pointer_t)();
+
+//======================================================
+// グローバル変数・定数extern宣言
+//======================================================
+
+//======================================================
+// グローバル関数extern宣言
+//======================================================
+/* init */
+extern void DMA_initialize();
+
+/* ops */
+extern void DMA_start_transfer(const DMA_transfer_config_t *config_ptr, DMA_ch_t ch);
+extern bool DMA_check_busy(DMA_ch_t ch);
+extern void DMA_abort_transfer(DMA_ch_t ch);
+extern void DMA_enable_complete_interrupt(bool is_enable, DMA_ch_t ch);
+extern void DMA_set_complete_callback_function(DMA_callback_func_pointer_t callback_func, DMA_ch_t ch);
+
+#endif /* __DMA_H__ */
@@ -0,0 +1,50 @@
+/**
+ * @file   dma_init.c
+ * @brief  DMAコンポーネント・初期化実装
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "dma.h"
+#include "dma_internal.h"
+#include "interrupt.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief  DMA機能初期化
+ * @return なし
+ * @note 現状は割り込みハンドラへのコールバック関数登録のみ。DMAの固定コールバック関数をDMA_IRQ_0のコールバック関数に登録している
+ *       外部関数のコールバック関数登録は別途必要。DMA_set_complete_callback_functionから行うこと
+ *       コールバックの流れは以下
+ *       ・転送完了で割り込み発生
+ *       ・DMA_IRQ_0_Handler がコールバック
+ *       ・dma_irq0_interrupt_callback がコールバック（割り込みが発生したチャネル毎に以下を呼ぶ）
+ *       ・DMA_set_complete_callback_functionで登録された外部関数 がコールバック
+ */
+void DMA_initialize()
+{
+    INTERRUPT_set_callback_function((INTERRUPT_callback_func_pointer_t)dma_irq0_interrupt_callback, DMA_IRQ_0);
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
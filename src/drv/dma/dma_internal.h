@@ -0,0 +1,32 @@
+/**
+ * @file   dma_internal.h
+ * @brief  DMAコンポーネント・内部公開定義
+ */
+
+#ifndef __DMA_INTERNAL_H__
+#define __DMA_INTERNAL_H__
+
+//======================================================
+// インクルード
+//======================================================
+#include "dma.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// グローバル変数・定数extern宣言
+//======================================================
+
+//======================================================
+// グローバル関数extern宣言
+//======================================================
+/* init → ops */
+extern void dma_irq0_interrupt_callback();
+
+#endif /* __DMA_INTERNAL_H__ */
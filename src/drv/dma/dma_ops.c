@@ -0,0 +1,145 @@
+/**
+ * @file   dma_ops.c
+ * @brief  DMAコンポーネント・レジスタ操作実装
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "dma.h"
+#include "dma_internal.h"
+#include "register.h"
+#include "interrupt.h"
+#include "bit.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define CTRL_BUSY_BIT 24 // CTRLレジスタ：転送中フラグ
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+static DMA_callback_func_pointer_t dma_callback_func_list[DMA_CH_NUMBER] = {NULL};
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief  DMA転送開始
+ * @param  config_ptr 転送設定
+ * @param  ch 使用するDMAチャネル
+ * @return なし
+ * @details 転送元・転送先・転送回数を設定し、制御レジスタの書き込みで転送を開始する（完了を待たずに返る）
+ *          チェーン転送は使わない（CHAIN_TOには自チャネルを設定する）
+ * @note 転送元のデータは転送完了まで書き換えないこと
+ */
+void DMA_start_transfer(const DMA_transfer_config_t *config_ptr, DMA_ch_t ch)
+{
+    uint32_t ctrl = 0;
+    ctrl |= (1 << 0);                                           // EN：チャネル有効
+    ctrl |= ((config_ptr->transfer_size & MASK_2BIT) << 2);     // DATA_SIZE
+    ctrl |= (config_ptr->is_read_increment << 4);               // INCR_READ
+    ctrl |= (config_ptr->is_write_increment << 5);              // INCR_WRITE
+    ctrl |= ((ch & MASK_4BIT) << 11);                           // CHAIN_TO：自チャネル（チェーン無し）
+    ctrl |= ((config_ptr->treq & MASK_6BIT) << 15);             // TREQ_SEL
+
+    DMA_CHn_READ_ADDR(ch) = (uint32_t)config_ptr->read_address;
+    DMA_CHn_WRITE_ADDR(ch) = (uint32_t)config_ptr->write_address;
+    DMA_CHn_TRANS_COUNT(ch) = config_ptr->transfer_count;
+    DMA_CHn_CTRL_TRIG(ch) = ctrl; // 書き込みで転送開始
+}
+
+/**
+ * @brief  DMA転送中判定
+ * @param  ch DMAチャネル
+ * @return true: 転送中, false: 転送完了または未使用
+ */
+bool DMA_check_busy(DMA_ch_t ch)
+{
+    return (bool)((DMA_CHn_CTRL_TRIG(ch) >> CTRL_BUSY_BIT) & MASK_1BIT);
+}
+
+/**
+ * @brief  DMA転送中止
+ * @param  ch DMAチャネル
+ * @return なし
+ * @details 転送中の場合は中止が完了するまで待つ。中止した転送の完了割り込みは発生させない
+ * @note RP2040は中止時にも完了割り込みが立つことがある（データシート Errata RP2040-E13）ため、
+ *       中止の間は割り込みを無効にし、割り込み状態をクリアしてから元に戻す
+ */
+void DMA_abort_transfer(DMA_ch_t ch)
+{
+    uint32_t inte = DMA_INTE0;
+
+    DMA_INTE0 = inte & ~(MASK_1BIT << ch);
+    DMA_CHAN_ABORT = (1 << ch);
+    while ((DMA_CHAN_ABORT >> ch) & MASK_1BIT)
+    {
+        /* 中止待ち */
+    }
+    DMA_INTS0 = (1 << ch);
+    DMA_INTE0 = inte;
+}
+
+/**
+ * @brief  DMA転送完了割り込み有効無効設定
+ * @param  is_enable 設定内容（有効or無効）
+ * @param  ch DMAチャネル
+ * @return なし
+ * @details 全チャネルの完了割り込みをDMA_IRQ_0にまとめる
+ */
+void DMA_enable_complete_interrupt(bool is_enable, DMA_ch_t ch)
+{
+    DMA_INTE0 = ((DMA_INTE0 & ~(MASK_1BIT << ch)) | (is_enable << ch));
+    INTERRUPT_enable_IRQn(DMA_IRQ_0);
+}
+
+/**
+ * @brief  DMA転送完了コールバック関数登録
+ * @details 転送が完了した際にコールバックさせる関数を登録する
+ *          完了割り込みが発生した時はまずdma_irq0_interrupt_callbackが呼ばれ、
+ *          その内部で本関数で登録されたコールバック関数が呼ばれる
+ * @param  callback_func 登録コールバック関数
+ * @param  ch DMAチャネル
+ * @return なし
+ */
+void DMA_set_complete_callback_function(DMA_callback_func_pointer_t callback_func, DMA_ch_t ch)
+{
+    dma_callback_func_list[ch] = callback_func;
+}
+
+/**
+ * @brief  DMA_IRQ_0コールバック関数
+ * @return なし
+ * @details 完了割り込みが立っているチャネル毎に、割り込みフラグをクリアしてから登録されたコールバック関数を呼ぶ
+ *          （コールバック内で同じチャネルの次の転送を開始してもよい）
+ */
+void dma_irq0_interrupt_callback()
+{
+    uint32_t status = DMA_INTS0;
+
+    for (uint8_t ch = 0; ch < DMA_CH_NUMBER; ch++)
+    {
+        if (!((status >> ch) & MASK_1BIT))
+            continue;
+
+        DMA_INTS0 = (1 << ch); // 割り込みフラグクリア
+
+        if (dma_callback_func_list[ch] != NULL)
+            dma_callback_func_list[ch]();
+    }
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
@@ -0,0 +1,41 @@
+/**
+ * @file   flash.h
+ * @brief  FLASHコンポーネント・外部公開定義
+ * @details 外付けQSPIフラッシュ（プログラム格納領域と共用）の消去・書き込み・読み出し
+ */
+
+#ifndef __FLASH_H__
+#define __FLASH_H__
+
+//======================================================
+// インクルード
+//======================================================
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define FLASH_TOTAL_SIZE (2 * 1024 * 1024) // フラッシュ容量[byte]（Raspberry Pi Pico搭載品：2MB）
+#define FLASH_SECTOR_SIZE 4096             // 消去単位[byte]
+#define FLASH_PAGE_SIZE 256                // 書き込み単位[byte]
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// グローバル変数・定数extern宣言
+//======================================================
+
+//======================================================
+// グローバル関数extern宣言
+//======================================================
+/* init */
+extern void FLASH_initialize();
+
+/* ops */
+extern void FLASH_erase_sector(uint32_t flash_offset);
+extern void FLASH_program_page(uint32_t flash_offset, const uint8_t *data);
+extern const uint8_t *FLASH_get_read_address(uint32_t flash_offset);
+
+#endif /* __FLASH_H__ */
@@ -0,0 +1,45 @@
+/**
+ * @file   flash_init.c
+ * @brief  FLASHコンポーネント・初期化実装
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "flash.h"
+#include "flash_internal.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief  flash機能初期化
+ * @return なし
+ * @note 消去・書き込みに使うブートROM関数の検索と、XIP復帰用のboot2のRAMへの退避を行う
+ *       boot2はXIPが有効な間にしか読めないため、最初の消去・書き込みより前に呼ぶこと
+ */
+void FLASH_initialize()
+{
+    flash_load_rom_function();
+    flash_save_boot2();
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
@@ -0,0 +1,33 @@
+/**
+ * @file   flash_internal.h
+ * @brief  FLASHコンポーネント・内部公開定義
+ */
+
+#ifndef __FLASH_INTERNAL_H__
+#define __FLASH_INTERNAL_H__
+
+//======================================================
+// インクルード
+//======================================================
+#include "flash.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// グローバル変数・定数extern宣言
+//======================================================
+
+//======================================================
+// グローバル関数extern宣言
+//======================================================
+/* init → ops */
+extern void flash_load_rom_function();
+extern void flash_save_boot2();
+
+#endif /* __FLASH_INTERNAL_H__ */
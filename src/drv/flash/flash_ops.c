@@ -0,0 +1,196 @@
+/**
+ * @file   flash_ops.c
+ * @brief  FLASHコンポーネント・操作実装
+ * @details 消去・書き込みはブートROMのフラッシュ関数で行う
+ *          実行中はXIPが使えない（プログラムをフラッシュから読めない）ため、ROM関数を呼ぶ区間はRAMに配置した関数で実行し、
+ *          割り込みも禁止する。終了後はRAMに退避したboot2を実行して高速読み出しのXIP設定に戻す
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "flash.h"
+#include "flash_internal.h"
+#include "register.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define ROM_CODE(c1, c2) ((c1) | ((c2) << 8)) // ブートROMテーブルの関数コード（2文字）
+
+#define BOOT2_SIZE_WORDS 64          // boot2のサイズ[word]（フラッシュ先頭256byte）
+#define FLASH_BLOCK_SIZE (64 * 1024) // ブロック消去単位[byte]（セクタ単位の消去では使われない）
+#define FLASH_BLOCK_ERASE_CMD 0xD8   // ブロック消去コマンド
+
+// RAM配置関数（XIP停止中に実行するため、リンク時にRAMへ配置されるセクションに置く）
+#define RAM_FUNCTION __attribute__((noinline, section(".time_critical.flash")))
+
+//======================================================
+// 型定義
+//======================================================
+typedef void *(*rom_table_lookup_fn_t)(const uint16_t *table, uint32_t code);
+typedef void (*rom_void_fn_t)(void);
+typedef void (*rom_range_erase_fn_t)(uint32_t addr, size_t count, uint32_t block_size, uint8_t block_cmd);
+typedef void (*rom_range_program_fn_t)(uint32_t addr, const uint8_t *data, size_t count);
+
+/**
+ * @brief ブートROM フラッシュ関数
+ */
+typedef struct
+{
+    rom_void_fn_t connect_internal_flash; /**< QSPIピンをフラッシュに接続 */
+    rom_void_fn_t exit_xip;               /**< XIPを止めてシリアルコマンドを受け付ける状態にする */
+    rom_range_erase_fn_t range_erase;     /**< 範囲消去 */
+    rom_range_program_fn_t range_program; /**< 範囲書き込み */
+    rom_void_fn_t flush_cache;            /**< XIPキャッシュ破棄 */
+} flash_rom_function_t;
+
+//======================================================
+// 変数・定数
+//======================================================
+static flash_rom_function_t rom_function;     // RAM上に保持（XIP停止中に参照するため）
+static uint32_t boot2_copy[BOOT2_SIZE_WORDS]; // XIP復帰用boot2の退避先
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static void RAM_FUNCTION erase_sector_from_ram(uint32_t flash_offset);
+static void RAM_FUNCTION program_page_from_ram(uint32_t flash_offset, const uint8_t *data);
+static void RAM_FUNCTION enter_xip_from_ram();
+static inline uint32_t disable_interrupts();
+static inline void restore_interrupts(uint32_t primask);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief  セクタ消去
+ * @param  flash_offset 消去するセクタのフラッシュ先頭からのオフセット（FLASH_SECTOR_SIZE境界）
+ * @return なし
+ * @note 消去が終わるまで（数十ms）割り込みを禁止してRAM上で待つ。呼び出し側で実行タイミングを選ぶこと
+ */
+void FLASH_erase_sector(uint32_t flash_offset)
+{
+    uint32_t primask = disable_interrupts();
+    erase_sector_from_ram(flash_offset);
+    restore_interrupts(primask);
+}
+
+/**
+ * @brief  ページ書き込み
+ * @param  flash_offset 書き込むページのフラッシュ先頭からのオフセット（FLASH_PAGE_SIZE境界）
+ * @param  data 書き込みデータ（FLASH_PAGE_SIZE byte、RAM上にあること）
+ * @return なし
+ * @note 書き込みは1→0方向のみ変化するので、書き換えない範囲は0xFFを渡せば消去済みのまま残る
+ *       書き込みが終わるまで（1ms程度）割り込みを禁止する
+ */
+void FLASH_program_page(uint32_t flash_offset, const uint8_t *data)
+{
+    uint32_t primask = disable_interrupts();
+    program_page_from_ram(flash_offset, data);
+    restore_interrupts(primask);
+}
+
+/**
+ * @brief  読み出しアドレス取得
+ * @param  flash_offset フラッシュ先頭からのオフセット
+ * @return XIP領域上の読み出しアドレス
+ * @note 読み出しはXIP経由のメモリアクセスで行う（消去・書き込み後はキャッシュ破棄済み）
+ */
+const uint8_t *FLASH_get_read_address(uint32_t flash_offset)
+{
+    return (const uint8_t *)(XIP_BASE + flash_offset);
+}
+
+/**
+ * @brief  ブートROM関数検索
+ * @return なし
+ */
+void flash_load_rom_function()
+{
+    rom_table_lookup_fn_t rom_table_lookup = (rom_table_lookup_fn_t)(uintptr_t)ROM_TABLE_LOOKUP;
+    const uint16_t *rom_func_table = (const uint16_t *)(uintptr_t)ROM_FUNC_TABLE;
+
+    rom_function.connect_internal_flash = (rom_void_fn_t)rom_table_lookup(rom_func_table, ROM_CODE('I', 'F'));
+    rom_function.exit_xip = (rom_void_fn_t)rom_table_lookup(rom_func_table, ROM_CODE('E', 'X'));
+    rom_function.range_erase = (rom_range_erase_fn_t)rom_table_lookup(rom_func_table, ROM_CODE('R', 'E'));
+    rom_function.range_program = (rom_range_program_fn_t)rom_table_lookup(rom_func_table, ROM_CODE('R', 'P'));
+    rom_function.flush_cache = (rom_void_fn_t)rom_table_lookup(rom_func_table, ROM_CODE('F', 'C'));
+}
+
+/**
+ * @brief  boot2退避
+ * @return なし
+ * @note boot2はフラッシュ先頭256byteに置かれたXIP設定プログラム。XIP経由で読んでRAMにコピーする
+ */
+void flash_save_boot2()
+{
+    const uint32_t *boot2 = (const uint32_t *)XIP_BASE;
+
+    for (uint8_t i = 0; i < BOOT2_SIZE_WORDS; i++)
+        boot2_copy[i] = boot2[i];
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief  セクタ消去（RAM上で実行）
+ * @param  flash_offset 消去するセクタのオフセット
+ * @return なし
+ */
+static void RAM_FUNCTION erase_sector_from_ram(uint32_t flash_offset)
+{
+    rom_function.connect_internal_flash();
+    rom_function.exit_xip();
+    rom_function.range_erase(flash_offset, FLASH_SECTOR_SIZE, FLASH_BLOCK_SIZE, FLASH_BLOCK_ERASE_CMD);
+    rom_function.flush_cache();
+    enter_xip_from_ram();
+}
+
+/**
+ * @brief  ページ書き込み（RAM上で実行）
+ * @param  flash_offset 書き込むページのオフセット
+ * @param  data 書き込みデータ
+ * @return なし
+ */
+static void RAM_FUNCTION program_page_from_ram(uint32_t flash_offset, const uint8_t *data)
+{
+    rom_function.connect_internal_flash();
+    rom_function.exit_xip();
+    rom_function.range_program(flash_offset, data, FLASH_PAGE_SIZE);
+    rom_function.flush_cache();
+    enter_xip_from_ram();
+}
+
+/**
+ * @brief  XIP復帰（RAM上で実行）
+ * @return なし
+ * @note 退避したboot2を実行する（Thumb命令なのでアドレスの最下位bitを立てて呼ぶ）
+ */
+static void RAM_FUNCTION enter_xip_from_ram()
+{
+    ((rom_void_fn_t)((uintptr_t)boot2_copy + 1))();
+}
+
+/**
+ * @brief  割り込み禁止
+ * @return 禁止前のPRIMASK値
+ */
+static inline uint32_t disable_interrupts()
+{
+    uint32_t primask;
+    __asm volatile("mrs %0, PRIMASK\n\tcpsid i" : "=r"(primask)::"memory");
+    return primask;
+}
+
+/**
+ * @brief  割り込み許可状態復元
+ * @param  primask 禁止前のPRIMASK値
+ * @return なし
+ */
+static inline void restore_interrupts(uint32_t primask)
+{
+    __asm volatile("msr PRIMASK, %0" ::"r"(primask) : "memory");
+}
@@ -14,6 +14,9 @@
 // 各種ベースアドレス定義
 //======================================================
 #define ROM_VECTOR_TABLE_BASE  0x00000000 // ベクタテーブル初期値　ROMへの配置なので、割り込み用に書き換えるためにはRAMへのコピー必須
+#define ROM_FUNC_TABLE_PTR     0x00000014 // ブートROM関数テーブルへのポインタ（16bit）
+#define ROM_TABLE_LOOKUP_PTR   0x00000018 // ブートROMテーブル検索関数へのポインタ（16bit）
+#define XIP_BASE               0x10000000 // 外付けフラッシュのXIP（メモリマップド読み出し）領域
 #define CLOCKS_BASE            0x40008000
 #define RESETS_BASE            0x4000C000
 #define IO_BANK0_BASE          0x40014000
@@ -24,6 +27,7 @@
 #define ADC_BASE               0x4004c000
 #define TIMER_BASE             0x40054000
 #define WATCHDOG_BASE          0x40058000
+#define DMA_BASE               0x50000000
 #define PPB_BASE               0xe0000000
 #define SIO_BASE               0xD0000000
 
@@ -16,6 +16,7 @@
 // 汎用マクロ
 //======================================================
 #define VOLATILE_ACCESS(address)      (*(volatile uint32_t *)(address))
+#define VOLATILE_ACCESS_16(address)   (*(volatile uint16_t *)(address))
 
 //======================================================
 // GPIO関連レジスタ定義
@@ -108,6 +109,27 @@
 
 #define WATCHDOG_TICK     VOLATILE_ACCESS(WATCHDOG_BASE + 0x2c) // ウォッチドッグ＆タイマー用ティック設定
 
+//======================================================
+// DMA関連レジスタ定義
+//======================================================
+#define DMA_CHn_BASE(n)         (DMA_BASE + 0x40 * (n))                  // チャネルnのレジスタ先頭
+#define DMA_CHn_READ_ADDR(n)    VOLATILE_ACCESS(DMA_CHn_BASE(n) + 0x00) // 転送元アドレス
+#define DMA_CHn_WRITE_ADDR(n)   VOLATILE_ACCESS(DMA_CHn_BASE(n) + 0x04) // 転送先アドレス
+#define DMA_CHn_TRANS_COUNT(n)  VOLATILE_ACCESS(DMA_CHn_BASE(n) + 0x08) // 転送回数
+#define DMA_CHn_CTRL_TRIG(n)    VOLATILE_ACCESS(DMA_CHn_BASE(n) + 0x0C) // 転送制御（書き込みで転送開始）
+#define DMA_CHn_AL1_CTRL(n)     VOLATILE_ACCESS(DMA_CHn_BASE(n) + 0x10) // 転送制御（書き込んでも転送開始しない）
+
+#define DMA_INTR                VOLATILE_ACCESS(DMA_BASE + 0x400) // 割り込み要因（チャネル毎の転送完了）
+#define DMA_INTE0               VOLATILE_ACCESS(DMA_BASE + 0x404) // DMA_IRQ_0割り込み有効化
+#define DMA_INTS0               VOLATILE_ACCESS(DMA_BASE + 0x40C) // DMA_IRQ_0割り込み状態（1書き込みでクリア）
+#define DMA_CHAN_ABORT          VOLATILE_ACCESS(DMA_BASE + 0x444) // チャネル転送中止（中止完了で0に戻る）
+
+//======================================================
+// ブートROM関連定義
+//======================================================
+#define ROM_FUNC_TABLE    VOLATILE_ACCESS_16(ROM_FUNC_TABLE_PTR)   // ブートROM関数テーブルのアドレス
+#define ROM_TABLE_LOOKUP  VOLATILE_ACCESS_16(ROM_TABLE_LOOKUP_PTR) // ブートROMテーブル検索関数のアドレス
+
 //======================================================
 // interrput関連レジスタ定義
 //======================================================
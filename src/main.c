@@ -11,6 +11,8 @@
 #include "interrupt.h"
 #include "timer.h"
 #include "I2C.h"
+#include "dma.h"
+#include "flash.h"
 #include "button.h"
 #include "debug_com.h"
 #include "analogStick.h"
@@ -44,9 +46,11 @@ void main(void)
     /* ドライバ層初期化 */
     GPIO_initialize(gpioPin_func_list, gpioPin_dir_list); // GPIO初期化
     ADC_initialize(adc_ch_config, adc_parameter_config);  // ADC初期化
-    I2C_initialize(config_I2C0_display);                  // I2C初期化（ch0）
+    DMA_initialize();                                     // DMA初期化
+    I2C_initialize(config_I2C0_display);                  // I2C初期化（ch0、送信ストリーム用DMAの設定を含む）
     TIMER_initialize();                                   // タイマー初期化
     INTERRUPT_initialize();                               // 割り込み初期化
+    FLASH_initialize();                                   // フラッシュ初期化
 
     /* ミドル層初期化 */
     BUTTON_class_t B_button = BUTTON_initialize_instance(config_B_button);                    // ボタン初期化
@@ -41,10 +41,12 @@ typedef struct
 extern void SH1107_initialize(const SH1107_config_t config_SH1107);
 
 /* ops */
+extern uint32_t SH1107_get_sent_byte_count();
 
 /* ctrl */
 extern bool SH1107_display_bitmap_data(bitmap_128_t bitmap);
 extern bool SH1107_display_bitmap_all_data(bitmap_128_t bitmap);
 extern bool SH1107_display_bitmap_updated_data(bitmap_128_t current_bitmap, bitmap_128_t previous_bitmap);
+extern bool SH1107_display_bitmap_area_data(bitmap_128_t bitmap, uint8_t column, uint8_t row, uint8_t width, uint8_t height);
 
 #endif /* __SH1107_H__ */
\ No newline at end of file
@@ -20,6 +20,13 @@
 #define PAGE_LENGTH   16  // ディスプレイのページ数（1ページ8行 = 行数は128）
 // clang-format on
 
+// 同じページ内で次の変化列までの未変化列がこの数以下なら、未変化列も再送して1回の連続書き込みにまとめる
+// 連続書き込みを分けると、リスタート時のスレーブアドレス・列アドレス指定2コマンド（各コントロールバイト付き）・データ開始のコントロールバイトの6byteが増える
+// （ホストの表示バス計測ツールtetris_wireでは閾値を比べるためにビルド時に上書きできる）
+#ifndef BURST_MERGE_GAP
+#define BURST_MERGE_GAP 6
+#endif
+
 //======================================================
 // 型定義
 //======================================================
@@ -27,11 +34,16 @@
 //======================================================
 // 変数・定数
 //======================================================
+static bitmap_128_t sent_bitmap = {0}; // 前回送信したビットマップ（差分描画・領域描画で共有する）
 
 //======================================================
 // プロトタイプ宣言
 //======================================================
 static void initialize_entire_display();
+static bool send_updated_area(bitmap_128_t current_bitmap, bitmap_128_t previous_bitmap, uint8_t page_first, uint8_t page_last, uint8_t column_first, uint8_t column_last);
+static void send_RAM_burst(const uint8_t page_bytes[], uint8_t page, bool is_page_selected, uint8_t column_first, uint8_t column_last);
+static uint8_t get_page_byte(bitmap_128_t bitmap, uint8_t page, uint8_t column);
+static void copy_sent_area(bitmap_128_t bitmap, uint8_t row_first, uint8_t row_last, uint8_t column_first, uint8_t column_last);
 
 //======================================================
 // 公開関数定義
@@ -55,7 +67,7 @@ void sh1107_execute_startup_sequence()
     sh1107_send_command(command_14B, 0x01010000); // 周波数設定（現状初期値）
 
     // ディスプレイ初期化：★50ms必要(400Kbpsでの理論値は40.96ms)
-    initialize_entire_display(); // 関数内でwaitがかかるので明示的waitは不要
+    initialize_entire_display(); // 送信ストリーム上でディスプレイ起動より前にバスへ送られるので明示的waitは不要
 
     // ディスプレイ起動：★100ms必要
     sh1107_send_control_byte(continuous_control, command_operation);
@@ -65,6 +77,9 @@ void sh1107_execute_startup_sequence()
     SH1107_select_i2c_condition(stop_condition);
     sh1107_send_control_byte(continuous_control, command_operation); // ダミー送信(stop conditionを認識させるため)
 
+    // ディスプレイ起動コマンドまで送り終えてから待つ
+    sh1107_wait_TX_stream();
+
     // データシート指定の最小wait時間（Tetrisアプリではこの初期化後の次回通信は100ms以内に開始されるため、明示的に待つ必要あり）
     TIMER_wait_ms(100);
 }
@@ -76,24 +91,60 @@ void sh1107_execute_startup_sequence()
  * @details 送信したビットマップを毎回内部で保持し、次回送信時はそのビットマップと今回描画したいビットマップとの差分のみを送信する
  *          送信失敗した場合、次回は描画したいビットマップ全体を送信する。でないとディスプレイの描画内容が不整合になるため
  *          これにより正しい描画を行いつつ通信時間を低減している。尚、差分送信と全体送信は別関数で実装している
+ *          送信はDMAで行い完了を待たずに返るので、前回送信の失敗は次回の呼び出しで検出する
  */
 bool SH1107_display_bitmap_data(bitmap_128_t bitmap)
 {
-    static bitmap_128_t previous_bitmap = {0}; // 前回送信したビットマップ
-    bool is_success;                           // 送信バッファ書き込み中にエラーが出た場合false
+    bool is_success; // 送信バッファ書き込み中にエラーが出た場合false
+
+    if (I2C_read_TX_abrt(0)) // 前回送信が正常終了したかをチェック
+    {
+        // 前回送信失敗時：未送信分を捨てて画面全体を描画し直す。sent_bitmapは参照しない
+        I2C_abort_TX_stream(0);
+        I2C_clear_TX_abrt(0);
+        is_success = SH1107_display_bitmap_all_data(bitmap);
+        BITMAP_copy(sent_bitmap, bitmap);
+    }
+    else
+    {
+        // 前回送信成功時：差分のみ描画。初回送信時にはsent_bitmapのオール0に対する差分描画になる（遅延あるが誤差なので許容）
+        is_success = SH1107_display_bitmap_updated_data(bitmap, sent_bitmap);
+        BITMAP_copy(sent_bitmap, bitmap);
+    }
+
+    return is_success;
+}
+
+/**
+ * @brief 128x128ビットマップ領域描画
+ * @param bitmap 描画対象ビットマップ
+ * @param column 描画領域の左端の列
+ * @param row 描画領域の上端の行
+ * @param width 描画領域の幅（列数、1以上）
+ * @param height 描画領域の高さ（行数、1以上）
+ * @return 描画成功時true、失敗時false
+ * @details 指定領域を含むページの、指定列の範囲だけを前回送信したビットマップと比較し、差分のみ送信する
+ *          領域外は比較もしないので、領域外を変更していないことが分かっている場合（タイマの数字のみの更新など）に使う
+ *          前回送信が失敗していた場合は、SH1107_display_bitmap_dataと同様に画面全体を描画し直す
+ */
+bool SH1107_display_bitmap_area_data(bitmap_128_t bitmap, uint8_t column, uint8_t row, uint8_t width, uint8_t height)
+{
+    bool is_success; // 送信バッファ書き込み中にエラーが出た場合false
 
     if (I2C_read_TX_abrt(0)) // 前回送信が正常終了したかをチェック
     {
-        // 前回送信失敗時：画面全体を描画し直す。previous_bitmapは参照しない
+        I2C_abort_TX_stream(0);
         I2C_clear_TX_abrt(0);
         is_success = SH1107_display_bitmap_all_data(bitmap);
-        BITMAP_copy(previous_bitmap, bitmap);
+        BITMAP_copy(sent_bitmap, bitmap);
     }
     else
     {
-        // 前回送信成功時：差分のみ描画。初回送信時にはprevious_bitmapのオール0に対する差分描画になる（遅延あるが誤差なので許容）
-        is_success = SH1107_display_bitmap_updated_data(bitmap, previous_bitmap);
-        BITMAP_copy(previous_bitmap, bitmap);
+        uint8_t page_first = row / 8;
+        uint8_t page_last = (row + height - 1) / 8;
+        uint8_t column_last = column + width - 1;
+        is_success = send_updated_area(bitmap, sent_bitmap, page_first, page_last, column, column_last);
+        copy_sent_area(bitmap, page_first * 8, page_last * 8 + 7, column, column_last);
     }
 
     return is_success;
@@ -104,7 +155,7 @@ bool SH1107_display_bitmap_data(bitmap_128_t bitmap)
  * @param bitmap 描画対象ビットマップ
  * @return 描画成功時true、失敗時false
  * @details ビットマップの内容によらず、受け取ったビットマップ全体をディスプレイに送信する
- *          差分送信は一切行わない
+ *          差分送信は一切行わない。全体は送信ストリームに収まらないので、空きができるまで待ちながら書き込む
  */
 bool SH1107_display_bitmap_all_data(bitmap_128_t bitmap)
 {
@@ -137,11 +188,6 @@ bool SH1107_display_bitmap_all_data(bitmap_128_t bitmap)
                 send_data |= ((BITMAP_read(bitmap, page * 8 + bit, column)) << bit); // 描画ビット列生成
             }
 
-            while (I2C_read_TX_fifo_level(sh1107_internal_state.assign_I2C_ch) > 2) // バッファが詰まっている状態で更にバッファに突っ込むと破綻するので待つ 2という数値は適当
-            {
-                // 送信待ち
-            }
-
             // RAMデータ送信
             sh1107_send_RAM_operation(send_data);
         }
@@ -159,7 +205,8 @@ bool SH1107_display_bitmap_all_data(bitmap_128_t bitmap)
     if (I2C_read_TX_abrt(sh1107_internal_state.assign_I2C_ch))
         return false;
 
-    // 正常終了
+    // 送信開始（完了は待たない）
+    sh1107_flush_TX_stream();
     return true;
 }
 
@@ -172,90 +219,173 @@ bool SH1107_display_bitmap_all_data(bitmap_128_t bitmap)
  */
 bool SH1107_display_bitmap_updated_data(bitmap_128_t current_bitmap, bitmap_128_t previous_bitmap)
 {
-    // リスタート
-    SH1107_select_i2c_condition(restart_condition);
+    return send_updated_area(current_bitmap, previous_bitmap, 0, PAGE_LENGTH - 1, 0, COLUMN_LENGTH - 1);
+}
 
-    // ディスプレイIC側で選択されている列アドレス（この関数がコールされる前に列アドレスが0以外に設定されてるとバグるので注意）
-    // ただし、送信失敗時にはSH1107_display_bitmap_dataでディスプレイ全体を再描画するのでそれは起こらない（はず）
-    uint8_t column_IC = 0;
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief ディスプレイ全消灯初期化
+ * @return なし
+ * @details 初期化シーケンス用に全体描画で消灯する。
+ *          初期化前RAM状態が不定のため差分描画は使用しない
+ */
+static void initialize_entire_display()
+{
+    bitmap_128_t initial_bitmap = {0};
+    SH1107_display_bitmap_all_data(initial_bitmap);
+}
 
-    for (uint8_t page = 0; page < 16; page++)
+/**
+ * @brief 128x128ビットマップ差分描画（領域指定）
+ * @param current_bitmap 現在ビットマップ
+ * @param previous_bitmap 前回ビットマップ
+ * @param page_first 比較する先頭ページ
+ * @param page_last 比較する最終ページ
+ * @param column_first 比較する先頭列
+ * @param column_last 比較する最終列
+ * @return 描画成功時true、失敗時false
+ * @details 指定したページ・列の範囲内で、previous_bitmapからcurrent_bitmapへの差分のみ送信する
+ *          ページ毎に変化した列を連続区間にまとめ（間の未変化列がBURST_MERGE_GAP以下なら再送してつなげる）、
+ *          区間毎に列アドレスを指定して1回の連続書き込み（コントロールバイトはデータ開始の1byteのみ）で送信する
+ *          変化の無いページはページ指定も送らず、差分が全く無ければ何も送信しない
+ *          送信ストリームに書き込んだ後DMAで送信を開始し、完了を待たずに返る
+ */
+static bool send_updated_area(bitmap_128_t current_bitmap, bitmap_128_t previous_bitmap, uint8_t page_first, uint8_t page_last, uint8_t column_first, uint8_t column_last)
+{
+    for (uint8_t page = page_first; page <= page_last; page++)
     {
-        // ページ指定
-        sh1107_send_control_byte(continuous_control, command_operation);
-        sh1107_send_command(command_12, CMD12_PAGEn_ADDRESS(page));
+        // ページ内の各列の送信データと差分有無
+        uint8_t page_bytes[COLUMN_LENGTH];
+        bool is_changed[COLUMN_LENGTH];
+        for (uint8_t column = column_first; column <= column_last; column++)
+        {
+            page_bytes[column] = get_page_byte(current_bitmap, page, column);
+            is_changed[column] = (page_bytes[column] != get_page_byte(previous_bitmap, page, column));
+        }
 
-        // 列毎の操作：前回送信と今回送信のビットマップの各列を比較し、差分がある場合のみ送信を行う
-        for (uint8_t column = 0; column < COLUMN_LENGTH; column++)
+        // 変化した列の連続区間毎に送信
+        bool is_page_selected = false; // このページのページ指定を送信済み（IC側のページアドレスは次の指定まで保持される）
+        uint8_t column = column_first;
+        while (column <= column_last)
         {
-            /* バイト間の差分チェック */
-            uint8_t current_byte = 0x00;
-            uint8_t previous_byte = 0x00;
-            for (uint8_t bit = 0; bit < 8; bit++)
+            if (!is_changed[column])
             {
-                current_byte |= ((BITMAP_read(current_bitmap, page * 8 + bit, column)) << bit);
-                previous_byte |= ((BITMAP_read(previous_bitmap, page * 8 + bit, column)) << bit);
+                column++;
+                continue;
             }
 
-            // 差分ありの場合→バイトRAMデータ送信
-            if (!(current_byte == previous_byte))
+            // 区間の終端：次の変化列までの未変化列が少なければ区間を延ばす
+            uint8_t burst_first = column;
+            uint8_t burst_last = column;
+            for (uint8_t next = column + 1; next <= column_last && next - burst_last - 1 <= BURST_MERGE_GAP; next++)
             {
-                while (I2C_read_TX_fifo_level(sh1107_internal_state.assign_I2C_ch) > 2) // バッファが詰まっている状態で更にバッファに突っ込むと破綻するので待つ 2という数値は適当
-                {
-                    // 送信待ち
-                }
-
-                // 列アドレス設定　※連続する列にデータ送信する場合は不要なので処理されない
-                if ((column != column_IC))
-                {
-                    sh1107_send_control_byte(continuous_control, command_operation);
-                    sh1107_send_command(command_1, CMD1_COLUMNn_LOWER_ADDRESS(column));
-                    sh1107_send_control_byte(continuous_control, command_operation);
-                    sh1107_send_command(command_2, CMD2_COLUMNn_HIGHER_ADDRESS(column));
-                }
-
-                // RAMデータ送信
-                sh1107_send_control_byte(continuous_control, RAM_operation);
-                sh1107_send_RAM_operation(current_byte);
-
-                // 送信後、IC側の指定Columnアドレスは自動で+1される
-                column_IC = (column + 1) % COLUMN_LENGTH;
+                if (is_changed[next])
+                    burst_last = next;
             }
 
+            send_RAM_burst(page_bytes, page, is_page_selected, burst_first, burst_last);
+            is_page_selected = true;
+
             // 送信バッファ書き込みに失敗したら即リターン
             if (I2C_read_TX_abrt(sh1107_internal_state.assign_I2C_ch))
                 return false;
+
+            column = burst_last + 1;
         }
     }
-    // 次送信のために列アドレス設定をクリアしておく
+
+    // 送信開始（各連続書き込みの最終バイトでstop conditionを設定済み。完了は待たない）
+    sh1107_flush_TX_stream();
+    return true;
+}
+
+/**
+ * @brief RAMデータ連続書き込み
+ * @param page_bytes ページ内の各列の送信データ
+ * @param page 書き込むページ
+ * @param is_page_selected ページ指定を送信済みか（同じページの2区間目以降はページ指定を省く）
+ * @param column_first 書き込む先頭列
+ * @param column_last 書き込む最終列
+ * @return なし
+ * @details リスタートからページ・列アドレスを指定し、データ開始のコントロールバイト（last_control）に続けて区間のRAMデータを送り、
+ *          最終バイトでstop conditionを送信する（以降は全てRAMデータと解釈されるので、次の区間はリスタートから始める）
+ *          送信後、IC側の列アドレスは区間の次の列を指しているが、書き込みは毎回列アドレスを指定するので戻さない
+ */
+static void send_RAM_burst(const uint8_t page_bytes[], uint8_t page, bool is_page_selected, uint8_t column_first, uint8_t column_last)
+{
+    // リスタート
+    SH1107_select_i2c_condition(restart_condition);
+
+    // ページ・列アドレス指定
+    if (!is_page_selected)
+    {
+        sh1107_send_control_byte(continuous_control, command_operation);
+        sh1107_send_command(command_12, CMD12_PAGEn_ADDRESS(page));
+    }
     sh1107_send_control_byte(continuous_control, command_operation);
-    sh1107_send_command(command_1, CMD1_COLUMNn_LOWER_ADDRESS(0));
+    sh1107_send_command(command_1, CMD1_COLUMNn_LOWER_ADDRESS(column_first));
     sh1107_send_control_byte(continuous_control, command_operation);
-    sh1107_send_command(command_2, CMD2_COLUMNn_HIGHER_ADDRESS(0));
+    sh1107_send_command(command_2, CMD2_COLUMNn_HIGHER_ADDRESS(column_first));
 
-    // 全データ送信後はstop conditionを送信
-    SH1107_select_i2c_condition(stop_condition);
-    sh1107_send_control_byte(continuous_control, command_operation); // ダミー送信(stop conditionを認識させるため)
+    // 区間のRAMデータを連続送信（送信後、IC側の列アドレスは自動で+1される）
+    sh1107_send_control_byte(last_control, RAM_operation);
+    for (uint8_t column = column_first; column <= column_last; column++)
+    {
+        if (column == column_last)
+            SH1107_select_i2c_condition(stop_condition); // 区間の最終バイトで通信を終える
+        sh1107_send_RAM_operation(page_bytes[column]);
+    }
+}
 
-    // 最後にも念のため送信アボートを見ておく
-    if (I2C_read_TX_abrt(sh1107_internal_state.assign_I2C_ch))
-        return false;
+/**
+ * @brief ページ1列分の送信データ取得
+ * @param bitmap ビットマップ
+ * @param page ページ
+ * @param column 列
+ * @return ページ内の8行分のドット（bit0がページの最上行）
+ */
+static uint8_t get_page_byte(bitmap_128_t bitmap, uint8_t page, uint8_t column)
+{
+    uint8_t word = column / 64;
+    uint8_t shift = 63 - column % 64;
+    uint8_t page_byte = 0x00;
 
-    // 正常終了
-    return true;
+    for (uint8_t bit = 0; bit < 8; bit++)
+    {
+        page_byte |= (uint8_t)((bitmap[page * 8 + bit][word] >> shift) & 1) << bit;
+    }
+
+    return page_byte;
 }
 
-//======================================================
-// 内部関数定義
-//======================================================
 /**
- * @brief ディスプレイ全消灯初期化
+ * @brief 送信済みビットマップ領域更新
+ * @param bitmap 送信したビットマップ
+ * @param row_first 更新する先頭行
+ * @param row_last 更新する最終行
+ * @param column_first 更新する先頭列
+ * @param column_last 更新する最終列
  * @return なし
- * @details 初期化シーケンス用に全体描画で消灯する。
- *          初期化前RAM状態が不定のため差分描画は使用しない
+ * @details 領域描画で送信した範囲のみ、前回送信したビットマップに反映する（範囲外の列は元の値を残す）
  */
-static void initialize_entire_display()
+static void copy_sent_area(bitmap_128_t bitmap, uint8_t row_first, uint8_t row_last, uint8_t column_first, uint8_t column_last)
 {
-    bitmap_128_t initial_bitmap = {0};
-    SH1107_display_bitmap_all_data(initial_bitmap);
-}
\ No newline at end of file
+    // 列範囲のマスク（bit63が各64列の左端）
+    uint64_t mask[2];
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        int16_t first = column_first - i * 64;
+        int16_t last = column_last - i * 64;
+        first = (first < 0) ? 0 : first;
+        last = (63 < last) ? 63 : last;
+        mask[i] = (last < first) ? 0 : ((~(uint64_t)0 >> first) & (~(uint64_t)0 << (63 - last)));
+    }
+
+    for (uint8_t row = row_first; row <= row_last; row++)
+    {
+        sent_bitmap[row][0] = (sent_bitmap[row][0] & ~mask[0]) | (bitmap[row][0] & mask[0]);
+        sent_bitmap[row][1] = (sent_bitmap[row][1] & ~mask[1]) | (bitmap[row][1] & mask[1]);
+    }
+}
@@ -99,6 +99,8 @@ typedef struct
 {
     I2C_ch_t assign_I2C_ch;                /**< 割り当てI2Cチャネル */
     I2C_condition_control_t I2C_condition; /**< I2Cコンディション制御値 */
+    bool is_stopped;                       /**< ストップコンディション送信済み（次の送信でスタートコンディションとスレーブアドレスが送られる） */
+    uint32_t sent_byte_count;              /**< バス上に送信したバイト数の累計（スレーブアドレスを含む。オーバーフロー許容） */
 } sh1107_internal_state_t;
 
 //======================================================
@@ -117,6 +119,8 @@ extern void sh1107_execute_startup_sequence();
 extern void sh1107_send_control_byte(sh1107_control_byte_option_t Co, sh1107_data_byte_option_t DC);
 extern void sh1107_send_command(sh1107_command_table_t command, uint32_t variable_data);
 extern void sh1107_send_RAM_operation(uint8_t RAM_data);
+extern void sh1107_flush_TX_stream();
+extern void sh1107_wait_TX_stream();
 extern void SH1107_select_i2c_condition(I2C_condition_control_t condition);
 extern uint32_t sh1107_get_column_address_lower_variable(uint8_t column_address);
 extern uint32_t sh1107_get_column_address_higher_variable(uint8_t column_address);
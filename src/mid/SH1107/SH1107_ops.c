@@ -64,11 +64,13 @@ const static uint32_t command_base_bit[] = {
 sh1107_internal_state_t sh1107_internal_state = {
     // 初期値を入れておく　chはSH1107_initの方で設定
     .I2C_condition = no_condition,
+    .is_stopped = true,
 };
 
 //======================================================
 // プロトタイプ宣言
 //======================================================
+static void send_byte(uint8_t data);
 static void reset_I2C_condition();
 static void execute_auto_control();
 
@@ -86,8 +88,7 @@ void sh1107_send_control_byte(sh1107_control_byte_option_t Co, sh1107_data_byte_
     uint8_t control_byte = 0;
     control_byte |= (Co << 7) | (DC << 6);
 
-    I2C_set_TX_FIFO_data_master(sh1107_internal_state.assign_I2C_ch, control_byte, master_write, sh1107_internal_state.I2C_condition); // master_writeは固定
-    reset_I2C_condition();
+    send_byte(control_byte);
 }
 
 /**
@@ -125,8 +126,7 @@ void sh1107_send_command(sh1107_command_table_t command, uint32_t variable_data)
         }
     }
 
-    I2C_set_TX_FIFO_data_master(sh1107_internal_state.assign_I2C_ch, finalized_command, master_write, sh1107_internal_state.I2C_condition); // master_writeは固定
-    reset_I2C_condition();
+    send_byte(finalized_command);
 }
 
 /**
@@ -137,8 +137,35 @@ void sh1107_send_command(sh1107_command_table_t command, uint32_t variable_data)
  */
 void sh1107_send_RAM_operation(uint8_t RAM_data)
 {
-    I2C_set_TX_FIFO_data_master(sh1107_internal_state.assign_I2C_ch, RAM_data, master_write, sh1107_internal_state.I2C_condition); // master_writeは固定
-    reset_I2C_condition();
+    send_byte(RAM_data);
+}
+
+/**
+ * @brief SH1107送信開始
+ * @return なし
+ * @details 送信ストリームに溜めたデータの送信をDMAで開始する（完了を待たずに返る）
+ *          描画関数の終わりに呼び、ディスプレイへの送信中もCPUは次のフレームの演算を進められるようにする
+ */
+void sh1107_flush_TX_stream()
+{
+    I2C_flush_TX_stream(sh1107_internal_state.assign_I2C_ch);
+}
+
+/**
+ * @brief SH1107送信完了待ち
+ * @return なし
+ * @details 送信ストリームに書き込んだデータがすべてバス上に送られるまで待つ（未送信分は送信を開始してから待つ）
+ *          TXアボートが発生した場合は残りが送られないので待たずに返る
+ */
+void sh1107_wait_TX_stream()
+{
+    I2C_ch_t ch = sh1107_internal_state.assign_I2C_ch;
+
+    I2C_flush_TX_stream(ch);
+    while (I2C_check_TX_stream_busy(ch) && !I2C_read_TX_abrt(ch))
+    {
+        // 送信待ち
+    }
 }
 
 /**
@@ -164,6 +191,16 @@ void SH1107_select_i2c_condition(I2C_condition_control_t condition)
     sh1107_internal_state.I2C_condition = condition;
 }
 
+/**
+ * @brief 送信バイト数取得
+ * @return 起動からバス上に送信したバイト数の累計（スタート・リスタート毎のスレーブアドレスを含む。オーバーフロー許容）
+ * @details 呼び出し側で前後の差を取り、フレーム毎の通信量を測る
+ */
+uint32_t SH1107_get_sent_byte_count()
+{
+    return sh1107_internal_state.sent_byte_count;
+}
+
 /**
  * @brief Column Address下位変数生成
  * @param column_address 列アドレス
@@ -221,6 +258,26 @@ uint32_t sh1107_get_page_address_variable(uint8_t page_num)
 //======================================================
 // 内部関数定義
 //======================================================
+/**
+ * @brief SH1107 1バイト送信
+ * @param data 送信データ（コントロールバイト・コマンド・RAMデータ）
+ * @return なし
+ * @details 設定中のコンディションで送信ストリームに書き込み、コンディションをリセットする（送信はsh1107_flush_TX_streamでまとめて開始する）
+ *          スタート・リスタート時はスレーブアドレスも送られるので、その分も送信バイト数に数える
+ */
+static void send_byte(uint8_t data)
+{
+    I2C_condition_control_t condition = sh1107_internal_state.I2C_condition;
+
+    I2C_push_TX_stream_master(sh1107_internal_state.assign_I2C_ch, data, master_write, condition); // master_writeは固定
+
+    bool is_started = sh1107_internal_state.is_stopped || (restart_condition == condition) || (restart_and_stop_condition == condition);
+    sh1107_internal_state.sent_byte_count += is_started ? 2 : 1;
+    sh1107_internal_state.is_stopped = (stop_condition == condition) || (restart_and_stop_condition == condition);
+
+    reset_I2C_condition();
+}
+
 /**
  * @brief SH1107 I2Cコンディションリセット
  * @return なし
@@ -0,0 +1,95 @@
+/**
+ * @file   tetris_curve.h
+ * @brief  tetris難易度曲線解析ツール・外部公開定義
+ * @details 難易度テーブル（自由落下係数・スコア倍率・レベルアップ必要行数）とプレイヤーの腕前モデルの全組み合わせで
+ *          多数のゲームをモンテカルロ実行し、レベル到達時間・レベル毎の生存時間・スコア分散を集計する
+ */
+
+#ifndef __TETRIS_CURVE_H__
+#define __TETRIS_CURVE_H__
+
+//======================================================
+// インクルード
+//======================================================
+#include "typedef.h"
+#include "tetris_core.h"
+#include "tetris_sim.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define TETRIS_CURVE_NAME_LENGTH 32 // 難易度テーブル名・腕前モデル名の最大文字数（終端含む）
+#define TETRIS_CURVE_TABLES_MAX 64  // 一度に比較できる難易度テーブル数の上限
+
+//======================================================
+// 型定義
+//======================================================
+/**
+ * @brief 難易度テーブル（名前付き）定義
+ */
+typedef struct
+{
+    char name[TETRIS_CURVE_NAME_LENGTH]; /**< テーブル名（CSV出力用） */
+    TETRIS_CORE_difficulty_t difficulty; /**< 難易度テーブル */
+} TETRIS_CURVE_table_t;
+
+/**
+ * @brief 腕前モデル定義
+ */
+typedef struct
+{
+    const char *name;           /**< モデル名（CSV出力用） */
+    TETRIS_SIM_policy_t policy; /**< 入力ポリシー（自動操作の反応時間・配置ミス率等で腕前を表す） */
+} TETRIS_CURVE_skill_t;
+
+/**
+ * @brief 解析実行設定定義
+ * @details 解析セル（難易度テーブル×腕前モデル）毎にgames_per_cellゲームを実行する
+ *          ゲームiのシードはセルに関わらずbase_seed + i（同じミノ順で比較し、テーブル間の差を見やすくするため）
+ */
+typedef struct
+{
+    const TETRIS_CURVE_table_t *tables; /**< 難易度テーブル配列 */
+    uint32_t number_of_tables;          /**< 難易度テーブル数 */
+    const TETRIS_CURVE_skill_t *skills; /**< 腕前モデル配列 */
+    uint32_t number_of_skills;          /**< 腕前モデル数 */
+    uint32_t games_per_cell;            /**< 解析セル毎のゲーム数 */
+    uint32_t number_of_threads;         /**< ワーカスレッド数 */
+    uint32_t base_seed;                 /**< シードの基準値 */
+    uint32_t frame_limit;               /**< 1ゲームの最大フレーム数 */
+} TETRIS_CURVE_config_t;
+
+/**
+ * @brief 解析セル集計結果定義
+ * @details 和・二乗和で持ち、スレッド毎の集計結果を足し合わせるだけでマージできるようにする
+ */
+typedef struct
+{
+    uint64_t games;                                                /**< ゲーム数 */
+    uint64_t game_over;                                            /**< ゲームオーバーで終了したゲーム数 */
+    double frames_sum;                                             /**< プレイフレーム数の和 */
+    double score_sum;                                              /**< スコアの和 */
+    double score_square_sum;                                       /**< スコアの二乗和 */
+    double rows_sum;                                               /**< 合計消去行数の和 */
+    uint64_t reached[TETRIS_CORE_MAXIMUM_LEVEL + 1];               /**< レベル毎の到達ゲーム数 */
+    double reach_frames_sum[TETRIS_CORE_MAXIMUM_LEVEL + 1];        /**< レベル毎の到達フレーム数の和 */
+    double reach_frames_square_sum[TETRIS_CORE_MAXIMUM_LEVEL + 1]; /**< レベル毎の到達フレーム数の二乗和 */
+    double stay_frames_sum[TETRIS_CORE_MAXIMUM_LEVEL + 1];         /**< レベル毎の滞在フレーム数の和 */
+    uint64_t game_over_in_level[TETRIS_CORE_MAXIMUM_LEVEL + 1];    /**< レベル毎のゲームオーバー数 */
+} TETRIS_CURVE_statistics_t;
+
+//======================================================
+// グローバル変数・定数extern宣言
+//======================================================
+
+//======================================================
+// グローバル関数extern宣言
+//======================================================
+/* run */
+extern int TETRIS_CURVE_run(const TETRIS_CURVE_config_t *config_ptr, TETRIS_CURVE_statistics_t *statistics, uint32_t *scores);
+
+/* table */
+extern void TETRIS_CURVE_initialize_table(TETRIS_CURVE_table_t *table_ptr, const char *name);
+extern int TETRIS_CURVE_load_tables(const char *path, TETRIS_CURVE_table_t *tables, uint32_t tables_max, uint32_t *number_of_tables_ptr);
+
+#endif /* __TETRIS_CURVE_H__ */
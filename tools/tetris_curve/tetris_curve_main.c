@@ -0,0 +1,338 @@
+/**
+ * @file   tetris_curve_main.c
+ * @brief  tetris難易度曲線解析ツール・コマンドライン実装
+ * @details 解析結果は2つのCSVに出力する
+ *            <prefix>_summary.csv：解析セル毎のゲームオーバー率・平均生存時間・スコア分布
+ *            <prefix>_levels.csv ：解析セル×レベル毎の到達率・到達時間・滞在時間・ゲームオーバー率
+ *          難易度テーブルは常にゲームコアの既定値（default）を先頭に含め、-tで指定したファイルのテーブルを追加する
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "tetris_curve.h"
+#include "tetris_sim.h"
+#include "tetris_core.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define GAMES_PER_CELL_DEFAULT 1000          // 解析セル毎のゲーム数の既定値
+#define FRAME_LIMIT_DEFAULT 60000            // 1ゲームの最大フレーム数の既定値（実機換算で10分）
+#define BASE_SEED_DEFAULT 1                  // シード基準値の既定値
+#define OUTPUT_PREFIX_DEFAULT "tetris_curve" // 出力CSVファイル名の接頭辞の既定値
+#define OUTPUT_PATH_LENGTH_MAX 4096          // 出力CSVファイルパスの最大文字数
+
+// 腕前モデル数
+#define NUMBER_OF_SKILLS (sizeof(skill_list) / sizeof(skill_list[0]))
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+// 腕前モデル（反応時間[フレーム]・配置ミス率[‰]・ハードドロップ／高速落下の有無・2手読みの有無で表す）
+static const TETRIS_CURVE_skill_t skill_list[] = {
+    {"beginner", {.type = policy_ai, .ai_reaction_frames = 80, .ai_mistake_permille = 300, .is_ai_drop_disabled = true}},
+    {"casual", {.type = policy_ai, .ai_reaction_frames = 40, .ai_mistake_permille = 120, .is_ai_drop_disabled = true}},
+    {"skilled", {.type = policy_ai, .ai_reaction_frames = 15, .ai_mistake_permille = 30, .is_ai_lookahead_enabled = true}},
+    {"ai", {.type = policy_ai, .is_ai_lookahead_enabled = true}},
+};
+
+static TETRIS_CURVE_table_t table_list[TETRIS_CURVE_TABLES_MAX]; // 難易度テーブル一覧（先頭は既定値）
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static void print_usage(const char *program_name);
+static int select_skills(char *names, TETRIS_CURVE_skill_t *skills, uint32_t *number_of_skills_ptr);
+static double get_elapsed_seconds(const struct timespec *start_ptr);
+static int compare_uint32(const void *a, const void *b);
+static int write_summary_csv(const char *path, const TETRIS_CURVE_config_t *config_ptr, const TETRIS_CURVE_statistics_t *statistics, uint32_t *scores);
+static int write_levels_csv(const char *path, const TETRIS_CURVE_config_t *config_ptr, const TETRIS_CURVE_statistics_t *statistics);
+static double convert_to_seconds(double frames);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief メイン関数
+ * @param argc 引数の数
+ * @param argv 引数
+ * @return 終了コード
+ */
+int main(int argc, char *argv[])
+{
+    long number_of_processors = sysconf(_SC_NPROCESSORS_ONLN);
+    TETRIS_CURVE_skill_t skills[NUMBER_OF_SKILLS];
+    memcpy(skills, skill_list, sizeof(skill_list));
+    TETRIS_CURVE_config_t config = {
+        .tables = table_list,
+        .number_of_tables = 1,
+        .skills = skills,
+        .number_of_skills = NUMBER_OF_SKILLS,
+        .games_per_cell = GAMES_PER_CELL_DEFAULT,
+        .number_of_threads = (0 < number_of_processors) ? (uint32_t)number_of_processors : 1,
+        .base_seed = BASE_SEED_DEFAULT,
+        .frame_limit = FRAME_LIMIT_DEFAULT,
+    };
+    const char *output_prefix = OUTPUT_PREFIX_DEFAULT;
+    TETRIS_CURVE_initialize_table(&table_list[0], "default");
+
+    int option;
+    while ((option = getopt(argc, argv, "n:j:s:f:t:k:o:h")) != -1)
+    {
+        switch (option)
+        {
+        case 'n':
+            config.games_per_cell = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'j':
+            config.number_of_threads = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            config.base_seed = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'f':
+            config.frame_limit = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 't':
+            if (TETRIS_CURVE_load_tables(optarg, table_list, TETRIS_CURVE_TABLES_MAX, &config.number_of_tables))
+                return EXIT_FAILURE;
+            break;
+        case 'k':
+            if (select_skills(optarg, skills, &config.number_of_skills))
+            {
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'o':
+            output_prefix = optarg;
+            break;
+        case 'h':
+        default:
+            print_usage(argv[0]);
+            return (option == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (!config.games_per_cell || !config.number_of_threads || !config.frame_limit)
+    {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    uint32_t number_of_cells = config.number_of_tables * config.number_of_skills;
+    TETRIS_CURVE_statistics_t *statistics = malloc(sizeof(TETRIS_CURVE_statistics_t) * number_of_cells);
+    uint32_t *scores = malloc(sizeof(uint32_t) * number_of_cells * config.games_per_cell);
+    if (!statistics || !scores)
+    {
+        fprintf(stderr, "out of memory\n");
+        free(statistics);
+        free(scores);
+        return EXIT_FAILURE;
+    }
+
+    printf("tables: %u  skills: %u  games/cell: %u  threads: %u  frame limit: %u\n",
+           config.number_of_tables, config.number_of_skills, config.games_per_cell, config.number_of_threads, config.frame_limit);
+
+    // 解析実行
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (TETRIS_CURVE_run(&config, statistics, scores))
+    {
+        fprintf(stderr, "failed to start worker threads\n");
+        free(statistics);
+        free(scores);
+        return EXIT_FAILURE;
+    }
+    double elapsed_seconds = get_elapsed_seconds(&start);
+    printf("elapsed: %.3f s  games/s: %.0f\n", elapsed_seconds, (0.0 < elapsed_seconds) ? number_of_cells * (double)config.games_per_cell / elapsed_seconds : 0.0);
+
+    // CSV出力
+    char summary_path[OUTPUT_PATH_LENGTH_MAX];
+    char levels_path[OUTPUT_PATH_LENGTH_MAX];
+    snprintf(summary_path, sizeof(summary_path), "%s_summary.csv", output_prefix);
+    snprintf(levels_path, sizeof(levels_path), "%s_levels.csv", output_prefix);
+    int status = write_summary_csv(summary_path, &config, statistics, scores);
+    if (!status)
+        status = write_levels_csv(levels_path, &config, statistics);
+    if (status)
+        fprintf(stderr, "failed to write csv: %s\n", output_prefix);
+    else
+        printf("wrote %s, %s\n", summary_path, levels_path);
+
+    free(statistics);
+    free(scores);
+    return (status) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief 使い方表示
+ * @param program_name プログラム名
+ * @return なし
+ */
+static void print_usage(const char *program_name)
+{
+    fprintf(stderr,
+            "usage: %s [-n games] [-j threads] [-s base_seed] [-f frame_limit] [-t table_file]... [-k skill,...] [-o prefix]\n"
+            "  -n  games per (table, skill) cell; game i uses base_seed + i in every cell (default %d)\n"
+            "  -j  worker threads (default: online CPUs)\n"
+            "  -s  seed of the first game (default %d)\n"
+            "  -f  frame limit per game, 1 frame = 10 ms (default %d)\n"
+            "  -t  difficulty tables to compare with the default one (may be repeated)\n"
+            "        table <name> / gravity <16 values, 1/256 cell per frame> / score_power_rate <5 values> / next_level_need_row <15 values>\n"
+            "  -k  skill models (default: all of beginner,casual,skilled,ai)\n"
+            "  -o  output prefix; writes <prefix>_summary.csv and <prefix>_levels.csv (default %s)\n",
+            program_name, GAMES_PER_CELL_DEFAULT, BASE_SEED_DEFAULT, FRAME_LIMIT_DEFAULT, OUTPUT_PREFIX_DEFAULT);
+}
+
+/**
+ * @brief 腕前モデル選択
+ * @param names カンマ区切りのモデル名
+ * @param skills 選択したモデルの格納先
+ * @param number_of_skills_ptr 選択したモデル数格納先
+ * @return 0：正常終了、-1：不明なモデル名
+ */
+static int select_skills(char *names, TETRIS_CURVE_skill_t *skills, uint32_t *number_of_skills_ptr)
+{
+    uint32_t count = 0;
+    for (char *name = strtok(names, ","); name; name = strtok(NULL, ","))
+    {
+        size_t i = 0;
+        while (i < NUMBER_OF_SKILLS && strcmp(name, skill_list[i].name))
+            i++;
+        if (NUMBER_OF_SKILLS <= i || NUMBER_OF_SKILLS <= count)
+            return -1;
+        skills[count++] = skill_list[i];
+    }
+    *number_of_skills_ptr = count;
+
+    return (count) ? 0 : -1;
+}
+
+/**
+ * @brief 経過時間取得
+ * @param start_ptr 計測開始時刻
+ * @return 経過時間[s]
+ */
+static double get_elapsed_seconds(const struct timespec *start_ptr)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)(now.tv_sec - start_ptr->tv_sec) + (double)(now.tv_nsec - start_ptr->tv_nsec) * 1e-9;
+}
+
+/**
+ * @brief uint32_t比較（qsort用）
+ */
+static int compare_uint32(const void *a, const void *b)
+{
+    uint32_t value_a = *(const uint32_t *)a;
+    uint32_t value_b = *(const uint32_t *)b;
+
+    return (value_a > value_b) - (value_a < value_b);
+}
+
+/**
+ * @brief サマリCSV出力
+ * @param path 出力先ファイルパス
+ * @param config_ptr 解析実行設定
+ * @param statistics 解析セル毎の集計結果
+ * @param scores ゲーム毎のスコア（解析セル毎に整列する）
+ * @return 0：正常終了、-1：書き込み失敗
+ */
+static int write_summary_csv(const char *path, const TETRIS_CURVE_config_t *config_ptr, const TETRIS_CURVE_statistics_t *statistics, uint32_t *scores)
+{
+    FILE *file = fopen(path, "w");
+    if (!file)
+        return -1;
+
+    fprintf(file, "table,skill,games,game_over_rate,survival_mean_s,rows_mean,score_mean,score_stddev,score_variance,score_p10,score_p50,score_p90,score_max\n");
+    uint32_t games = config_ptr->games_per_cell;
+    for (uint32_t cell = 0; cell < config_ptr->number_of_tables * config_ptr->number_of_skills; cell++)
+    {
+        const TETRIS_CURVE_statistics_t *statistics_ptr = &statistics[cell];
+        uint32_t *cell_scores = &scores[(size_t)cell * games];
+        qsort(cell_scores, games, sizeof(uint32_t), compare_uint32);
+
+        double mean = statistics_ptr->score_sum / games;
+        double variance = statistics_ptr->score_square_sum / games - mean * mean;
+        variance = (0.0 < variance) ? variance : 0.0;
+        fprintf(file, "%s,%s,%u,%.4f,%.2f,%.2f,%.2f,%.2f,%.1f,%u,%u,%u,%u\n",
+                config_ptr->tables[cell / config_ptr->number_of_skills].name, config_ptr->skills[cell % config_ptr->number_of_skills].name,
+                games, (double)statistics_ptr->game_over / games, convert_to_seconds(statistics_ptr->frames_sum / games),
+                statistics_ptr->rows_sum / games, mean, sqrt(variance), variance,
+                cell_scores[games / 10], cell_scores[games / 2], cell_scores[(games * 9) / 10], cell_scores[games - 1]);
+    }
+
+    int status = (ferror(file)) ? -1 : 0;
+    if (fclose(file))
+        status = -1;
+
+    return status;
+}
+
+/**
+ * @brief レベル別CSV出力
+ * @param path 出力先ファイルパス
+ * @param config_ptr 解析実行設定
+ * @param statistics 解析セル毎の集計結果
+ * @return 0：正常終了、-1：書き込み失敗
+ * @details 到達時間・滞在時間はそのレベルに到達したゲームのみの平均。game_over_rateはそのレベルに到達したゲームのうち、そのレベルで終わった割合
+ */
+static int write_levels_csv(const char *path, const TETRIS_CURVE_config_t *config_ptr, const TETRIS_CURVE_statistics_t *statistics)
+{
+    FILE *file = fopen(path, "w");
+    if (!file)
+        return -1;
+
+    fprintf(file, "table,skill,level,reached,reach_rate,time_to_level_mean_s,time_to_level_stddev_s,time_in_level_mean_s,game_over,game_over_rate\n");
+    for (uint32_t cell = 0; cell < config_ptr->number_of_tables * config_ptr->number_of_skills; cell++)
+    {
+        const TETRIS_CURVE_statistics_t *statistics_ptr = &statistics[cell];
+        for (int level = 1; level <= TETRIS_CORE_MAXIMUM_LEVEL; level++)
+        {
+            uint64_t reached = statistics_ptr->reached[level];
+            double reach_mean = (reached) ? statistics_ptr->reach_frames_sum[level] / reached : 0.0;
+            double reach_variance = (reached) ? statistics_ptr->reach_frames_square_sum[level] / reached - reach_mean * reach_mean : 0.0;
+            fprintf(file, "%s,%s,%d,%llu,%.4f,%.2f,%.2f,%.2f,%llu,%.4f\n",
+                    config_ptr->tables[cell / config_ptr->number_of_skills].name, config_ptr->skills[cell % config_ptr->number_of_skills].name,
+                    level, (unsigned long long)reached, (double)reached / statistics_ptr->games,
+                    convert_to_seconds(reach_mean), convert_to_seconds(sqrt((0.0 < reach_variance) ? reach_variance : 0.0)),
+                    convert_to_seconds((reached) ? statistics_ptr->stay_frames_sum[level] / reached : 0.0),
+                    (unsigned long long)statistics_ptr->game_over_in_level[level],
+                    (reached) ? (double)statistics_ptr->game_over_in_level[level] / reached : 0.0);
+        }
+    }
+
+    int status = (ferror(file)) ? -1 : 0;
+    if (fclose(file))
+        status = -1;
+
+    return status;
+}
+
+/**
+ * @brief フレーム数 → 秒数変換
+ * @param frames フレーム数
+ * @return 実機換算の秒数
+ */
+static double convert_to_seconds(double frames)
+{
+    return frames / TETRIS_SIM_FRAMES_PER_SECOND;
+}
@@ -0,0 +1,228 @@
+/**
+ * @file   tetris_curve_run.c
+ * @brief  tetris難易度曲線解析ツール・並列実行実装
+ * @details 1ゲームを1ジョブとし、ワーカスレッドが共有カウンタからジョブを取り出して実行する
+ *          集計はスレッド毎の領域に行い、全ジョブ終了後に足し合わせる（ゲーム毎の排他制御を不要にするため）
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tetris_curve.h"
+#include "tetris_sim.h"
+#include "tetris_core.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+
+//======================================================
+// 型定義
+//======================================================
+/**
+ * @brief 解析ジョブ共有情報定義
+ */
+typedef struct
+{
+    const TETRIS_CURVE_config_t *config_ptr;      /**< 解析実行設定 */
+    const TETRIS_SIM_batch_config_t *sim_configs; /**< 解析セル毎のシミュレーション設定 */
+    uint32_t number_of_cells;                     /**< 解析セル数（テーブル数×腕前モデル数） */
+    uint64_t number_of_jobs;                      /**< ジョブ数（解析セル数×ゲーム数） */
+    atomic_uint_fast64_t next_job;                /**< 次に取り出すジョブ番号 */
+    uint32_t *scores;                             /**< ジョブ毎のスコア格納先 */
+} curve_job_t;
+
+/**
+ * @brief ワーカスレッド引数定義
+ */
+typedef struct
+{
+    curve_job_t *job_ptr;                  /**< 解析ジョブ共有情報 */
+    TETRIS_CURVE_statistics_t *statistics; /**< スレッド専用の集計領域（解析セル数分） */
+} curve_worker_argument_t;
+
+//======================================================
+// 変数・定数
+//======================================================
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static void *run_worker(void *argument_ptr);
+static void accumulate_result(TETRIS_CURVE_statistics_t *statistics_ptr, const TETRIS_SIM_result_t *result_ptr);
+static void merge_statistics(TETRIS_CURVE_statistics_t *destination_ptr, const TETRIS_CURVE_statistics_t *source_ptr);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief 解析実行
+ * @param config_ptr 解析実行設定
+ * @param statistics 解析セル毎の集計結果格納先（テーブル番号×腕前モデル数 + 腕前モデル番号の順）
+ * @param scores ゲーム毎のスコア格納先（解析セル番号×ゲーム数 + ゲーム番号の順。パーセンタイル算出用）
+ * @return 0：正常終了、-1：メモリ確保・スレッド生成失敗
+ */
+int TETRIS_CURVE_run(const TETRIS_CURVE_config_t *config_ptr, TETRIS_CURVE_statistics_t *statistics, uint32_t *scores)
+{
+    uint32_t number_of_cells = config_ptr->number_of_tables * config_ptr->number_of_skills;
+    uint32_t number_of_threads = (config_ptr->number_of_threads) ? config_ptr->number_of_threads : 1;
+
+    TETRIS_SIM_batch_config_t *sim_configs = malloc(sizeof(TETRIS_SIM_batch_config_t) * number_of_cells);
+    TETRIS_CURVE_statistics_t *thread_statistics = calloc((size_t)number_of_threads * number_of_cells, sizeof(TETRIS_CURVE_statistics_t));
+    curve_worker_argument_t *arguments = malloc(sizeof(curve_worker_argument_t) * number_of_threads);
+    pthread_t *threads = malloc(sizeof(pthread_t) * number_of_threads);
+    int status = (sim_configs && thread_statistics && arguments && threads) ? 0 : -1;
+
+    if (!status)
+    {
+        // 解析セル毎のシミュレーション設定（実行中は読み出し専用）
+        for (uint32_t cell = 0; cell < number_of_cells; cell++)
+        {
+            const TETRIS_CURVE_table_t *table_ptr = &config_ptr->tables[cell / config_ptr->number_of_skills];
+            const TETRIS_CURVE_skill_t *skill_ptr = &config_ptr->skills[cell % config_ptr->number_of_skills];
+            sim_configs[cell] = (TETRIS_SIM_batch_config_t){
+                .number_of_games = config_ptr->games_per_cell,
+                .number_of_threads = 1,
+                .base_seed = config_ptr->base_seed,
+                .frame_limit = config_ptr->frame_limit,
+                .policy = skill_ptr->policy,
+                .difficulty = &table_ptr->difficulty,
+            };
+        }
+
+        curve_job_t job = {
+            .config_ptr = config_ptr,
+            .sim_configs = sim_configs,
+            .number_of_cells = number_of_cells,
+            .number_of_jobs = (uint64_t)number_of_cells * config_ptr->games_per_cell,
+            .scores = scores,
+        };
+        atomic_init(&job.next_job, 0);
+
+        // ワーカスレッドで全ジョブを実行（一部のスレッドが作れなくても、作れたスレッドで全ジョブを処理する）
+        uint32_t created = 0;
+        for (; created < number_of_threads; created++)
+        {
+            arguments[created].job_ptr = &job;
+            arguments[created].statistics = &thread_statistics[(size_t)created * number_of_cells];
+            if (pthread_create(&threads[created], NULL, run_worker, &arguments[created]))
+                break;
+        }
+        for (uint32_t i = 0; i < created; i++)
+        {
+            pthread_join(threads[i], NULL);
+        }
+
+        if (!created)
+        {
+            status = -1;
+        }
+        else
+        {
+            memset(statistics, 0, sizeof(TETRIS_CURVE_statistics_t) * number_of_cells);
+            for (uint32_t i = 0; i < created; i++)
+            {
+                for (uint32_t cell = 0; cell < number_of_cells; cell++)
+                {
+                    merge_statistics(&statistics[cell], &thread_statistics[(size_t)i * number_of_cells + cell]);
+                }
+            }
+        }
+    }
+
+    free(sim_configs);
+    free(thread_statistics);
+    free(arguments);
+    free(threads);
+    return status;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief ワーカスレッド処理
+ * @param argument_ptr ワーカスレッド引数
+ * @return NULL
+ */
+static void *run_worker(void *argument_ptr)
+{
+    const curve_worker_argument_t *worker_ptr = argument_ptr;
+    curve_job_t *job_ptr = worker_ptr->job_ptr;
+    uint32_t games_per_cell = job_ptr->config_ptr->games_per_cell;
+
+    while (true)
+    {
+        uint64_t job = atomic_fetch_add(&job_ptr->next_job, 1);
+        if (job_ptr->number_of_jobs <= job)
+            break;
+
+        uint32_t cell = (uint32_t)(job / games_per_cell);
+        uint32_t game_index = (uint32_t)(job % games_per_cell);
+
+        TETRIS_SIM_result_t result;
+        TETRIS_SIM_run_game(&job_ptr->sim_configs[cell], job_ptr->config_ptr->base_seed + game_index, &result);
+        accumulate_result(&worker_ptr->statistics[cell], &result);
+        job_ptr->scores[job] = result.score;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 1ゲーム分の結果集計
+ * @param statistics_ptr 解析セル集計結果
+ * @param result_ptr 1ゲーム分の実行結果
+ * @return なし
+ * @details レベルは1つずつしか上がらないため、レベルLの滞在時間は次のレベルの到達フレーム（無ければ終了フレーム）との差になる
+ */
+static void accumulate_result(TETRIS_CURVE_statistics_t *statistics_ptr, const TETRIS_SIM_result_t *result_ptr)
+{
+    statistics_ptr->games++;
+    statistics_ptr->game_over += result_ptr->is_game_over;
+    statistics_ptr->frames_sum += result_ptr->frames;
+    statistics_ptr->score_sum += result_ptr->score;
+    statistics_ptr->score_square_sum += (double)result_ptr->score * result_ptr->score;
+    statistics_ptr->rows_sum += result_ptr->row_deleted;
+
+    for (uint8_t level = 1; level <= result_ptr->level; level++)
+    {
+        uint32_t reach_frame = result_ptr->level_frames[level];
+        uint32_t leave_frame = (level < result_ptr->level) ? result_ptr->level_frames[level + 1] : result_ptr->frames;
+        statistics_ptr->reached[level]++;
+        statistics_ptr->reach_frames_sum[level] += reach_frame;
+        statistics_ptr->reach_frames_square_sum[level] += (double)reach_frame * reach_frame;
+        statistics_ptr->stay_frames_sum[level] += leave_frame - reach_frame;
+    }
+    if (result_ptr->is_game_over)
+        statistics_ptr->game_over_in_level[result_ptr->level]++;
+}
+
+/**
+ * @brief 集計結果マージ
+ * @param destination_ptr マージ先
+ * @param source_ptr マージ元
+ * @return なし
+ */
+static void merge_statistics(TETRIS_CURVE_statistics_t *destination_ptr, const TETRIS_CURVE_statistics_t *source_ptr)
+{
+    destination_ptr->games += source_ptr->games;
+    destination_ptr->game_over += source_ptr->game_over;
+    destination_ptr->frames_sum += source_ptr->frames_sum;
+    destination_ptr->score_sum += source_ptr->score_sum;
+    destination_ptr->score_square_sum += source_ptr->score_square_sum;
+    destination_ptr->rows_sum += source_ptr->rows_sum;
+    for (int level = 0; level <= TETRIS_CORE_MAXIMUM_LEVEL; level++)
+    {
+        destination_ptr->reached[level] += source_ptr->reached[level];
+        destination_ptr->reach_frames_sum[level] += source_ptr->reach_frames_sum[level];
+        destination_ptr->reach_frames_square_sum[level] += source_ptr->reach_frames_square_sum[level];
+        destination_ptr->stay_frames_sum[level] += source_ptr->stay_frames_sum[level];
+        destination_ptr->game_over_in_level[level] += source_ptr->game_over_in_level[level];
+    }
+}
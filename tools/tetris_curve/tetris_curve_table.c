@@ -0,0 +1,169 @@
+/**
+ * @file   tetris_curve_table.c
+ * @brief  tetris難易度曲線解析ツール・難易度テーブル読み込み実装
+ * @details テーブルファイルの書式（1行1エントリ、#以降はコメント）
+ *            table <テーブル名>
+ *            gravity <レベル0～15の値（自由落下速度[1/256マス/ステップ]）>
+ *            score_power_rate <消去行数0～4の値>
+ *            next_level_need_row <レベル0～14の値>
+ *          tableで新しいテーブルを始める。テーブルはゲームコアの既定値で初期化され、書かれた項目のみ置き換える
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tetris_curve.h"
+#include "tetris_core.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define TABLE_LINE_LENGTH_MAX 256 // テーブルファイル1行の最大文字数
+#define TABLE_VALUE_MAX 65535     // テーブル値の上限（項目の型によってはさらに小さい）
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static int parse_values(char *text, long values[], int number_of_values, long value_max);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief 難易度テーブル初期化
+ * @param table_ptr 難易度テーブル格納先
+ * @param name テーブル名（長すぎる場合は切り詰める）
+ * @return なし
+ */
+void TETRIS_CURVE_initialize_table(TETRIS_CURVE_table_t *table_ptr, const char *name)
+{
+    snprintf(table_ptr->name, sizeof(table_ptr->name), "%s", name);
+    table_ptr->difficulty = TETRIS_CORE_difficulty_default;
+}
+
+/**
+ * @brief 難易度テーブルファイル読み込み
+ * @param path テーブルファイルパス
+ * @param tables 難易度テーブル格納先（*number_of_tables_ptr番目から追加する）
+ * @param tables_max 格納先の要素数
+ * @param number_of_tables_ptr 格納済みテーブル数（読み込んだ分を加算する）
+ * @return 0：正常終了、-1：読み込み失敗（エラー内容は標準エラー出力に出す）
+ */
+int TETRIS_CURVE_load_tables(const char *path, TETRIS_CURVE_table_t *tables, uint32_t tables_max, uint32_t *number_of_tables_ptr)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+    {
+        fprintf(stderr, "cannot open table file: %s\n", path);
+        return -1;
+    }
+
+    char line[TABLE_LINE_LENGTH_MAX];
+    int line_number = 0;
+    int status = 0;
+    TETRIS_CURVE_table_t *table_ptr = NULL;
+    while (!status && fgets(line, sizeof(line), file))
+    {
+        line_number++;
+        char *comment = strchr(line, '#');
+        if (comment)
+            *comment = '\0';
+
+        char *key = strtok(line, " \t\r\n");
+        if (!key)
+            continue;
+        char *rest = strtok(NULL, "\r\n");
+
+        long values[TETRIS_CORE_MAXIMUM_LEVEL + 1];
+        if (!strcmp(key, "table"))
+        {
+            char *name = (rest) ? strtok(rest, " \t") : NULL;
+            if (!name || tables_max <= *number_of_tables_ptr)
+            {
+                status = -1;
+                break;
+            }
+            table_ptr = &tables[(*number_of_tables_ptr)++];
+            TETRIS_CURVE_initialize_table(table_ptr, name);
+        }
+        else if (!table_ptr) // tableより前に項目がある
+        {
+            status = -1;
+        }
+        else if (!strcmp(key, "gravity"))
+        {
+            status = parse_values(rest, values, TETRIS_CORE_MAXIMUM_LEVEL + 1, TABLE_VALUE_MAX);
+            for (int i = 0; !status && i <= TETRIS_CORE_MAXIMUM_LEVEL; i++)
+            {
+                table_ptr->difficulty.gravity[i] = (uint16_t)values[i];
+            }
+        }
+        else if (!strcmp(key, "score_power_rate"))
+        {
+            status = parse_values(rest, values, TETRIS_CORE_ERASE_ROW_MAX + 1, UINT8_MAX);
+            for (int i = 0; !status && i <= TETRIS_CORE_ERASE_ROW_MAX; i++)
+            {
+                table_ptr->difficulty.score_power_rate[i] = (uint8_t)values[i];
+            }
+        }
+        else if (!strcmp(key, "next_level_need_row"))
+        {
+            status = parse_values(rest, values, TETRIS_CORE_MAXIMUM_LEVEL, TABLE_VALUE_MAX);
+            for (int i = 0; !status && i < TETRIS_CORE_MAXIMUM_LEVEL; i++)
+            {
+                table_ptr->difficulty.next_level_need_row[i] = (uint16_t)values[i];
+            }
+        }
+        else
+        {
+            status = -1;
+        }
+    }
+    fclose(file);
+
+    if (status)
+        fprintf(stderr, "%s:%d: invalid table entry\n", path, line_number);
+
+    return status;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief 数値列解析
+ * @param text 空白区切りの数値列
+ * @param values 解析結果格納先
+ * @param number_of_values 必要な数値の個数（過不足があればエラー）
+ * @param value_max 数値の上限
+ * @return 0：正常終了、-1：書式エラー
+ */
+static int parse_values(char *text, long values[], int number_of_values, long value_max)
+{
+    if (!text)
+        return -1;
+
+    int count = 0;
+    for (char *token = strtok(text, " \t"); token; token = strtok(NULL, " \t"))
+    {
+        char *end;
+        long value = strtol(token, &end, 0);
+        if (*end || value < 0 || value_max < value || number_of_values <= count)
+            return -1;
+        values[count++] = value;
+    }
+
+    return (count == number_of_values) ? 0 : -1;
+}
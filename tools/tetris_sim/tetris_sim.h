@@ -0,0 +1,115 @@
+/**
+ * @file   tetris_sim.h
+ * @brief  tetrisバッチシミュレータ・外部公開定義
+ * @details ゲームコア（tetris_core）をホスト環境で多数同時に実行し、統計を取るためのツール群の共通定義
+ *          ゲーム毎の状態は全てTETRIS_SIM_game_tに保持し、スレッド間で共有する可変なグローバル変数は持たない
+ */
+
+#ifndef __TETRIS_SIM_H__
+#define __TETRIS_SIM_H__
+
+//======================================================
+// インクルード
+//======================================================
+#include <stddef.h>
+#include "typedef.h"
+#include "tetris_core.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define TETRIS_SIM_ERASE_ROW_MAX 4            // 一度に消去可能な最大行数（行消去ヒストグラムの範囲）
+#define TETRIS_SIM_FRAMES_PER_SECOND 100      // 実機のゲームステップ周期（10ms）換算のフレームレート
+#define TETRIS_SIM_FRAME_LIMIT_DEFAULT 360000 // 1ゲームの最大フレーム数の既定値（実機換算で1時間）
+
+//======================================================
+// 型定義
+//======================================================
+/**
+ * @brief 入力ポリシー種別定義
+ */
+typedef enum
+{
+    policy_random = 0, /**< 疑似乱数による入力 */
+    policy_script,     /**< スクリプト（入力列）の繰り返し再生 */
+    policy_ai,         /**< 自動操作（配置探索） */
+} TETRIS_SIM_policy_type_t;
+
+/**
+ * @brief 入力ポリシー設定定義
+ * @details 全ゲームで共有する読み出し専用の設定。ゲーム毎に変化する状態はTETRIS_SIM_game_tが持つ
+ *          policy_aiは反応時間・配置ミス・高速落下の有無で人のプレイヤーの腕前を模擬できる（全て0で最善手のみ）
+ */
+typedef struct
+{
+    TETRIS_SIM_policy_type_t type;            /**< ポリシー種別 */
+    const TETRIS_CORE_input_t *script;        /**< スクリプト入力列（policy_script時のみ使用） */
+    size_t script_length;                     /**< スクリプト入力列のフレーム数 */
+    const TETRIS_CORE_ai_weight_t *ai_weight; /**< 盤面評価重み（policy_ai時のみ使用） */
+    bool is_ai_lookahead_enabled;             /**< ネクストミノまで含めた2手読みの有効フラグ（policy_ai時のみ使用） */
+    uint16_t ai_reaction_frames;              /**< 新ミノ出現から操作を始めるまでのフレーム数（policy_ai時のみ使用） */
+    uint16_t ai_mistake_permille;             /**< 目標配置を1列ずらす確率[‰]（policy_ai時のみ使用） */
+    bool is_ai_drop_disabled;                 /**< 上下入力（ハードドロップ・高速落下）を使わない（policy_ai時のみ使用） */
+} TETRIS_SIM_policy_t;
+
+/**
+ * @brief 1ゲーム分の実行状態定義
+ */
+typedef struct
+{
+    TETRIS_CORE_state_t core_state;     /**< ゲームコア演算状態 */
+    TETRIS_CORE_input_t previous_input; /**< 前フレームの入力（ポリシーの入力継続判定用） */
+    uint32_t policy_random_state;       /**< ポリシー用の疑似乱数状態（ミノ順の乱数とは独立） */
+    uint16_t policy_hold_frames;        /**< ポリシー：現在の入力（policy_aiでは入力無し）を継続する残りフレーム数 */
+    size_t script_position;             /**< ポリシー：スクリプト再生位置 */
+    TETRIS_CORE_ai_player_t ai_player;  /**< ポリシー：自動操作プレイヤー状態 */
+} TETRIS_SIM_game_t;
+
+/**
+ * @brief 1ゲーム分の実行結果定義
+ */
+typedef struct
+{
+    uint32_t seed;                                          /**< ゲームのシード */
+    uint32_t frames;                                        /**< 実行フレーム数 */
+    uint32_t idle_frames;                                   /**< 表示対象の変化が無かったフレーム数（実機で描画を省略できるフレーム） */
+    uint32_t score;                                         /**< 最終スコア */
+    uint16_t row_deleted;                                   /**< 合計消去行数 */
+    uint8_t level;                                          /**< 最終レベル */
+    bool is_game_over;                                      /**< ゲームオーバーで終了したか（falseはフレーム上限で打ち切り） */
+    uint32_t minos_locked;                                  /**< 接地したミノ数 */
+    uint32_t erase_histogram[TETRIS_SIM_ERASE_ROW_MAX + 1]; /**< 接地1回あたりの消去行数ヒストグラム */
+    uint32_t level_frames[TETRIS_CORE_MAXIMUM_LEVEL + 1];   /**< 各レベルに到達したフレーム数（未到達は0、開始時のレベルも0） */
+} TETRIS_SIM_result_t;
+
+/**
+ * @brief バッチ実行設定定義
+ */
+typedef struct
+{
+    uint32_t number_of_games;                   /**< 実行ゲーム数 */
+    uint32_t number_of_threads;                 /**< ワーカスレッド数 */
+    uint32_t base_seed;                         /**< シードの基準値（ゲームiのシードはbase_seed + i） */
+    uint32_t frame_limit;                       /**< 1ゲームの最大フレーム数 */
+    TETRIS_SIM_policy_t policy;                 /**< 入力ポリシー */
+    const TETRIS_CORE_difficulty_t *difficulty; /**< 難易度テーブル（NULLの場合はゲームコアの既定値） */
+    TETRIS_CORE_piece_set_t piece_set;          /**< ピースセット（既定値はテトリミノ） */
+} TETRIS_SIM_batch_config_t;
+
+//======================================================
+// グローバル変数・定数extern宣言
+//======================================================
+
+//======================================================
+// グローバル関数extern宣言
+//======================================================
+/* batch */
+extern void TETRIS_SIM_run_game(const TETRIS_SIM_batch_config_t *config_ptr, uint32_t seed, TETRIS_SIM_result_t *result_ptr);
+extern int TETRIS_SIM_run_batch(const TETRIS_SIM_batch_config_t *config_ptr, TETRIS_SIM_result_t *results);
+
+/* policy */
+extern void TETRIS_SIM_initialize_policy(const TETRIS_SIM_policy_t *policy_ptr, TETRIS_SIM_game_t *game_ptr, uint32_t seed);
+extern void TETRIS_SIM_decide_input(const TETRIS_SIM_policy_t *policy_ptr, TETRIS_SIM_game_t *game_ptr, TETRIS_CORE_input_t *input_ptr);
+extern int TETRIS_SIM_load_script(const char *path, TETRIS_CORE_input_t **script_ptr, size_t *script_length_ptr);
+
+#endif /* __TETRIS_SIM_H__ */
@@ -0,0 +1,169 @@
+/**
+ * @file   tetris_sim_batch.c
+ * @brief  tetrisバッチシミュレータ・ゲーム実行実装
+ * @details ゲームをワーカスレッドに静的に割り振って並列実行する
+ *          各スレッドは自身の担当ゲームの状態と結果格納先のみを書き換えるため、排他制御は不要
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tetris_sim.h"
+#include "tetris_core.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+
+//======================================================
+// 型定義
+//======================================================
+/**
+ * @brief ワーカスレッド引数定義
+ */
+typedef struct
+{
+    const TETRIS_SIM_batch_config_t *config_ptr; /**< バッチ実行設定（読み出し専用） */
+    TETRIS_SIM_result_t *results;                /**< 結果格納先（全ゲーム分の配列） */
+    uint32_t thread_index;                       /**< スレッド番号 */
+} sim_worker_argument_t;
+
+//======================================================
+// 変数・定数
+//======================================================
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static void *run_worker(void *argument_ptr);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief 1ゲーム実行
+ * @param config_ptr バッチ実行設定
+ * @param seed ゲームのシード
+ * @param result_ptr 実行結果格納先
+ * @return なし
+ * @details ゲームオーバーかフレーム上限までゲームコアを進め、結果を集計する
+ *          ミノの接地はステップ後にミノ新規生成フラグが立ったことで、消去行数は合計消去行数の差分で検出する
+ *          難易度テーブル・ピースセットの指定があれば、ゲームコアの初期化後に差し替える
+ */
+void TETRIS_SIM_run_game(const TETRIS_SIM_batch_config_t *config_ptr, uint32_t seed, TETRIS_SIM_result_t *result_ptr)
+{
+    TETRIS_SIM_game_t game;
+    TETRIS_CORE_initialize(&game.core_state, seed);
+    if (piece_set_tetromino != config_ptr->piece_set)
+        TETRIS_CORE_select_piece_set(&game.core_state, config_ptr->piece_set);
+    if (config_ptr->difficulty)
+        game.core_state.difficulty_ptr = config_ptr->difficulty;
+    TETRIS_SIM_initialize_policy(&config_ptr->policy, &game, seed);
+
+    memset(result_ptr, 0, sizeof(*result_ptr));
+    result_ptr->seed = seed;
+
+    const TETRIS_CORE_game_parameter_t *game_parameter_ptr = &game.core_state.game_parameter;
+    while (result_ptr->frames < config_ptr->frame_limit)
+    {
+        TETRIS_CORE_input_t input;
+        TETRIS_SIM_decide_input(&config_ptr->policy, &game, &input);
+
+        uint16_t row_deleted_before = game_parameter_ptr->row_deleted;
+        uint8_t level_before = game_parameter_ptr->level;
+        TETRIS_CORE_step_result_t step_result = TETRIS_CORE_step(&game.core_state, &input);
+        result_ptr->frames++;
+        result_ptr->idle_frames += (core_idle == step_result);
+
+        if (level_before != game_parameter_ptr->level) // 今回ステップでレベルアップした
+            result_ptr->level_frames[game_parameter_ptr->level] = result_ptr->frames;
+
+        if (game.core_state.mino_parameter.is_next_mino_generate) // 今回ステップでミノが接地した
+        {
+            uint16_t row_erased = game_parameter_ptr->row_deleted - row_deleted_before;
+            result_ptr->minos_locked++;
+            result_ptr->erase_histogram[(row_erased < TETRIS_SIM_ERASE_ROW_MAX) ? row_erased : TETRIS_SIM_ERASE_ROW_MAX]++;
+        }
+
+        if (core_game_over == step_result)
+        {
+            result_ptr->is_game_over = true;
+            break;
+        }
+    }
+
+    result_ptr->score = game_parameter_ptr->score;
+    result_ptr->row_deleted = game_parameter_ptr->row_deleted;
+    result_ptr->level = game_parameter_ptr->level;
+}
+
+/**
+ * @brief バッチ実行
+ * @param config_ptr バッチ実行設定
+ * @param results 実行結果格納先（number_of_games分の配列）
+ * @return 0：正常終了、-1：スレッド生成失敗
+ * @details ゲームiはスレッド(i % スレッド数)が担当する。ゲームiのシードはbase_seed + iなので、
+ *          スレッド数を変えても同じ設定なら同じ結果になる
+ */
+int TETRIS_SIM_run_batch(const TETRIS_SIM_batch_config_t *config_ptr, TETRIS_SIM_result_t *results)
+{
+    uint32_t number_of_threads = config_ptr->number_of_threads ? config_ptr->number_of_threads : 1;
+    pthread_t *threads = malloc(sizeof(pthread_t) * number_of_threads);
+    sim_worker_argument_t *arguments = malloc(sizeof(sim_worker_argument_t) * number_of_threads);
+    if (!threads || !arguments)
+    {
+        free(threads);
+        free(arguments);
+        return -1;
+    }
+
+    int status = 0;
+    uint32_t created = 0;
+    for (; created < number_of_threads; created++)
+    {
+        arguments[created].config_ptr = config_ptr;
+        arguments[created].results = results;
+        arguments[created].thread_index = created;
+        if (pthread_create(&threads[created], NULL, run_worker, &arguments[created]))
+        {
+            status = -1;
+            break;
+        }
+    }
+
+    for (uint32_t i = 0; i < created; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    free(threads);
+    free(arguments);
+    return status;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief ワーカスレッド処理
+ * @param argument_ptr ワーカスレッド引数
+ * @return NULL
+ * @details 担当ゲーム（スレッド番号から始めてスレッド数おき）を順に実行する
+ */
+static void *run_worker(void *argument_ptr)
+{
+    const sim_worker_argument_t *worker_ptr = argument_ptr;
+    const TETRIS_SIM_batch_config_t *config_ptr = worker_ptr->config_ptr;
+    uint32_t number_of_threads = config_ptr->number_of_threads ? config_ptr->number_of_threads : 1;
+
+    for (uint32_t game_index = worker_ptr->thread_index; game_index < config_ptr->number_of_games; game_index += number_of_threads)
+    {
+        TETRIS_SIM_run_game(config_ptr, config_ptr->base_seed + game_index, &worker_ptr->results[game_index]);
+    }
+
+    return NULL;
+}
@@ -0,0 +1,416 @@
+/**
+ * @file   tetris_sim_main.c
+ * @brief  tetrisバッチシミュレータ・コマンドライン実装
+ * @details 独立したゲームをN個並列実行し、スループット・スコア分布・行消去ヒストグラムを出力する
+ *          実機に書き込む前に、スコア計算とレベル変化を大量のゲームで検証するために使う
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "tetris_sim.h"
+#include "tetris_core.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define NUMBER_OF_GAMES_DEFAULT 1000   // 実行ゲーム数の既定値
+#define BASE_SEED_DEFAULT 1            // シード基準値の既定値
+#define SCORE_BUCKET_WIDTH_DEFAULT 100 // スコアヒストグラムの階級幅の既定値
+#define HISTOGRAM_BAR_WIDTH 40         // ヒストグラム棒グラフの最大文字数
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static void print_usage(const char *program_name);
+static const char *get_policy_name(const TETRIS_SIM_policy_t *policy_ptr, const char *script_path);
+static double get_elapsed_seconds(const struct timespec *start_ptr);
+static int compare_uint32(const void *a, const void *b);
+static void print_bar(uint64_t count, uint64_t count_max);
+static void report_throughput(const TETRIS_SIM_result_t *results, uint32_t number_of_games, double elapsed_seconds);
+static void report_score_distribution(const TETRIS_SIM_result_t *results, uint32_t number_of_games, uint32_t bucket_width);
+static void report_erase_histogram(const TETRIS_SIM_result_t *results, uint32_t number_of_games);
+static void report_level_histogram(const TETRIS_SIM_result_t *results, uint32_t number_of_games);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief メイン関数
+ * @param argc 引数の数
+ * @param argv 引数
+ * @return 終了コード
+ */
+int main(int argc, char *argv[])
+{
+    long number_of_processors = sysconf(_SC_NPROCESSORS_ONLN);
+    TETRIS_SIM_batch_config_t config = {
+        .number_of_games = NUMBER_OF_GAMES_DEFAULT,
+        .number_of_threads = (0 < number_of_processors) ? (uint32_t)number_of_processors : 1,
+        .base_seed = BASE_SEED_DEFAULT,
+        .frame_limit = TETRIS_SIM_FRAME_LIMIT_DEFAULT,
+        .policy = {.type = policy_random},
+    };
+    uint32_t bucket_width = SCORE_BUCKET_WIDTH_DEFAULT;
+    const char *script_path = NULL;
+
+    int option;
+    while ((option = getopt(argc, argv, "n:j:s:f:p:t:b:h")) != -1)
+    {
+        switch (option)
+        {
+        case 'n':
+            config.number_of_games = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'j':
+            config.number_of_threads = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            config.base_seed = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'f':
+            config.frame_limit = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'p':
+            if (!strcmp(optarg, "random"))
+            {
+                config.policy.type = policy_random;
+            }
+            else if (!strcmp(optarg, "ai") || !strcmp(optarg, "ai-current"))
+            {
+                config.policy.type = policy_ai;
+                config.policy.is_ai_lookahead_enabled = !strcmp(optarg, "ai");
+            }
+            else if (!strncmp(optarg, "script:", 7))
+            {
+                config.policy.type = policy_script;
+                script_path = optarg + 7;
+            }
+            else
+            {
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 't':
+            if (!strcmp(optarg, "tetromino"))
+            {
+                config.piece_set = piece_set_tetromino;
+            }
+            else if (!strcmp(optarg, "pentomino"))
+            {
+                config.piece_set = piece_set_pentomino;
+            }
+            else
+            {
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'b':
+            bucket_width = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'h':
+        default:
+            print_usage(argv[0]);
+            return (option == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (!config.number_of_games || !config.number_of_threads || !config.frame_limit || !bucket_width)
+    {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    TETRIS_CORE_input_t *script = NULL;
+    if (script_path && TETRIS_SIM_load_script(script_path, &script, &config.policy.script_length))
+        return EXIT_FAILURE;
+    config.policy.script = script;
+
+    TETRIS_SIM_result_t *results = calloc(config.number_of_games, sizeof(TETRIS_SIM_result_t));
+    if (!results)
+    {
+        fprintf(stderr, "out of memory\n");
+        free(script);
+        return EXIT_FAILURE;
+    }
+
+    // バッチ実行
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (TETRIS_SIM_run_batch(&config, results))
+    {
+        fprintf(stderr, "failed to start worker threads\n");
+        free(results);
+        free(script);
+        return EXIT_FAILURE;
+    }
+    double elapsed_seconds = get_elapsed_seconds(&start);
+
+    // 集計結果出力
+    printf("games: %u  threads: %u  seeds: %u-%u  policy: %s  frame limit: %u\n",
+           config.number_of_games, config.number_of_threads, config.base_seed, config.base_seed + config.number_of_games - 1,
+           get_policy_name(&config.policy, script_path), config.frame_limit);
+    report_throughput(results, config.number_of_games, elapsed_seconds);
+    report_score_distribution(results, config.number_of_games, bucket_width);
+    report_erase_histogram(results, config.number_of_games);
+    report_level_histogram(results, config.number_of_games);
+
+    free(results);
+    free(script);
+    return EXIT_SUCCESS;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief 使い方表示
+ * @param program_name プログラム名
+ * @return なし
+ */
+static void print_usage(const char *program_name)
+{
+    fprintf(stderr,
+            "usage: %s [-n games] [-j threads] [-s base_seed] [-f frame_limit] [-p random|ai|ai-current|script:FILE] [-t tetromino|pentomino] [-b score_bucket]\n"
+            "  -n  number of games (default %d)\n"
+            "  -j  worker threads (default: online CPUs)\n"
+            "  -s  seed of the first game; game i uses base_seed + i (default %d)\n"
+            "  -f  frame limit per game, 1 frame = 10 ms (default %d)\n"
+            "  -p  input policy (default random)\n"
+            "        ai: placement search over current and next mino, ai-current: current mino only\n"
+            "  -t  piece set (default tetromino)\n"
+            "  -b  score histogram bucket width (default %d)\n",
+            program_name, NUMBER_OF_GAMES_DEFAULT, BASE_SEED_DEFAULT, TETRIS_SIM_FRAME_LIMIT_DEFAULT, SCORE_BUCKET_WIDTH_DEFAULT);
+}
+
+/**
+ * @brief 入力ポリシー名取得
+ * @param policy_ptr 入力ポリシー設定
+ * @param script_path スクリプトファイルパス
+ * @return 表示用ポリシー名
+ */
+static const char *get_policy_name(const TETRIS_SIM_policy_t *policy_ptr, const char *script_path)
+{
+    switch (policy_ptr->type)
+    {
+    case policy_script:
+        return script_path;
+    case policy_ai:
+        return (policy_ptr->is_ai_lookahead_enabled) ? "ai" : "ai-current";
+    case policy_random:
+    default:
+        return "random";
+    }
+}
+
+/**
+ * @brief 経過時間取得
+ * @param start_ptr 計測開始時刻
+ * @return 経過時間[s]
+ */
+static double get_elapsed_seconds(const struct timespec *start_ptr)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)(now.tv_sec - start_ptr->tv_sec) + (double)(now.tv_nsec - start_ptr->tv_nsec) * 1e-9;
+}
+
+/**
+ * @brief uint32_t比較（qsort用）
+ */
+static int compare_uint32(const void *a, const void *b)
+{
+    uint32_t value_a = *(const uint32_t *)a;
+    uint32_t value_b = *(const uint32_t *)b;
+
+    return (value_a > value_b) - (value_a < value_b);
+}
+
+/**
+ * @brief ヒストグラム棒グラフ出力
+ * @param count 度数
+ * @param count_max 最大度数（棒の長さの基準）
+ * @return なし
+ */
+static void print_bar(uint64_t count, uint64_t count_max)
+{
+    int length = (count_max) ? (int)((count * HISTOGRAM_BAR_WIDTH + count_max - 1) / count_max) : 0;
+    for (int i = 0; i < length; i++)
+    {
+        putchar('#');
+    }
+    putchar('\n');
+}
+
+/**
+ * @brief スループット出力
+ * @param results 実行結果
+ * @param number_of_games ゲーム数
+ * @param elapsed_seconds バッチ実行時間[s]
+ * @return なし
+ * @details 実機の10ms周期に換算した、1秒あたりのシミュレーション倍率も出す
+ *          表示対象の変化が無かったフレーム（実機で描画・送信を省略できるフレーム）の割合も出す
+ */
+static void report_throughput(const TETRIS_SIM_result_t *results, uint32_t number_of_games, double elapsed_seconds)
+{
+    uint64_t total_frames = 0;
+    uint64_t idle_frames = 0;
+    uint32_t game_over_count = 0;
+    for (uint32_t i = 0; i < number_of_games; i++)
+    {
+        total_frames += results[i].frames;
+        idle_frames += results[i].idle_frames;
+        game_over_count += results[i].is_game_over;
+    }
+
+    double frames_per_second = (0.0 < elapsed_seconds) ? (double)total_frames / elapsed_seconds : 0.0;
+    printf("\n[throughput]\n");
+    printf("elapsed: %.3f s  frames: %llu  frames/s: %.0f  (x%.0f real time)\n",
+           elapsed_seconds, (unsigned long long)total_frames, frames_per_second, frames_per_second / TETRIS_SIM_FRAMES_PER_SECOND);
+    printf("game over: %u  reached frame limit: %u\n", game_over_count, number_of_games - game_over_count);
+    printf("idle frames: %llu (%.1f%%)\n", (unsigned long long)idle_frames, (total_frames) ? 100.0 * (double)idle_frames / (double)total_frames : 0.0);
+}
+
+/**
+ * @brief スコア分布出力
+ * @param results 実行結果
+ * @param number_of_games ゲーム数
+ * @param bucket_width ヒストグラムの階級幅
+ * @return なし
+ */
+static void report_score_distribution(const TETRIS_SIM_result_t *results, uint32_t number_of_games, uint32_t bucket_width)
+{
+    uint32_t *scores = malloc(sizeof(uint32_t) * number_of_games);
+    if (!scores)
+        return;
+
+    double sum = 0.0;
+    double square_sum = 0.0;
+    for (uint32_t i = 0; i < number_of_games; i++)
+    {
+        scores[i] = results[i].score;
+        sum += scores[i];
+        square_sum += (double)scores[i] * scores[i];
+    }
+    qsort(scores, number_of_games, sizeof(uint32_t), compare_uint32);
+
+    double mean = sum / number_of_games;
+    double variance = square_sum / number_of_games - mean * mean;
+    printf("\n[score]\n");
+    printf("min: %u  p10: %u  median: %u  p90: %u  max: %u  mean: %.1f  stddev: %.1f\n",
+           scores[0], scores[number_of_games / 10], scores[number_of_games / 2], scores[(number_of_games * 9) / 10],
+           scores[number_of_games - 1], mean, sqrt((0.0 < variance) ? variance : 0.0));
+
+    // 階級毎の度数
+    uint32_t bucket_max = scores[number_of_games - 1] / bucket_width;
+    uint32_t *counts = calloc(bucket_max + 1, sizeof(uint32_t));
+    if (counts)
+    {
+        uint32_t count_max = 0;
+        for (uint32_t i = 0; i < number_of_games; i++)
+        {
+            uint32_t bucket = scores[i] / bucket_width;
+            counts[bucket]++;
+            count_max = (count_max < counts[bucket]) ? counts[bucket] : count_max;
+        }
+        for (uint32_t bucket = 0; bucket <= bucket_max; bucket++)
+        {
+            if (!counts[bucket])
+                continue;
+            printf("%7u-%-7u %8u ", bucket * bucket_width, (bucket + 1) * bucket_width - 1, counts[bucket]);
+            print_bar(counts[bucket], count_max);
+        }
+        free(counts);
+    }
+
+    free(scores);
+}
+
+/**
+ * @brief 行消去ヒストグラム出力
+ * @param results 実行結果
+ * @param number_of_games ゲーム数
+ * @return なし
+ * @details ミノ接地1回あたりの消去行数（0～4行）の度数と、1ゲームあたりの平均を出す
+ */
+static void report_erase_histogram(const TETRIS_SIM_result_t *results, uint32_t number_of_games)
+{
+    uint64_t histogram[TETRIS_SIM_ERASE_ROW_MAX + 1] = {0};
+    uint64_t count_max = 0;
+    for (uint32_t i = 0; i < number_of_games; i++)
+    {
+        for (int rows = 0; rows <= TETRIS_SIM_ERASE_ROW_MAX; rows++)
+        {
+            histogram[rows] += results[i].erase_histogram[rows];
+        }
+    }
+    for (int rows = 1; rows <= TETRIS_SIM_ERASE_ROW_MAX; rows++) // 0行消去は桁違いに多いので棒の長さの基準から外す
+    {
+        count_max = (count_max < histogram[rows]) ? histogram[rows] : count_max;
+    }
+
+    printf("\n[line clears per lock]\n");
+    for (int rows = 0; rows <= TETRIS_SIM_ERASE_ROW_MAX; rows++)
+    {
+        printf("%d rows %12llu  %10.3f/game ", rows, (unsigned long long)histogram[rows], (double)histogram[rows] / number_of_games);
+        if (rows)
+            print_bar(histogram[rows], count_max);
+        else
+            putchar('\n');
+    }
+}
+
+/**
+ * @brief 到達レベルヒストグラム出力
+ * @param results 実行結果
+ * @param number_of_games ゲーム数
+ * @return なし
+ * @details 到達レベル毎のゲーム数と、そのレベルでの合計消去行数の範囲を出す（レベル変化の検証用）
+ */
+static void report_level_histogram(const TETRIS_SIM_result_t *results, uint32_t number_of_games)
+{
+    uint32_t count[TETRIS_CORE_MAXIMUM_LEVEL + 1] = {0};
+    uint16_t row_min[TETRIS_CORE_MAXIMUM_LEVEL + 1];
+    uint16_t row_max[TETRIS_CORE_MAXIMUM_LEVEL + 1] = {0};
+    uint32_t count_max = 0;
+    memset(row_min, 0xFF, sizeof(row_min));
+
+    for (uint32_t i = 0; i < number_of_games; i++)
+    {
+        uint8_t level = (results[i].level <= TETRIS_CORE_MAXIMUM_LEVEL) ? results[i].level : TETRIS_CORE_MAXIMUM_LEVEL;
+        count[level]++;
+        row_min[level] = (results[i].row_deleted < row_min[level]) ? results[i].row_deleted : row_min[level];
+        row_max[level] = (row_max[level] < results[i].row_deleted) ? results[i].row_deleted : row_max[level];
+    }
+    for (int level = 0; level <= TETRIS_CORE_MAXIMUM_LEVEL; level++)
+    {
+        count_max = (count_max < count[level]) ? count[level] : count_max;
+    }
+
+    printf("\n[final level]\n");
+    for (int level = 1; level <= TETRIS_CORE_MAXIMUM_LEVEL; level++)
+    {
+        if (!count[level])
+            continue;
+        printf("level %d %8u  rows %u-%u ", level, count[level], row_min[level], row_max[level]);
+        print_bar(count[level], count_max);
+    }
+}
@@ -0,0 +1,351 @@
+/**
+ * @file   tetris_sim_policy.c
+ * @brief  tetrisバッチシミュレータ・入力ポリシー実装
+ * @details スクリプトファイルの書式（1行1エントリ、#以降はコメント）
+ *            <入力> [フレーム数]
+ *          入力はL/R/U/D（左右上下。上はハードドロップ）、A（右回転）、B（左回転）、H（ホールド）の組み合わせ、入力無しは「.」
+ *          フレーム数省略時は1フレーム。例：「LD 10」は左＋下入力を10フレーム継続する
+ *          回転入力はゲームコアの仕様通り押下直後の1フレームのみ指定すること
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tetris_sim.h"
+#include "tetris_core.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define SCRIPT_LINE_LENGTH_MAX 256      // スクリプト1行の最大文字数
+#define SCRIPT_REPEAT_MAX 100000        // スクリプト1エントリの最大フレーム数
+#define RANDOM_HOLD_FRAMES_MAX 16       // ランダム入力の継続フレーム数の上限
+#define RANDOM_TURN_PROBABILITY_SHIFT 4 // ランダム入力の回転確率（1/2^n）
+#define POLICY_SEED_SALT 0x9E3779B9     // ミノ順の乱数と系列をずらすための値
+#define PERMILLE 1000                   // 千分率の分母
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static void decide_random_input(TETRIS_SIM_game_t *game_ptr, TETRIS_CORE_input_t *input_ptr);
+static void decide_script_input(const TETRIS_SIM_policy_t *policy_ptr, TETRIS_SIM_game_t *game_ptr, TETRIS_CORE_input_t *input_ptr);
+static void decide_ai_input(const TETRIS_SIM_policy_t *policy_ptr, TETRIS_SIM_game_t *game_ptr, TETRIS_CORE_input_t *input_ptr);
+static uint32_t get_policy_random(TETRIS_SIM_game_t *game_ptr);
+static bool parse_script_keys(const char *keys, TETRIS_CORE_input_t *input_ptr);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief 入力ポリシー状態初期化
+ * @param policy_ptr 入力ポリシー設定
+ * @param game_ptr 1ゲーム分の実行状態
+ * @param seed ゲームのシード
+ * @return なし
+ */
+void TETRIS_SIM_initialize_policy(const TETRIS_SIM_policy_t *policy_ptr, TETRIS_SIM_game_t *game_ptr, uint32_t seed)
+{
+    uint32_t policy_seed = seed ^ POLICY_SEED_SALT;
+    game_ptr->policy_random_state = (policy_seed) ? policy_seed : POLICY_SEED_SALT;
+    game_ptr->policy_hold_frames = 0;
+    game_ptr->script_position = 0;
+    memset(&game_ptr->previous_input, 0, sizeof(game_ptr->previous_input));
+    TETRIS_CORE_ai_initialize_player(&game_ptr->ai_player, policy_ptr->is_ai_lookahead_enabled);
+}
+
+/**
+ * @brief 入力決定
+ * @param policy_ptr 入力ポリシー設定
+ * @param game_ptr 1ゲーム分の実行状態
+ * @param input_ptr 入力格納先
+ * @return なし
+ */
+void TETRIS_SIM_decide_input(const TETRIS_SIM_policy_t *policy_ptr, TETRIS_SIM_game_t *game_ptr, TETRIS_CORE_input_t *input_ptr)
+{
+    memset(input_ptr, 0, sizeof(*input_ptr));
+
+    switch (policy_ptr->type)
+    {
+    case policy_script:
+        decide_script_input(policy_ptr, game_ptr, input_ptr);
+        break;
+    case policy_ai:
+        decide_ai_input(policy_ptr, game_ptr, input_ptr);
+        break;
+    case policy_random:
+    default:
+        decide_random_input(game_ptr, input_ptr);
+        break;
+    }
+
+    game_ptr->previous_input = *input_ptr;
+}
+
+/**
+ * @brief スクリプトファイル読み込み
+ * @param path スクリプトファイルパス
+ * @param script_ptr 読み込んだ入力列の格納先（呼び出し側でfreeすること）
+ * @param script_length_ptr 入力列のフレーム数格納先
+ * @return 0：正常終了、-1：読み込み失敗（エラー内容は標準エラー出力に出す）
+ */
+int TETRIS_SIM_load_script(const char *path, TETRIS_CORE_input_t **script_ptr, size_t *script_length_ptr)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+    {
+        fprintf(stderr, "cannot open script: %s\n", path);
+        return -1;
+    }
+
+    TETRIS_CORE_input_t *script = NULL;
+    size_t script_length = 0;
+    size_t script_capacity = 0;
+    char line[SCRIPT_LINE_LENGTH_MAX];
+    unsigned line_number = 0;
+    int status = 0;
+
+    while (fgets(line, sizeof(line), file))
+    {
+        line_number++;
+        char *comment = strchr(line, '#');
+        if (comment)
+            *comment = '\0';
+
+        char keys[SCRIPT_LINE_LENGTH_MAX];
+        long repeat = 1;
+        int fields = sscanf(line, "%255s %ld", keys, &repeat);
+        if (fields < 1) // 空行
+            continue;
+
+        TETRIS_CORE_input_t input;
+        if (!parse_script_keys(keys, &input) || repeat < 1 || SCRIPT_REPEAT_MAX < repeat)
+        {
+            fprintf(stderr, "%s:%u: invalid script entry\n", path, line_number);
+            status = -1;
+            break;
+        }
+
+        if (script_capacity < script_length + (size_t)repeat)
+        {
+            size_t new_capacity = (script_capacity) ? script_capacity * 2 : 256;
+            while (new_capacity < script_length + (size_t)repeat)
+                new_capacity *= 2;
+
+            TETRIS_CORE_input_t *new_script = realloc(script, sizeof(TETRIS_CORE_input_t) * new_capacity);
+            if (!new_script)
+            {
+                fprintf(stderr, "out of memory while loading script\n");
+                status = -1;
+                break;
+            }
+            script = new_script;
+            script_capacity = new_capacity;
+        }
+
+        for (long i = 0; i < repeat; i++)
+        {
+            script[script_length++] = input;
+        }
+    }
+    fclose(file);
+
+    if (!status && !script_length)
+    {
+        fprintf(stderr, "%s: script is empty\n", path);
+        status = -1;
+    }
+    if (status)
+    {
+        free(script);
+        return -1;
+    }
+
+    *script_ptr = script;
+    *script_length_ptr = script_length;
+    return 0;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief ランダム入力決定
+ * @param game_ptr 1ゲーム分の実行状態
+ * @param input_ptr 入力格納先
+ * @return なし
+ * @details 左・右・下・入力無しのいずれかを数フレーム継続させる（ミノ移動カウンタの閾値を超えられるようにするため）
+ *          回転は前フレームで回転入力が無い場合に一定確率で入力する
+ */
+static void decide_random_input(TETRIS_SIM_game_t *game_ptr, TETRIS_CORE_input_t *input_ptr)
+{
+    if (game_ptr->policy_hold_frames)
+    {
+        // 前フレームの移動入力を継続
+        game_ptr->policy_hold_frames--;
+        input_ptr->is_input_L = game_ptr->previous_input.is_input_L;
+        input_ptr->is_input_R = game_ptr->previous_input.is_input_R;
+        input_ptr->is_input_D = game_ptr->previous_input.is_input_D;
+    }
+    else
+    {
+        // 移動入力の選び直し（左2：右2：下1：入力無し3）
+        uint32_t random = get_policy_random(game_ptr);
+        switch (random % 8)
+        {
+        case 0:
+        case 1:
+            input_ptr->is_input_L = true;
+            break;
+        case 2:
+        case 3:
+            input_ptr->is_input_R = true;
+            break;
+        case 4:
+            input_ptr->is_input_D = true;
+            break;
+        default:
+            break;
+        }
+        game_ptr->policy_hold_frames = (random >> 8) % RANDOM_HOLD_FRAMES_MAX;
+    }
+
+    // 回転入力（押下直後の1フレームのみ）
+    if (!game_ptr->previous_input.is_input_turnR && !game_ptr->previous_input.is_input_turnL)
+    {
+        uint32_t random = get_policy_random(game_ptr);
+        if (!(random & ((1u << RANDOM_TURN_PROBABILITY_SHIFT) - 1)))
+        {
+            input_ptr->is_input_turnR = (random >> 16) & 1;
+            input_ptr->is_input_turnL = !input_ptr->is_input_turnR;
+        }
+    }
+}
+
+/**
+ * @brief スクリプト入力決定
+ * @param policy_ptr 入力ポリシー設定
+ * @param game_ptr 1ゲーム分の実行状態
+ * @param input_ptr 入力格納先
+ * @return なし
+ * @details スクリプトを先頭から1フレームずつ再生し、末尾まで来たら先頭に戻る
+ */
+static void decide_script_input(const TETRIS_SIM_policy_t *policy_ptr, TETRIS_SIM_game_t *game_ptr, TETRIS_CORE_input_t *input_ptr)
+{
+    if (!policy_ptr->script_length)
+        return;
+
+    *input_ptr = policy_ptr->script[game_ptr->script_position];
+    game_ptr->script_position = (game_ptr->script_position + 1) % policy_ptr->script_length;
+}
+
+/**
+ * @brief 自動操作入力決定
+ * @param policy_ptr 入力ポリシー設定
+ * @param game_ptr 1ゲーム分の実行状態
+ * @param input_ptr 入力格納先
+ * @return なし
+ * @details 評価重みの指定が無い場合はゲームコアの既定値を使う
+ *          腕前の模擬：新ミノ出現後は反応時間分だけ入力無しとし、配置探索の直後に一定確率で目標配置を左右に1列ずらす
+ */
+static void decide_ai_input(const TETRIS_SIM_policy_t *policy_ptr, TETRIS_SIM_game_t *game_ptr, TETRIS_CORE_input_t *input_ptr)
+{
+    const TETRIS_CORE_ai_weight_t *weight_ptr = (policy_ptr->ai_weight) ? policy_ptr->ai_weight : &TETRIS_CORE_ai_weight_default;
+
+    // 反応時間（ミノ生成待ちの間にカウントを仕込み、生成後にカウントが無くなるまで入力無し）
+    if (game_ptr->core_state.mino_parameter.is_next_mino_generate)
+    {
+        game_ptr->policy_hold_frames = policy_ptr->ai_reaction_frames;
+    }
+    else if (game_ptr->policy_hold_frames)
+    {
+        game_ptr->policy_hold_frames--;
+        return;
+    }
+
+    bool is_searched = TETRIS_CORE_ai_decide_input(&game_ptr->ai_player, &game_ptr->core_state, weight_ptr, input_ptr);
+
+    // 配置ミス（ずらした先に置けない場合は壁・ブロックに阻まれた位置にそのまま落ちる）
+    if (is_searched && policy_ptr->ai_mistake_permille && get_policy_random(game_ptr) % PERMILLE < policy_ptr->ai_mistake_permille)
+    {
+        game_ptr->ai_player.target.reference_x += (get_policy_random(game_ptr) & 1) ? 1 : -1;
+    }
+
+    if (policy_ptr->is_ai_drop_disabled)
+    {
+        input_ptr->is_input_U = false;
+        input_ptr->is_input_D = false;
+    }
+}
+
+/**
+ * @brief ポリシー用疑似乱数取得
+ * @param game_ptr 1ゲーム分の実行状態
+ * @return 疑似乱数（xorshift32）
+ */
+static uint32_t get_policy_random(TETRIS_SIM_game_t *game_ptr)
+{
+    uint32_t x = game_ptr->policy_random_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    game_ptr->policy_random_state = x;
+
+    return x;
+}
+
+/**
+ * @brief スクリプト入力文字列解析
+ * @param keys 入力文字列
+ * @param input_ptr 入力格納先
+ * @return true：解析成功、false：不正な文字を含む
+ */
+static bool parse_script_keys(const char *keys, TETRIS_CORE_input_t *input_ptr)
+{
+    memset(input_ptr, 0, sizeof(*input_ptr));
+
+    for (const char *key = keys; *key; key++)
+    {
+        switch (*key)
+        {
+        case 'L':
+            input_ptr->is_input_L = true;
+            break;
+        case 'R':
+            input_ptr->is_input_R = true;
+            break;
+        case 'U':
+            input_ptr->is_input_U = true;
+            break;
+        case 'D':
+            input_ptr->is_input_D = true;
+            break;
+        case 'A':
+            input_ptr->is_input_turnR = true;
+            break;
+        case 'B':
+            input_ptr->is_input_turnL = true;
+            break;
+        case 'H':
+            input_ptr->is_input_hold = true;
+            break;
+        case '.':
+            break;
+        default:
+            return false;
+        }
+    }
+
+    return true;
+}
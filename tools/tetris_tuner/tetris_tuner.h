@@ -0,0 +1,93 @@
+/**
+ * @file   tetris_tuner.h
+ * @brief  tetris自動操作 評価重みチューナ・外部公開定義
+ * @details 遺伝的アルゴリズムで自動操作の盤面評価重みを最適化する
+ *          各候補はシード固定のゲームを複数回プレイした平均成績で評価し、(候補, ゲーム)の組を全コアで並列実行する
+ */
+
+#ifndef __TETRIS_TUNER_H__
+#define __TETRIS_TUNER_H__
+
+//======================================================
+// インクルード
+//======================================================
+#include <stdio.h>
+#include "typedef.h"
+#include "tetris_core.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define TETRIS_TUNER_NUMBER_OF_GENES 4   // 遺伝子数（評価重みの要素数）
+#define TETRIS_TUNER_POPULATION_MAX 1024 // 個体数の上限
+#define TETRIS_TUNER_WEIGHT_SCALE 1000.0 // 遺伝子（単位ベクトル）から整数重みへの変換倍率
+
+//======================================================
+// 型定義
+//======================================================
+/**
+ * @brief 適応度指標定義
+ */
+typedef enum
+{
+    fitness_lines = 0, /**< 平均消去行数 */
+    fitness_score,     /**< 平均スコア */
+} TETRIS_TUNER_fitness_metric_t;
+
+/**
+ * @brief 個体定義
+ * @details 遺伝子は評価重みの向きのみを表す単位ベクトル（評価値の大小関係は重みの定数倍で変わらないため）
+ */
+typedef struct
+{
+    double gene[TETRIS_TUNER_NUMBER_OF_GENES]; /**< 遺伝子（lines, aggregate_height, holes, bumpinessの順） */
+    double fitness;                            /**< 適応度（未評価時は負値） */
+} TETRIS_TUNER_individual_t;
+
+/**
+ * @brief チューナ設定定義
+ */
+typedef struct
+{
+    uint32_t population_size;             /**< 個体数 */
+    uint32_t generations;                 /**< 実行する世代数（再開時は通算世代数） */
+    uint32_t games_per_individual;        /**< 1個体あたりの評価ゲーム数 */
+    uint32_t frame_limit;                 /**< 1ゲームの最大フレーム数 */
+    uint32_t number_of_threads;           /**< ワーカスレッド数 */
+    bool is_lookahead_enabled;            /**< 2手読みで評価するか */
+    TETRIS_TUNER_fitness_metric_t metric; /**< 適応度指標 */
+} TETRIS_TUNER_config_t;
+
+/**
+ * @brief チューナ状態定義
+ * @details チェックポイントに保存される内容。これだけで探索を再開できる
+ */
+typedef struct
+{
+    uint32_t generation;                                               /**< 完了した世代数 */
+    uint64_t random_state;                                             /**< 疑似乱数状態 */
+    uint32_t base_seed;                                                /**< ゲームシードの基準値 */
+    uint32_t population_size;                                          /**< 個体数 */
+    TETRIS_TUNER_individual_t population[TETRIS_TUNER_POPULATION_MAX]; /**< 個体群 */
+} TETRIS_TUNER_state_t;
+
+//======================================================
+// グローバル変数・定数extern宣言
+//======================================================
+
+//======================================================
+// グローバル関数extern宣言
+//======================================================
+/* ga */
+extern void TETRIS_TUNER_initialize_population(TETRIS_TUNER_state_t *state_ptr, uint32_t population_size, uint32_t base_seed, uint64_t random_seed);
+extern int TETRIS_TUNER_evaluate_population(const TETRIS_TUNER_config_t *config_ptr, TETRIS_TUNER_state_t *state_ptr);
+extern void TETRIS_TUNER_evolve_population(TETRIS_TUNER_state_t *state_ptr);
+extern const TETRIS_TUNER_individual_t *TETRIS_TUNER_get_best_individual(const TETRIS_TUNER_state_t *state_ptr);
+extern void TETRIS_TUNER_convert_to_weight(const TETRIS_TUNER_individual_t *individual_ptr, TETRIS_CORE_ai_weight_t *weight_ptr);
+
+/* io */
+extern int TETRIS_TUNER_save_checkpoint(const char *path, const TETRIS_TUNER_state_t *state_ptr);
+extern int TETRIS_TUNER_load_checkpoint(const char *path, TETRIS_TUNER_state_t *state_ptr);
+extern int TETRIS_TUNER_write_weight_header(const char *path, const TETRIS_TUNER_state_t *state_ptr, const TETRIS_TUNER_config_t *config_ptr);
+
+#endif /* __TETRIS_TUNER_H__ */
@@ -0,0 +1,373 @@
+/**
+ * @file   tetris_tuner_ga.c
+ * @brief  tetris自動操作 評価重みチューナ・遺伝的アルゴリズム実装
+ * @details 1世代の流れ：全個体を同じシード列のゲームで評価 → 適応度順に整列 → 下位を子個体で置き換え
+ *          評価は(個体, ゲーム)の組を1ジョブとし、ワーカスレッドが共有カウンタからジョブを取り出して実行する
+ *          ジョブ数が個体数×ゲーム数あるので、スレッド数を増やしてもスレッド間の負荷が偏りにくい
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tetris_tuner.h"
+#include "tetris_sim.h"
+#include "tetris_core.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define OFFSPRING_RATE 0.3       // 1世代で子個体に置き換える割合
+#define TOURNAMENT_RATE 0.1      // トーナメント選択で抽出する個体の割合
+#define MUTATION_PROBABILITY 0.2 // 子個体が突然変異する確率
+#define MUTATION_RANGE 0.2       // 突然変異で遺伝子に加える値の範囲（±）
+
+//======================================================
+// 型定義
+//======================================================
+/**
+ * @brief 評価ジョブ共有情報定義
+ * @details ワーカスレッド間で共有する。書き換えるのはジョブカウンタ（atomic）と、各ジョブ固有の結果格納先のみ
+ */
+typedef struct
+{
+    const TETRIS_TUNER_config_t *config_ptr;      /**< チューナ設定 */
+    const TETRIS_SIM_batch_config_t *sim_configs; /**< 個体毎のシミュレーション設定 */
+    uint32_t seed_offset;                         /**< この世代のゲームシードの基準値 */
+    uint32_t number_of_jobs;                      /**< ジョブ数（個体数×ゲーム数） */
+    atomic_uint next_job;                         /**< 次に取り出すジョブ番号 */
+    double *job_fitness;                          /**< ジョブ毎の成績格納先 */
+} tuner_evaluation_t;
+
+//======================================================
+// 変数・定数
+//======================================================
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static void *run_evaluation_worker(void *argument_ptr);
+static int compare_fitness_descending(const void *a, const void *b);
+static void normalize_gene(double gene[]);
+static uint64_t get_random(TETRIS_TUNER_state_t *state_ptr);
+static double get_random_uniform(TETRIS_TUNER_state_t *state_ptr, double minimum, double maximum);
+static const TETRIS_TUNER_individual_t *select_by_tournament(TETRIS_TUNER_state_t *state_ptr);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief 初期個体群生成
+ * @param state_ptr チューナ状態
+ * @param population_size 個体数
+ * @param base_seed ゲームシードの基準値
+ * @param random_seed 遺伝的操作用の疑似乱数シード
+ * @return なし
+ * @details 個体0は現在の既定の評価重みとし、残りは乱数で生成する（既定値より悪い結果にならないようにするため）
+ */
+void TETRIS_TUNER_initialize_population(TETRIS_TUNER_state_t *state_ptr, uint32_t population_size, uint32_t base_seed, uint64_t random_seed)
+{
+    state_ptr->generation = 0;
+    state_ptr->random_state = (random_seed) ? random_seed : 1;
+    state_ptr->base_seed = base_seed;
+    state_ptr->population_size = population_size;
+
+    for (uint32_t i = 0; i < population_size; i++)
+    {
+        TETRIS_TUNER_individual_t *individual_ptr = &state_ptr->population[i];
+        if (!i)
+        {
+            individual_ptr->gene[0] = TETRIS_CORE_ai_weight_default.lines;
+            individual_ptr->gene[1] = TETRIS_CORE_ai_weight_default.aggregate_height;
+            individual_ptr->gene[2] = TETRIS_CORE_ai_weight_default.holes;
+            individual_ptr->gene[3] = TETRIS_CORE_ai_weight_default.bumpiness;
+        }
+        else
+        {
+            for (int gene_index = 0; gene_index < TETRIS_TUNER_NUMBER_OF_GENES; gene_index++)
+            {
+                individual_ptr->gene[gene_index] = get_random_uniform(state_ptr, -1.0, 1.0);
+            }
+        }
+        normalize_gene(individual_ptr->gene);
+        individual_ptr->fitness = -1.0;
+    }
+}
+
+/**
+ * @brief 個体群評価
+ * @param config_ptr チューナ設定
+ * @param state_ptr チューナ状態
+ * @return 0：正常終了、-1：メモリ確保・スレッド生成失敗
+ * @details 世代毎にシード列を変えつつ、同じ世代の全個体には同じシード列を使う（個体間の比較を公平にするため）
+ */
+int TETRIS_TUNER_evaluate_population(const TETRIS_TUNER_config_t *config_ptr, TETRIS_TUNER_state_t *state_ptr)
+{
+    uint32_t population_size = state_ptr->population_size;
+    uint32_t number_of_threads = (config_ptr->number_of_threads) ? config_ptr->number_of_threads : 1;
+
+    TETRIS_CORE_ai_weight_t *weights = malloc(sizeof(TETRIS_CORE_ai_weight_t) * population_size);
+    TETRIS_SIM_batch_config_t *sim_configs = malloc(sizeof(TETRIS_SIM_batch_config_t) * population_size);
+    double *job_fitness = malloc(sizeof(double) * population_size * config_ptr->games_per_individual);
+    pthread_t *threads = malloc(sizeof(pthread_t) * number_of_threads);
+    int status = (weights && sim_configs && job_fitness && threads) ? 0 : -1;
+
+    if (!status)
+    {
+        // 個体毎のシミュレーション設定（評価中は読み出し専用）
+        for (uint32_t i = 0; i < population_size; i++)
+        {
+            TETRIS_TUNER_convert_to_weight(&state_ptr->population[i], &weights[i]);
+            sim_configs[i] = (TETRIS_SIM_batch_config_t){
+                .number_of_games = config_ptr->games_per_individual,
+                .number_of_threads = 1,
+                .base_seed = 0,
+                .frame_limit = config_ptr->frame_limit,
+                .policy = {.type = policy_ai, .ai_weight = &weights[i], .is_ai_lookahead_enabled = config_ptr->is_lookahead_enabled},
+            };
+        }
+
+        tuner_evaluation_t evaluation = {
+            .config_ptr = config_ptr,
+            .sim_configs = sim_configs,
+            .seed_offset = state_ptr->base_seed + state_ptr->generation * config_ptr->games_per_individual,
+            .number_of_jobs = population_size * config_ptr->games_per_individual,
+            .job_fitness = job_fitness,
+        };
+        atomic_init(&evaluation.next_job, 0);
+
+        // ワーカスレッドで全ジョブを実行（一部のスレッドが作れなくても、作れたスレッドで全ジョブを処理する）
+        uint32_t created = 0;
+        while (created < number_of_threads && !pthread_create(&threads[created], NULL, run_evaluation_worker, &evaluation))
+            created++;
+        for (uint32_t i = 0; i < created; i++)
+        {
+            pthread_join(threads[i], NULL);
+        }
+
+        if (!created)
+        {
+            status = -1;
+        }
+        else
+        {
+            // 適応度 = ゲーム成績の平均
+            for (uint32_t i = 0; i < population_size; i++)
+            {
+                double sum = 0.0;
+                for (uint32_t game = 0; game < config_ptr->games_per_individual; game++)
+                {
+                    sum += job_fitness[i * config_ptr->games_per_individual + game];
+                }
+                state_ptr->population[i].fitness = sum / config_ptr->games_per_individual;
+            }
+        }
+    }
+
+    free(weights);
+    free(sim_configs);
+    free(job_fitness);
+    free(threads);
+    return status;
+}
+
+/**
+ * @brief 世代交代
+ * @param state_ptr チューナ状態（評価済みであること）
+ * @return なし
+ * @details 適応度順に整列し、下位OFFSPRING_RATEの個体を子個体で置き換える
+ *          子個体はトーナメント選択した2個体の遺伝子を適応度で重み付け平均し、一定確率で1遺伝子を変異させる
+ */
+void TETRIS_TUNER_evolve_population(TETRIS_TUNER_state_t *state_ptr)
+{
+    uint32_t population_size = state_ptr->population_size;
+    qsort(state_ptr->population, population_size, sizeof(TETRIS_TUNER_individual_t), compare_fitness_descending);
+
+    uint32_t offspring_count = (uint32_t)(population_size * OFFSPRING_RATE);
+    if (!offspring_count && 1 < population_size)
+        offspring_count = 1;
+
+    // 子個体は親を選ぶ対象（上位）を書き換えないよう、一旦別領域に作る
+    TETRIS_TUNER_individual_t offspring[TETRIS_TUNER_POPULATION_MAX];
+    for (uint32_t i = 0; i < offspring_count; i++)
+    {
+        const TETRIS_TUNER_individual_t *parent1_ptr = select_by_tournament(state_ptr);
+        const TETRIS_TUNER_individual_t *parent2_ptr = select_by_tournament(state_ptr);
+        double fitness1 = (0.0 < parent1_ptr->fitness) ? parent1_ptr->fitness : 0.0;
+        double fitness2 = (0.0 < parent2_ptr->fitness) ? parent2_ptr->fitness : 0.0;
+        if (fitness1 + fitness2 <= 0.0)
+            fitness1 = fitness2 = 1.0;
+
+        for (int gene_index = 0; gene_index < TETRIS_TUNER_NUMBER_OF_GENES; gene_index++)
+        {
+            offspring[i].gene[gene_index] = fitness1 * parent1_ptr->gene[gene_index] + fitness2 * parent2_ptr->gene[gene_index];
+        }
+        normalize_gene(offspring[i].gene);
+
+        if (get_random_uniform(state_ptr, 0.0, 1.0) < MUTATION_PROBABILITY)
+        {
+            int gene_index = (int)(get_random(state_ptr) % TETRIS_TUNER_NUMBER_OF_GENES);
+            offspring[i].gene[gene_index] += get_random_uniform(state_ptr, -MUTATION_RANGE, MUTATION_RANGE);
+            normalize_gene(offspring[i].gene);
+        }
+        offspring[i].fitness = -1.0;
+    }
+
+    memcpy(&state_ptr->population[population_size - offspring_count], offspring, sizeof(TETRIS_TUNER_individual_t) * offspring_count);
+    state_ptr->generation++;
+}
+
+/**
+ * @brief 最良個体取得
+ * @param state_ptr チューナ状態
+ * @return 適応度が最大の個体
+ */
+const TETRIS_TUNER_individual_t *TETRIS_TUNER_get_best_individual(const TETRIS_TUNER_state_t *state_ptr)
+{
+    const TETRIS_TUNER_individual_t *best_ptr = &state_ptr->population[0];
+    for (uint32_t i = 1; i < state_ptr->population_size; i++)
+    {
+        if (best_ptr->fitness < state_ptr->population[i].fitness)
+            best_ptr = &state_ptr->population[i];
+    }
+
+    return best_ptr;
+}
+
+/**
+ * @brief 遺伝子 → 評価重み変換
+ * @param individual_ptr 個体
+ * @param weight_ptr 評価重み格納先
+ * @return なし
+ */
+void TETRIS_TUNER_convert_to_weight(const TETRIS_TUNER_individual_t *individual_ptr, TETRIS_CORE_ai_weight_t *weight_ptr)
+{
+    weight_ptr->lines = (int16_t)lround(individual_ptr->gene[0] * TETRIS_TUNER_WEIGHT_SCALE);
+    weight_ptr->aggregate_height = (int16_t)lround(individual_ptr->gene[1] * TETRIS_TUNER_WEIGHT_SCALE);
+    weight_ptr->holes = (int16_t)lround(individual_ptr->gene[2] * TETRIS_TUNER_WEIGHT_SCALE);
+    weight_ptr->bumpiness = (int16_t)lround(individual_ptr->gene[3] * TETRIS_TUNER_WEIGHT_SCALE);
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief 評価ワーカスレッド処理
+ * @param argument_ptr 評価ジョブ共有情報
+ * @return NULL
+ * @details ジョブ番号 = 個体番号×ゲーム数 + ゲーム番号。ゲーム番号が同じなら個体に関わらず同じシードを使う
+ */
+static void *run_evaluation_worker(void *argument_ptr)
+{
+    tuner_evaluation_t *evaluation_ptr = argument_ptr;
+    uint32_t games_per_individual = evaluation_ptr->config_ptr->games_per_individual;
+
+    while (true)
+    {
+        uint32_t job = atomic_fetch_add(&evaluation_ptr->next_job, 1);
+        if (evaluation_ptr->number_of_jobs <= job)
+            break;
+
+        uint32_t individual_index = job / games_per_individual;
+        uint32_t game_index = job % games_per_individual;
+
+        TETRIS_SIM_result_t result;
+        TETRIS_SIM_run_game(&evaluation_ptr->sim_configs[individual_index], evaluation_ptr->seed_offset + game_index, &result);
+        evaluation_ptr->job_fitness[job] = (fitness_score == evaluation_ptr->config_ptr->metric) ? (double)result.score : (double)result.row_deleted;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 適応度比較（qsort用、降順）
+ */
+static int compare_fitness_descending(const void *a, const void *b)
+{
+    double fitness_a = ((const TETRIS_TUNER_individual_t *)a)->fitness;
+    double fitness_b = ((const TETRIS_TUNER_individual_t *)b)->fitness;
+
+    return (fitness_a < fitness_b) - (fitness_a > fitness_b);
+}
+
+/**
+ * @brief 遺伝子正規化
+ * @param gene 遺伝子
+ * @return なし
+ * @details 単位ベクトルにする。全要素0の場合は変更しない
+ */
+static void normalize_gene(double gene[])
+{
+    double norm = 0.0;
+    for (int gene_index = 0; gene_index < TETRIS_TUNER_NUMBER_OF_GENES; gene_index++)
+    {
+        norm += gene[gene_index] * gene[gene_index];
+    }
+    norm = sqrt(norm);
+    if (norm <= 0.0)
+        return;
+
+    for (int gene_index = 0; gene_index < TETRIS_TUNER_NUMBER_OF_GENES; gene_index++)
+    {
+        gene[gene_index] /= norm;
+    }
+}
+
+/**
+ * @brief 疑似乱数取得
+ * @param state_ptr チューナ状態
+ * @return 疑似乱数（xorshift64）
+ * @details 遺伝的操作はメインスレッドのみで行うので、状態はチューナ状態に1つだけ持つ（チェックポイントに保存される）
+ */
+static uint64_t get_random(TETRIS_TUNER_state_t *state_ptr)
+{
+    uint64_t x = state_ptr->random_state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    state_ptr->random_state = x;
+
+    return x;
+}
+
+/**
+ * @brief 一様乱数取得
+ * @param state_ptr チューナ状態
+ * @param minimum 最小値
+ * @param maximum 最大値
+ * @return [minimum, maximum)の一様乱数
+ */
+static double get_random_uniform(TETRIS_TUNER_state_t *state_ptr, double minimum, double maximum)
+{
+    double unit = (double)(get_random(state_ptr) >> 11) / (double)(1ULL << 53);
+
+    return minimum + (maximum - minimum) * unit;
+}
+
+/**
+ * @brief トーナメント選択
+ * @param state_ptr チューナ状態
+ * @return 選ばれた個体
+ * @details 個体群から無作為にTOURNAMENT_RATE分（最低2個体）を抽出し、その中で適応度が最大の個体を返す
+ */
+static const TETRIS_TUNER_individual_t *select_by_tournament(TETRIS_TUNER_state_t *state_ptr)
+{
+    uint32_t tournament_size = (uint32_t)(state_ptr->population_size * TOURNAMENT_RATE);
+    if (tournament_size < 2)
+        tournament_size = 2;
+
+    const TETRIS_TUNER_individual_t *best_ptr = NULL;
+    for (uint32_t i = 0; i < tournament_size; i++)
+    {
+        const TETRIS_TUNER_individual_t *candidate_ptr = &state_ptr->population[get_random(state_ptr) % state_ptr->population_size];
+        if (!best_ptr || best_ptr->fitness < candidate_ptr->fitness)
+            best_ptr = candidate_ptr;
+    }
+
+    return best_ptr;
+}
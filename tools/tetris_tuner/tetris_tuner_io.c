@@ -0,0 +1,216 @@
+/**
+ * @file   tetris_tuner_io.c
+ * @brief  tetris自動操作 評価重みチューナ・ファイル入出力実装
+ * @details チェックポイントはテキスト形式（1行目に識別子とバージョン、以降キーと値、個体は1行1個体）
+ *          書き込み途中で中断されても前回のチェックポイントが壊れないよう、一時ファイルに書いてから置き換える
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "tetris_tuner.h"
+#include "tetris_core.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define CHECKPOINT_MAGIC "tetris_tuner_checkpoint"
+#define CHECKPOINT_VERSION 1
+#define PATH_LENGTH_MAX 4096 // ファイルパスの最大文字数
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+static const char *const metric_name[] = {"lines", "score"}; // 適応度指標名（TETRIS_TUNER_fitness_metric_tの順）
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static int replace_file(const char *temporary_path, const char *path);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief チェックポイント保存
+ * @param path 保存先ファイルパス
+ * @param state_ptr チューナ状態
+ * @return 0：正常終了、-1：書き込み失敗
+ * @details 遺伝子は%.17gで書き出し、再開時に完全に同じ値へ戻せるようにする
+ */
+int TETRIS_TUNER_save_checkpoint(const char *path, const TETRIS_TUNER_state_t *state_ptr)
+{
+    char temporary_path[PATH_LENGTH_MAX];
+    if ((int)sizeof(temporary_path) <= snprintf(temporary_path, sizeof(temporary_path), "%s.tmp", path))
+        return -1;
+
+    FILE *file = fopen(temporary_path, "w");
+    if (!file)
+        return -1;
+
+    fprintf(file, "%s %d\n", CHECKPOINT_MAGIC, CHECKPOINT_VERSION);
+    fprintf(file, "generation %" PRIu32 "\n", state_ptr->generation);
+    fprintf(file, "random %" PRIu64 "\n", state_ptr->random_state);
+    fprintf(file, "base_seed %" PRIu32 "\n", state_ptr->base_seed);
+    fprintf(file, "population %" PRIu32 "\n", state_ptr->population_size);
+    for (uint32_t i = 0; i < state_ptr->population_size; i++)
+    {
+        const TETRIS_TUNER_individual_t *individual_ptr = &state_ptr->population[i];
+        for (int gene_index = 0; gene_index < TETRIS_TUNER_NUMBER_OF_GENES; gene_index++)
+        {
+            fprintf(file, "%.17g ", individual_ptr->gene[gene_index]);
+        }
+        fprintf(file, "%.17g\n", individual_ptr->fitness);
+    }
+
+    int status = (ferror(file)) ? -1 : 0;
+    if (fclose(file))
+        status = -1;
+
+    return (status) ? -1 : replace_file(temporary_path, path);
+}
+
+/**
+ * @brief チェックポイント読み込み
+ * @param path チェックポイントファイルパス
+ * @param state_ptr チューナ状態格納先
+ * @return 0：正常終了、-1：読み込み失敗（エラー内容は標準エラー出力に出す）
+ */
+int TETRIS_TUNER_load_checkpoint(const char *path, TETRIS_TUNER_state_t *state_ptr)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+    {
+        fprintf(stderr, "cannot open checkpoint: %s\n", path);
+        return -1;
+    }
+
+    char magic[32];
+    int version = 0;
+    int status = 0;
+    if (fscanf(file, "%31s %d", magic, &version) != 2 || strcmp(magic, CHECKPOINT_MAGIC) || CHECKPOINT_VERSION != version ||
+        fscanf(file, " generation %" SCNu32, &state_ptr->generation) != 1 ||
+        fscanf(file, " random %" SCNu64, &state_ptr->random_state) != 1 ||
+        fscanf(file, " base_seed %" SCNu32, &state_ptr->base_seed) != 1 ||
+        fscanf(file, " population %" SCNu32, &state_ptr->population_size) != 1 ||
+        !state_ptr->population_size || TETRIS_TUNER_POPULATION_MAX < state_ptr->population_size)
+    {
+        status = -1;
+    }
+
+    for (uint32_t i = 0; !status && i < state_ptr->population_size; i++)
+    {
+        TETRIS_TUNER_individual_t *individual_ptr = &state_ptr->population[i];
+        for (int gene_index = 0; !status && gene_index < TETRIS_TUNER_NUMBER_OF_GENES; gene_index++)
+        {
+            status = (fscanf(file, "%lf", &individual_ptr->gene[gene_index]) == 1) ? 0 : -1;
+        }
+        if (!status)
+            status = (fscanf(file, "%lf", &individual_ptr->fitness) == 1) ? 0 : -1;
+    }
+    fclose(file);
+
+    if (status)
+        fprintf(stderr, "%s: broken checkpoint\n", path);
+
+    return status;
+}
+
+/**
+ * @brief 評価重みヘッダ出力
+ * @param path 出力先ファイルパス（src/app/tetris_core/tetris_core_ai_weight.hを想定）
+ * @param state_ptr チューナ状態（評価済みであること）
+ * @param config_ptr チューナ設定
+ * @return 0：正常終了、-1：書き込み失敗
+ * @details 最良個体の評価重みを、ファームウェアがそのままインクルードできる形式で出力する
+ */
+int TETRIS_TUNER_write_weight_header(const char *path, const TETRIS_TUNER_state_t *state_ptr, const TETRIS_TUNER_config_t *config_ptr)
+{
+    char temporary_path[PATH_LENGTH_MAX];
+    if ((int)sizeof(temporary_path) <= snprintf(temporary_path, sizeof(temporary_path), "%s.tmp", path))
+        return -1;
+
+    FILE *file = fopen(temporary_path, "w");
+    if (!file)
+        return -1;
+
+    const TETRIS_TUNER_individual_t *best_ptr = TETRIS_TUNER_get_best_individual(state_ptr);
+    TETRIS_CORE_ai_weight_t weight;
+    TETRIS_TUNER_convert_to_weight(best_ptr, &weight);
+
+    fprintf(file,
+            "/**\n"
+            " * @file   tetris_core_ai_weight.h\n"
+            " * @brief  tetrisゲームコア・自動操作 盤面評価重み定義\n"
+            " * @details tools/tetris_tunerの出力で置き換える（-oオプション）。手動で調整する場合も同じ書式を保つこと\n"
+            " *          generation %" PRIu32 ", population %" PRIu32 ", %" PRIu32 " games/individual, %s, fitness(%s) %.1f\n"
+            " */\n"
+            "\n"
+            "#ifndef __TETRIS_CORE_AI_WEIGHT_H__\n"
+            "#define __TETRIS_CORE_AI_WEIGHT_H__\n"
+            "\n"
+            "//======================================================\n"
+            "// マクロ定義\n"
+            "//======================================================\n",
+            state_ptr->generation, state_ptr->population_size, config_ptr->games_per_individual,
+            (config_ptr->is_lookahead_enabled) ? "lookahead" : "current mino only", metric_name[config_ptr->metric], best_ptr->fitness);
+
+    // マクロ定義（末尾コメントの位置を揃える）
+    const struct
+    {
+        const char *name;
+        int16_t value;
+        const char *comment;
+    } weight_macros[TETRIS_TUNER_NUMBER_OF_GENES] = {
+        {"LINES", weight.lines, "消去行数の重み"},
+        {"AGGREGATE_HEIGHT", weight.aggregate_height, "各列の高さの合計の重み"},
+        {"HOLES", weight.holes, "穴の数の重み"},
+        {"BUMPINESS", weight.bumpiness, "隣接列の高さの差の合計の重み"},
+    };
+    char definitions[TETRIS_TUNER_NUMBER_OF_GENES][64];
+    int width = 0;
+    for (int i = 0; i < TETRIS_TUNER_NUMBER_OF_GENES; i++)
+    {
+        int length = snprintf(definitions[i], sizeof(definitions[i]), "#define TETRIS_CORE_AI_WEIGHT_%s %d", weight_macros[i].name, weight_macros[i].value);
+        width = (width < length) ? length : width;
+    }
+    for (int i = 0; i < TETRIS_TUNER_NUMBER_OF_GENES; i++)
+    {
+        fprintf(file, "%-*s // %s\n", width, definitions[i], weight_macros[i].comment);
+    }
+    fprintf(file, "\n#endif /* __TETRIS_CORE_AI_WEIGHT_H__ */\n");
+
+    int status = (ferror(file)) ? -1 : 0;
+    if (fclose(file))
+        status = -1;
+
+    return (status) ? -1 : replace_file(temporary_path, path);
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief ファイル置き換え
+ * @param temporary_path 書き込み済みの一時ファイルパス
+ * @param path 置き換え先ファイルパス
+ * @return 0：正常終了、-1：置き換え失敗
+ */
+static int replace_file(const char *temporary_path, const char *path)
+{
+    if (rename(temporary_path, path))
+    {
+        remove(temporary_path);
+        return -1;
+    }
+
+    return 0;
+}
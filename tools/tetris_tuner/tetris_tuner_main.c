@@ -0,0 +1,254 @@
+/**
+ * @file   tetris_tuner_main.c
+ * @brief  tetris自動操作 評価重みチューナ・コマンドライン実装
+ * @details 世代毎に進捗を出力してチェックポイントを保存し、最後に最良個体の評価重みをヘッダファイルに出力する
+ *          チェックポイントから再開した場合も、同じ設定なら中断しなかった場合と同じ結果になる
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "tetris_tuner.h"
+#include "tetris_sim.h"
+#include "tetris_core.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define POPULATION_SIZE_DEFAULT 64                  // 個体数の既定値
+#define GENERATIONS_DEFAULT 20                      // 世代数の既定値
+#define GAMES_PER_INDIVIDUAL_DEFAULT 16             // 1個体あたりの評価ゲーム数の既定値
+#define FRAME_LIMIT_DEFAULT 60000                   // 1ゲームの最大フレーム数の既定値（10分）
+#define BASE_SEED_DEFAULT 1                         // ゲームシード基準値の既定値
+#define CHECKPOINT_PATH_DEFAULT "tetris_tuner.ckpt" // チェックポイントファイルパスの既定値
+
+//======================================================
+// 型定義
+//======================================================
+
+//======================================================
+// 変数・定数
+//======================================================
+static TETRIS_TUNER_state_t tuner_state; // チューナ状態（個体群が大きいため静的領域に置く）
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static void print_usage(const char *program_name);
+static double get_elapsed_seconds(const struct timespec *start_ptr);
+static void report_generation(const TETRIS_TUNER_state_t *state_ptr, double elapsed_seconds);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief メイン関数
+ * @param argc 引数の数
+ * @param argv 引数
+ * @return 終了コード
+ */
+int main(int argc, char *argv[])
+{
+    long number_of_processors = sysconf(_SC_NPROCESSORS_ONLN);
+    TETRIS_TUNER_config_t config = {
+        .population_size = POPULATION_SIZE_DEFAULT,
+        .generations = GENERATIONS_DEFAULT,
+        .games_per_individual = GAMES_PER_INDIVIDUAL_DEFAULT,
+        .frame_limit = FRAME_LIMIT_DEFAULT,
+        .number_of_threads = (0 < number_of_processors) ? (uint32_t)number_of_processors : 1,
+        .is_lookahead_enabled = false,
+        .metric = fitness_lines,
+    };
+    uint32_t base_seed = BASE_SEED_DEFAULT;
+    const char *checkpoint_path = CHECKPOINT_PATH_DEFAULT;
+    const char *header_path = NULL;
+    bool is_resume = false;
+
+    int option;
+    while ((option = getopt(argc, argv, "p:g:k:f:j:s:lm:c:ro:h")) != -1)
+    {
+        switch (option)
+        {
+        case 'p':
+            config.population_size = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'g':
+            config.generations = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'k':
+            config.games_per_individual = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'f':
+            config.frame_limit = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'j':
+            config.number_of_threads = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            base_seed = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'l':
+            config.is_lookahead_enabled = true;
+            break;
+        case 'm':
+            if (!strcmp(optarg, "lines"))
+            {
+                config.metric = fitness_lines;
+            }
+            else if (!strcmp(optarg, "score"))
+            {
+                config.metric = fitness_score;
+            }
+            else
+            {
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'c':
+            checkpoint_path = optarg;
+            break;
+        case 'r':
+            is_resume = true;
+            break;
+        case 'o':
+            header_path = optarg;
+            break;
+        case 'h':
+        default:
+            print_usage(argv[0]);
+            return (option == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (config.population_size < 2 || TETRIS_TUNER_POPULATION_MAX < config.population_size ||
+        !config.games_per_individual || !config.frame_limit || !config.number_of_threads)
+    {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // 個体群の準備（再開時はチェックポイントの個体数とシードを優先する）
+    if (is_resume)
+    {
+        if (TETRIS_TUNER_load_checkpoint(checkpoint_path, &tuner_state))
+            return EXIT_FAILURE;
+        config.population_size = tuner_state.population_size;
+        printf("resumed from %s at generation %u\n", checkpoint_path, tuner_state.generation);
+    }
+    else
+    {
+        TETRIS_TUNER_initialize_population(&tuner_state, config.population_size, base_seed, (uint64_t)base_seed * 0x9E3779B97F4A7C15ULL);
+    }
+
+    printf("population: %u  games/individual: %u  threads: %u  frame limit: %u  policy: %s  fitness: %s\n",
+           config.population_size, config.games_per_individual, config.number_of_threads, config.frame_limit,
+           (config.is_lookahead_enabled) ? "ai" : "ai-current", (fitness_score == config.metric) ? "score" : "lines");
+
+    // 世代ループ（評価 → 進捗出力 → 世代交代 → チェックポイント保存）
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (tuner_state.generation < config.generations)
+    {
+        if (TETRIS_TUNER_evaluate_population(&config, &tuner_state))
+        {
+            fprintf(stderr, "failed to evaluate population\n");
+            return EXIT_FAILURE;
+        }
+        report_generation(&tuner_state, get_elapsed_seconds(&start));
+
+        TETRIS_TUNER_evolve_population(&tuner_state);
+        if (TETRIS_TUNER_save_checkpoint(checkpoint_path, &tuner_state))
+            fprintf(stderr, "failed to save checkpoint: %s\n", checkpoint_path);
+    }
+
+    // 最終世代（世代交代直後の子個体は未評価のため評価し直す）
+    if (TETRIS_TUNER_evaluate_population(&config, &tuner_state))
+    {
+        fprintf(stderr, "failed to evaluate population\n");
+        return EXIT_FAILURE;
+    }
+    report_generation(&tuner_state, get_elapsed_seconds(&start));
+
+    if (header_path)
+    {
+        if (TETRIS_TUNER_write_weight_header(header_path, &tuner_state, &config))
+        {
+            fprintf(stderr, "failed to write %s\n", header_path);
+            return EXIT_FAILURE;
+        }
+        printf("wrote %s\n", header_path);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief 使い方表示
+ * @param program_name プログラム名
+ * @return なし
+ */
+static void print_usage(const char *program_name)
+{
+    fprintf(stderr,
+            "usage: %s [-p population] [-g generations] [-k games] [-f frame_limit] [-j threads] [-s seed] [-l] [-m lines|score]\n"
+            "          [-c checkpoint] [-r] [-o header]\n"
+            "  -p  population size, 2-%d (default %d)\n"
+            "  -g  total generations; counts the generations already in the checkpoint when resuming (default %d)\n"
+            "  -k  games per individual per generation (default %d)\n"
+            "  -f  frame limit per game, 1 frame = 10 ms (default %d)\n"
+            "  -j  worker threads (default: online CPUs)\n"
+            "  -s  seed of the game seeds and the genetic operators (default %d)\n"
+            "  -l  evaluate with the current and next mino (default: current mino only)\n"
+            "  -m  fitness metric: mean rows deleted or mean score (default lines)\n"
+            "  -c  checkpoint file written after every generation (default %s)\n"
+            "  -r  resume from the checkpoint file\n"
+            "  -o  write the best weights as src/app/tetris_core/tetris_core_ai_weight.h format\n",
+            program_name, TETRIS_TUNER_POPULATION_MAX, POPULATION_SIZE_DEFAULT, GENERATIONS_DEFAULT, GAMES_PER_INDIVIDUAL_DEFAULT,
+            FRAME_LIMIT_DEFAULT, BASE_SEED_DEFAULT, CHECKPOINT_PATH_DEFAULT);
+}
+
+/**
+ * @brief 経過時間取得
+ * @param start_ptr 計測開始時刻
+ * @return 経過時間[s]
+ */
+static double get_elapsed_seconds(const struct timespec *start_ptr)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)(now.tv_sec - start_ptr->tv_sec) + (double)(now.tv_nsec - start_ptr->tv_nsec) * 1e-9;
+}
+
+/**
+ * @brief 世代進捗出力
+ * @param state_ptr チューナ状態（評価済みであること）
+ * @param elapsed_seconds 開始からの経過時間[s]
+ * @return なし
+ */
+static void report_generation(const TETRIS_TUNER_state_t *state_ptr, double elapsed_seconds)
+{
+    double sum = 0.0;
+    for (uint32_t i = 0; i < state_ptr->population_size; i++)
+    {
+        sum += state_ptr->population[i].fitness;
+    }
+
+    const TETRIS_TUNER_individual_t *best_ptr = TETRIS_TUNER_get_best_individual(state_ptr);
+    TETRIS_CORE_ai_weight_t weight;
+    TETRIS_TUNER_convert_to_weight(best_ptr, &weight);
+    printf("generation %3u  best %10.1f  mean %10.1f  weight {%d, %d, %d, %d}  elapsed %.1f s\n",
+           state_ptr->generation, best_ptr->fitness, sum / state_ptr->population_size,
+           weight.lines, weight.aggregate_height, weight.holes, weight.bumpiness, elapsed_seconds);
+    fflush(stdout);
+}
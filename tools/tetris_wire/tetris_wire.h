@@ -0,0 +1,53 @@
+/**
+ * @file   tetris_wire.h
+ * @brief  tetris表示バス計測ツール・外部公開定義
+ * @details 実機の描画処理（tetris_display_ctrl・SH1107・I2C送信ストリーム）をそのままホスト環境でビルドし、
+ *          I2Cバス上に出るバイト列をSH1107のプロトコルに沿って解釈する（ワイヤモデル）
+ *          フレーム毎のバス転送バイト数の計測と、モデル上のパネルRAMが描画したいフレームと一致しているかの確認に使う
+ *          I2C・DMA・タイマのレジスタ操作部分だけをモデル側の代替実装に差し替える
+ *          TXアボートを疑似乱数で発生させ、アボート後の送り直しでパネルRAMが元に戻ることも確認できる
+ */
+
+#ifndef __TETRIS_WIRE_H__
+#define __TETRIS_WIRE_H__
+
+//======================================================
+// インクルード
+//======================================================
+#include "typedef.h"
+#include "bitmap_lib.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+
+//======================================================
+// 型定義
+//======================================================
+/**
+ * @brief ワイヤモデル統計定義
+ */
+typedef struct
+{
+    uint64_t bus_bytes;       /**< バス上に出たバイト数（スタート・リスタート毎のスレーブアドレスを含む） */
+    uint64_t ram_writes;      /**< パネルRAMへの書き込みバイト数 */
+    uint64_t dma_transfers;   /**< 開始されたDMA転送数 */
+    uint64_t aborts;          /**< 発生させたTXアボート数 */
+} TETRIS_WIRE_statistics_t;
+
+//======================================================
+// グローバル変数・定数extern宣言
+//======================================================
+
+//======================================================
+// グローバル関数extern宣言
+//======================================================
+/* model */
+extern void TETRIS_WIRE_initialize_model(uint32_t seed);
+extern void TETRIS_WIRE_set_abort_period(uint32_t period);
+extern void TETRIS_WIRE_drain();
+extern bool TETRIS_WIRE_check_abort_pending();
+extern bool TETRIS_WIRE_check_panel(bitmap_128_t bitmap);
+extern const TETRIS_WIRE_statistics_t *TETRIS_WIRE_get_statistics();
+
+#endif /* __TETRIS_WIRE_H__ */
@@ -0,0 +1,269 @@
+/**
+ * @file   tetris_wire_main.c
+ * @brief  tetris表示バス計測ツール・コマンドライン実装
+ * @details 自動操作でゲームを進めながら実機と同じ描画処理を毎フレーム呼び、ワイヤモデル上のバス転送量を集計する
+ *          フレーム毎に送信完了まで待ってから、モデル上のパネルRAMが描画したいフレームと一致しているか確認する
+ *          描画したいフレームはSH1107_display_bitmap_data・SH1107_display_bitmap_area_dataの引数（どちらも画面全体）を
+ *          リンク時に横取りして受け取る（--wrap）
+ *          バス転送量はドライバのSH1107_get_sent_byte_count（実機ではデバッグコマンド0x62で読める値）とも突き合わせる
+ *          TXアボートを発生させた場合は、アボートがクリアされるまで（次の描画で送り直すまで）のフレームは照合しない
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "tetris_wire.h"
+#include "tetris.h"
+#include "tetris_internal.h"
+#include "tetris_core.h"
+#include "SH1107.h"
+#include "I2C_internal.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define GAMES_DEFAULT 3             // ゲーム数の既定値
+#define FRAME_LIMIT_DEFAULT 4000    // 1ゲームの最大フレーム数の既定値（実機換算で40秒）
+#define BASE_SEED_DEFAULT 7         // シード基準値の既定値
+#define ABORT_PERIOD_DEFAULT 0      // TXアボート発生割合の既定値（発生させない）
+#define OPPONENT_SEED_OFFSET 1000   // CPU対戦の対戦相手のシード（自分のシード＋この値）
+
+//======================================================
+// 型定義
+//======================================================
+/**
+ * @brief 計測する画面定義
+ */
+typedef enum
+{
+    screen_in_game = 0, /**< ゲーム実行中（マラソン） */
+    screen_timer,       /**< ゲーム実行中（ゲームタイマ表示あり） */
+    screen_versus,      /**< CPU対戦 */
+    SCREEN_NUMBER,
+} screen_t;
+
+//======================================================
+// 変数・定数
+//======================================================
+static const char *const screen_name[SCREEN_NUMBER] = {"in_game", "timer", "versus"};
+
+static bitmap_128_t intended_bitmap; // 最後に描画を依頼されたフレーム
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+extern bool __real_SH1107_display_bitmap_data(bitmap_128_t bitmap);
+extern bool __wrap_SH1107_display_bitmap_data(bitmap_128_t bitmap);
+extern bool __real_SH1107_display_bitmap_area_data(bitmap_128_t bitmap, uint8_t column, uint8_t row, uint8_t width, uint8_t height);
+extern bool __wrap_SH1107_display_bitmap_area_data(bitmap_128_t bitmap, uint8_t column, uint8_t row, uint8_t width, uint8_t height);
+static void print_usage(const char *program_name);
+static void step_player(TETRIS_CORE_ai_player_t *player_ptr, tetris_compute_state_t *compute_state_ptr, bool is_first_frame, bool *is_game_over_ptr);
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief メイン関数
+ * @param argc 引数の数
+ * @param argv 引数
+ * @return 終了コード（パネルRAMの不一致・送信バイト数の食い違いがあればEXIT_FAILURE。TXアボート発生時は送信バイト数を突き合わせない）
+ */
+int main(int argc, char *argv[])
+{
+    uint32_t games = GAMES_DEFAULT;
+    uint32_t frame_limit = FRAME_LIMIT_DEFAULT;
+    uint32_t base_seed = BASE_SEED_DEFAULT;
+    uint32_t abort_period = ABORT_PERIOD_DEFAULT;
+    screen_t screen = screen_in_game;
+
+    int option;
+    while ((option = getopt(argc, argv, "n:f:s:a:m:h")) != -1)
+    {
+        switch (option)
+        {
+        case 'n':
+            games = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'f':
+            frame_limit = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            base_seed = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'a':
+            abort_period = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'm':
+            for (screen = 0; screen < SCREEN_NUMBER && strcmp(optarg, screen_name[screen]); screen++)
+                ;
+            if (SCREEN_NUMBER <= screen)
+            {
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'h':
+        default:
+            print_usage(argv[0]);
+            return (option == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (!games || !frame_limit)
+    {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // ディスプレイ起動（起動シーケンスの送信分は集計に含めない）
+    TETRIS_WIRE_initialize_model(base_seed);
+    i2c_initialize_TX_stream(I2C0);
+    SH1107_initialize((SH1107_config_t){.assign_I2C_ch = I2C0});
+    TETRIS_WIRE_drain();
+    TETRIS_WIRE_set_abort_period(abort_period);
+
+    uint64_t frames = 0;            // 集計対象フレーム数（各ゲームの初回フレームは全画面描画なので除く）
+    uint64_t frame_bytes_total = 0; // 集計対象フレームのバス転送バイト数の合計
+    uint64_t frame_bytes_max = 0;   // 集計対象フレームのバス転送バイト数の最大
+    uint64_t sending_frames = 0;    // バス転送があったフレーム数
+    uint64_t mismatch_frames = 0;   // パネルRAMが描画したいフレームと一致しなかったフレーム数
+    uint64_t unchecked_frames = 0;  // TXアボートがクリアされておらず照合しなかったフレーム数
+    uint64_t bus_bytes_start = TETRIS_WIRE_get_statistics()->bus_bytes;
+    uint32_t driver_bytes_start = SH1107_get_sent_byte_count();
+
+    for (uint32_t game = 0; game < games; game++)
+    {
+        tetris_compute_state_t compute_state = {0};
+        tetris_compute_state_t opponent_compute_state = {0};
+        TETRIS_CORE_ai_player_t player;
+        TETRIS_CORE_ai_player_t opponent_player;
+        tetris_game_timer_t game_timer = {0};
+
+        TETRIS_CORE_initialize(&compute_state.core_state, base_seed + game);
+        TETRIS_CORE_initialize(&opponent_compute_state.core_state, base_seed + game + OPPONENT_SEED_OFFSET);
+        TETRIS_CORE_ai_initialize_player(&player, false);
+        TETRIS_CORE_ai_initialize_player(&opponent_player, false);
+        tetris_initialize_display_ctrl();
+
+        bool is_game_over = false;
+        for (uint32_t frame = 0; frame < frame_limit && !is_game_over; frame++)
+        {
+            step_player(&player, &compute_state, (0 == frame), &is_game_over);
+            if (screen_versus == screen)
+                step_player(&opponent_player, &opponent_compute_state, (0 == frame), &is_game_over);
+            game_timer.display_centiseconds = frame;
+
+            // 描画→送信完了待ち→パネルRAM確認
+            uint64_t bus_bytes_before = TETRIS_WIRE_get_statistics()->bus_bytes;
+            if (screen_versus == screen)
+                tetris_display_ctrl_versus(&compute_state, &opponent_compute_state);
+            else
+                tetris_display_ctrl_in_game(&compute_state, (screen_timer == screen) ? &game_timer : NULL);
+            TETRIS_WIRE_drain();
+            uint64_t frame_bytes = TETRIS_WIRE_get_statistics()->bus_bytes - bus_bytes_before;
+
+            if (TETRIS_WIRE_check_abort_pending())
+                unchecked_frames++;
+            else if (!TETRIS_WIRE_check_panel(intended_bitmap))
+                mismatch_frames++;
+
+            if (frame)
+            {
+                frames++;
+                frame_bytes_total += frame_bytes;
+                frame_bytes_max = (frame_bytes_max < frame_bytes) ? frame_bytes : frame_bytes_max;
+                sending_frames += (0 != frame_bytes);
+            }
+        }
+    }
+
+    const TETRIS_WIRE_statistics_t *statistics_ptr = TETRIS_WIRE_get_statistics();
+    uint64_t bus_bytes = statistics_ptr->bus_bytes - bus_bytes_start;
+    uint32_t driver_bytes = SH1107_get_sent_byte_count() - driver_bytes_start;
+
+    printf("screen: %s  games: %u  frames: %llu  (first frame of each game excluded)\n", screen_name[screen], games, (unsigned long long)frames);
+    printf("bytes/frame: %.1f  max: %llu  sending frames: %llu\n",
+           (frames) ? (double)frame_bytes_total / frames : 0.0, (unsigned long long)frame_bytes_max, (unsigned long long)sending_frames);
+    printf("bus bytes: %llu  driver count: %u  ram writes: %llu  dma transfers: %llu\n",
+           (unsigned long long)bus_bytes, driver_bytes, (unsigned long long)statistics_ptr->ram_writes, (unsigned long long)statistics_ptr->dma_transfers);
+    printf("tx aborts: %llu  frames left unchecked after abort: %llu\n", (unsigned long long)statistics_ptr->aborts, (unsigned long long)unchecked_frames);
+    printf("panel mismatch frames: %llu\n", (unsigned long long)mismatch_frames);
+
+    // TXアボートで捨てた分はドライバでは数えるがバス上には出ないので、アボート無しの時だけ突き合わせる
+    bool is_count_matched = statistics_ptr->aborts || ((uint32_t)bus_bytes == driver_bytes);
+    if (!is_count_matched)
+        fprintf(stderr, "driver byte count differs from the bus\n");
+    return (mismatch_frames || !is_count_matched) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/**
+ * @brief 全画面描画の横取り
+ * @param bitmap 表示するビットマップ
+ * @return SH1107_display_bitmap_dataの戻り値
+ * @details 描画したいフレームを控えてから本来の描画処理を呼ぶ
+ */
+bool __wrap_SH1107_display_bitmap_data(bitmap_128_t bitmap)
+{
+    memcpy(intended_bitmap, bitmap, sizeof(bitmap_128_t));
+    return __real_SH1107_display_bitmap_data(bitmap);
+}
+
+/**
+ * @brief 領域描画の横取り
+ * @param bitmap 表示するビットマップ（画面全体。送信するのは指定範囲のみ）
+ * @param column 送信範囲の左端の列
+ * @param row 送信範囲の上端の行
+ * @param width 送信範囲の幅
+ * @param height 送信範囲の高さ
+ * @return SH1107_display_bitmap_area_dataの戻り値
+ * @details レイヤ合成は変化範囲毎に呼ぶので、最後の呼び出しで控えたビットマップがそのフレームの画面全体になる
+ */
+bool __wrap_SH1107_display_bitmap_area_data(bitmap_128_t bitmap, uint8_t column, uint8_t row, uint8_t width, uint8_t height)
+{
+    memcpy(intended_bitmap, bitmap, sizeof(bitmap_128_t));
+    return __real_SH1107_display_bitmap_area_data(bitmap, column, row, width, height);
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief 使い方表示
+ * @param program_name プログラム名
+ * @return なし
+ */
+static void print_usage(const char *program_name)
+{
+    fprintf(stderr,
+            "usage: %s [-n games] [-f frame_limit] [-s base_seed] [-a abort_period] [-m in_game|timer|versus]\n"
+            "  -n  games; game i uses base_seed + i (default %d)\n"
+            "  -f  frame limit per game, 1 frame = 10 ms (default %d)\n"
+            "  -s  seed of the first game, also seeds the DMA completion and TX abort timing (default %d)\n"
+            "  -a  inject a TX abort once per this many bus bytes on average, 0 = none (default %d)\n"
+            "  -m  screen to draw (default in_game)\n",
+            program_name, GAMES_DEFAULT, FRAME_LIMIT_DEFAULT, BASE_SEED_DEFAULT, ABORT_PERIOD_DEFAULT);
+}
+
+/**
+ * @brief 自動操作で1フレーム進める
+ * @param player_ptr 自動操作プレイヤー状態
+ * @param compute_state_ptr 演算状態
+ * @param is_first_frame ゲームの初回フレーム（必ず描画させる）
+ * @param is_game_over_ptr ゲームオーバーになったらtrueを設定する
+ * @return なし
+ */
+static void step_player(TETRIS_CORE_ai_player_t *player_ptr, tetris_compute_state_t *compute_state_ptr, bool is_first_frame, bool *is_game_over_ptr)
+{
+    TETRIS_CORE_input_t input;
+
+    TETRIS_CORE_ai_decide_input(player_ptr, &compute_state_ptr->core_state, &TETRIS_CORE_ai_weight_default, &input);
+    TETRIS_CORE_step_result_t step_result = TETRIS_CORE_step(&compute_state_ptr->core_state, &input);
+    compute_state_ptr->is_display_changed = is_first_frame || (core_idle != step_result);
+    if (core_game_over == step_result)
+        *is_game_over_ptr = true;
+}
@@ -0,0 +1,410 @@
+/**
+ * @file   tetris_wire_model.c
+ * @brief  tetris表示バス計測ツール・ワイヤモデル実装
+ * @details I2Cドライバのレジスタ操作部分（I2C_ops.c）・DMAドライバ・タイマドライバの代わりに本ファイルの関数をリンクする
+ *          送信ストリーム（I2C_ctrl.c）が開始したDMA転送は即座には進めず、送信ストリームへの書き込みの途中や
+ *          送信待ちの間に疑似乱数のタイミングで完了させる（描画と転送が並行する実機の状況を模擬する）
+ *          転送されたIC_DATA_CMDはバス上のバイトとして数え、SH1107のコントロールバイト・アドレス設定コマンドを解釈して
+ *          パネルRAMに書き込む（その他のコマンドとその引数は数えるだけで解釈しない）
+ *          TXアボートは送信するバイト毎に指定割合で発生させる。発生したバイト以降は送られず、バスはストップ後に戻り、
+ *          アボートがクリアされるまでDMA転送は進まない（実機でTX FIFOがフラッシュされたまま止まる状況を模擬する）
+ */
+
+//======================================================
+// インクルード
+//======================================================
+#include "tetris_wire.h"
+#include "I2C.h"
+#include "I2C_internal.h"
+#include "dma.h"
+#include "timer.h"
+#include "typedef.h"
+
+//======================================================
+// マクロ定義
+//======================================================
+#define PANEL_PAGES 16    // パネルRAMのページ数（1ページ＝縦8ドット）
+#define PANEL_COLUMNS 128 // パネルRAMの列数
+
+#define DMA_COMPLETE_PERIOD 8 // 送信ストリームへの書き込み何回に1回の割合でDMA転送を完了させるか
+#define TIME_STEP_US 1000     // TIMER_get_time_us呼び出し毎に進める時間[us]
+
+// IC_DATA_CMDのビット配置（i2c_make_master_data_cmdと同じ）
+#define DATA_CMD_DATA_MASK 0xFF
+#define DATA_CMD_STOP_BIT 9
+#define DATA_CMD_RESTART_BIT 10
+
+// SH1107コントロールバイト・コマンド
+#define CONTROL_CO_BIT 7              // 0：最後のコントロールバイト（以降はデータのみ）
+#define CONTROL_DC_BIT 6              // 1：RAMデータ、0：コマンド
+#define COMMAND_COLUMN_LOWER_LAST 0x0F // 列アドレス下位4bit設定（0x00～0x0F）
+#define COMMAND_COLUMN_HIGHER_FIRST 0x10
+#define COMMAND_COLUMN_HIGHER_LAST 0x17 // 列アドレス上位3bit設定（0x10～0x17）
+#define COMMAND_PAGE_FIRST 0xB0
+#define COMMAND_PAGE_LAST 0xBF // ページアドレス設定（0xB0～0xBF）
+
+//======================================================
+// 型定義
+//======================================================
+/**
+ * @brief SH1107受信状態定義
+ */
+typedef struct
+{
+    uint8_t ram[PANEL_PAGES][PANEL_COLUMNS]; /**< パネルRAM */
+    uint8_t page;                            /**< 書き込みページ */
+    uint8_t column;                          /**< 書き込み列 */
+    bool is_bus_idle;                        /**< ストップ後（次のバイトはスタートから始まる） */
+    bool is_control_expected;                /**< 次のバイトがコントロールバイト */
+    bool is_data_stream;                     /**< 最後のコントロールバイトの後（以降はデータのみ） */
+    bool is_RAM_data;                        /**< データがRAMデータ */
+} panel_state_t;
+
+/**
+ * @brief DMA転送状態定義
+ */
+typedef struct
+{
+    DMA_transfer_config_t config;         /**< 転送中の設定 */
+    uint32_t transferred_count;           /**< 転送中の設定のうちバスへ送り終えた数 */
+    bool is_busy;                         /**< 転送中 */
+    DMA_callback_func_pointer_t callback; /**< 完了コールバック */
+} dma_state_t;
+
+//======================================================
+// 変数・定数
+//======================================================
+static panel_state_t panel;                  // SH1107受信状態
+static dma_state_t dma;                      // DMA転送状態（送信ストリームが使う1チャネルのみ）
+static volatile uint32_t data_cmd_register;  // IC_DATA_CMDの代わりのDMA転送先（値は使わない）
+static TETRIS_WIRE_statistics_t statistics;  // ワイヤモデル統計
+static uint32_t random_state;                // DMA完了タイミングの疑似乱数状態
+static uint64_t time_us;                     // モデル上の現在時刻[us]
+static uint32_t abort_period;                // TXアボートを送信何バイトに1回の割合で発生させるか（0：発生させない）
+static bool is_TX_abrt;                      // TXアボート発生中（I2C_clear_TX_abrtまで）
+
+//======================================================
+// プロトタイプ宣言
+//======================================================
+static void complete_dma_transfer();
+static void receive_bus_byte(uint16_t data_cmd);
+static uint32_t get_random_value();
+
+//======================================================
+// 公開関数定義
+//======================================================
+/**
+ * @brief ワイヤモデル初期化
+ * @param seed DMA完了タイミングの疑似乱数シード
+ * @return なし
+ * @details パネルRAMは0（全消灯）、バスはストップ後の状態から始める
+ */
+void TETRIS_WIRE_initialize_model(uint32_t seed)
+{
+    panel = (panel_state_t){.is_bus_idle = true};
+    dma = (dma_state_t){0};
+    statistics = (TETRIS_WIRE_statistics_t){0};
+    random_state = (seed) ? seed : 1;
+    time_us = 0;
+    abort_period = 0;
+    is_TX_abrt = false;
+}
+
+/**
+ * @brief TXアボート発生割合設定
+ * @param period 送信何バイトに1回の割合でTXアボートを発生させるか（0：発生させない）
+ * @return なし
+ * @details 起動シーケンスの送信後に設定する
+ */
+void TETRIS_WIRE_set_abort_period(uint32_t period)
+{
+    abort_period = period;
+}
+
+/**
+ * @brief 送信完了待ち
+ * @return なし
+ * @details 送信ストリームに書き込まれた分を全てバスへ送り終えるまでDMA転送を完了させ続ける
+ *          TXアボートが発生したら残りは送られないので待たずに返る（次の描画で送り直される）
+ */
+void TETRIS_WIRE_drain()
+{
+    I2C_flush_TX_stream(I2C0);
+    while (I2C_check_TX_stream_busy(I2C0) && !is_TX_abrt)
+        complete_dma_transfer();
+}
+
+/**
+ * @brief TXアボート発生中判定
+ * @return true：TXアボートがまだクリアされていない（パネルRAMは次の描画での送り直しまで不定）
+ */
+bool TETRIS_WIRE_check_abort_pending()
+{
+    return is_TX_abrt;
+}
+
+/**
+ * @brief パネルRAM一致確認
+ * @param bitmap 表示したいビットマップ
+ * @return true：モデル上のパネルRAMがビットマップと一致
+ * @details ページバイトのbit0がページ内の最上段（SH1107のRAM配置）
+ */
+bool TETRIS_WIRE_check_panel(bitmap_128_t bitmap)
+{
+    for (uint8_t page = 0; page < PANEL_PAGES; page++)
+    {
+        for (uint8_t column = 0; column < PANEL_COLUMNS; column++)
+        {
+            uint8_t page_byte = 0;
+            for (uint8_t bit = 0; bit < 8; bit++)
+                page_byte |= (uint8_t)(((bitmap[page * 8 + bit][column / 64] >> (63 - column % 64)) & 1) << bit);
+
+            if (page_byte != panel.ram[page][column])
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief ワイヤモデル統計取得
+ * @return 初期化からの累計
+ */
+const TETRIS_WIRE_statistics_t *TETRIS_WIRE_get_statistics()
+{
+    return &statistics;
+}
+
+/* ---- DMAドライバの代替 ---- */
+
+/**
+ * @brief DMA転送開始（代替）
+ * @param config_ptr 転送設定
+ * @param ch DMAチャネル
+ * @return なし
+ * @details 設定を保持するだけで、転送は完了させるタイミングでまとめて行う
+ */
+void DMA_start_transfer(const DMA_transfer_config_t *config_ptr, DMA_ch_t ch)
+{
+    (void)ch;
+    dma.config = *config_ptr;
+    dma.transferred_count = 0;
+    dma.is_busy = true;
+    statistics.dma_transfers++;
+}
+
+bool DMA_check_busy(DMA_ch_t ch)
+{
+    (void)ch;
+    return dma.is_busy;
+}
+
+void DMA_abort_transfer(DMA_ch_t ch)
+{
+    (void)ch;
+    dma.is_busy = false;
+}
+
+void DMA_enable_complete_interrupt(bool is_enable, DMA_ch_t ch)
+{
+    (void)is_enable;
+    (void)ch;
+}
+
+void DMA_set_complete_callback_function(DMA_callback_func_pointer_t callback_func, DMA_ch_t ch)
+{
+    (void)ch;
+    dma.callback = callback_func;
+}
+
+/* ---- I2Cドライバ（レジスタ操作部分）の代替 ---- */
+
+/**
+ * @brief IC_DATA_CMD書き込み値生成（代替）
+ * @param data 送信データ
+ * @param master_cmd マスター送信コマンド種別
+ * @param condition STOP/RESTART制御
+ * @return IC_DATA_CMDへの書き込み値
+ * @details 実機と同じ値を返す。送信ストリームへの書き込み毎に呼ばれるので、ここで時々DMA転送を完了させる
+ */
+uint16_t i2c_make_master_data_cmd(uint8_t data, I2C_master_cmd_t master_cmd, I2C_condition_control_t condition)
+{
+    bool is_stop = (stop_condition == condition || restart_and_stop_condition == condition);
+    bool is_restart = (restart_condition == condition || restart_and_stop_condition == condition);
+
+    if (0 == get_random_value() % DMA_COMPLETE_PERIOD)
+        complete_dma_transfer();
+
+    return (uint16_t)(data | (master_cmd << 8) | (is_stop << DATA_CMD_STOP_BIT) | (is_restart << DATA_CMD_RESTART_BIT));
+}
+
+volatile uint32_t *i2c_get_data_cmd_address(I2C_ch_t ch)
+{
+    (void)ch;
+    return &data_cmd_register;
+}
+
+/**
+ * @brief TX FIFOデータ数取得（代替）
+ * @param ch 対象I2Cチャネル
+ * @return 常に0（DMA転送を完了させた時点でバスへ送り終えた扱い）
+ * @details 送信待ちのループから呼ばれるので、ここでもDMA転送を完了させて待ちを進める
+ */
+uint8_t I2C_read_TX_fifo_level(I2C_ch_t ch)
+{
+    (void)ch;
+    complete_dma_transfer();
+    return 0;
+}
+
+bool I2C_read_TX_abrt(I2C_ch_t ch)
+{
+    (void)ch;
+    complete_dma_transfer();
+    return is_TX_abrt;
+}
+
+void I2C_clear_TX_abrt(I2C_ch_t ch)
+{
+    (void)ch;
+    is_TX_abrt = false;
+}
+
+uint8_t I2C_read_RX_fifo_level(I2C_ch_t ch)
+{
+    (void)ch;
+    return 0;
+}
+
+uint8_t I2C_read_RX_FIFO_data(I2C_ch_t ch)
+{
+    (void)ch;
+    return 0;
+}
+
+bool i2c_check_rd_req(I2C_ch_t ch)
+{
+    (void)ch;
+    return false;
+}
+
+void i2c_clear_rd_req(I2C_ch_t ch)
+{
+    (void)ch;
+}
+
+void I2C_set_TX_FIFO_data_slave(I2C_ch_t ch, uint8_t data)
+{
+    (void)ch;
+    (void)data;
+}
+
+/* ---- タイマドライバの代替 ---- */
+
+/**
+ * @brief 現在時刻取得（代替）
+ * @return 呼び出し毎にTIME_STEP_USずつ進む時刻[us]
+ */
+uint64_t TIMER_get_time_us()
+{
+    return time_us += TIME_STEP_US;
+}
+
+void TIMER_wait_ms(uint64_t ms)
+{
+    time_us += ms * 1000;
+}
+
+//======================================================
+// 内部関数定義
+//======================================================
+/**
+ * @brief DMA転送完了
+ * @return なし
+ * @details 転送中の区間を全てバスへ送り、完了コールバックを呼ぶ（コールバック内で次の転送が開始されることがある）
+ *          TXアボート発生中は何も送らない。送信中にTXアボートを発生させた場合はそのバイト以降を送らずに止める
+ */
+static void complete_dma_transfer()
+{
+    if (!dma.is_busy || is_TX_abrt)
+        return;
+
+    const volatile uint16_t *data_cmd_ptr = (const volatile uint16_t *)dma.config.read_address;
+    for (; dma.transferred_count < dma.config.transfer_count; dma.transferred_count++)
+    {
+        if (abort_period && 0 == get_random_value() % abort_period)
+        {
+            // 送信しかけたバイトはNACKで受け取られず、マスターがストップを出して止まる
+            is_TX_abrt = true;
+            panel.is_bus_idle = true;
+            statistics.aborts++;
+            return;
+        }
+        receive_bus_byte(data_cmd_ptr[dma.transferred_count]);
+    }
+
+    dma.is_busy = false;
+    if (dma.callback)
+        dma.callback();
+}
+
+/**
+ * @brief バス上の1バイト受信
+ * @param data_cmd IC_DATA_CMDへの書き込み値
+ * @return なし
+ * @details スタート・リスタート時はスレーブアドレスの1バイトも数え、次のバイトをコントロールバイトとして扱う
+ */
+static void receive_bus_byte(uint16_t data_cmd)
+{
+    uint8_t data = (uint8_t)(data_cmd & DATA_CMD_DATA_MASK);
+    bool is_stop = (data_cmd >> DATA_CMD_STOP_BIT) & 1;
+    bool is_restart = (data_cmd >> DATA_CMD_RESTART_BIT) & 1;
+
+    if (panel.is_bus_idle || is_restart)
+    {
+        statistics.bus_bytes++; // スレーブアドレス
+        panel.is_bus_idle = false;
+        panel.is_control_expected = true;
+        panel.is_data_stream = false;
+    }
+    statistics.bus_bytes++;
+
+    if (panel.is_control_expected)
+    {
+        panel.is_data_stream = !((data >> CONTROL_CO_BIT) & 1);
+        panel.is_RAM_data = (data >> CONTROL_DC_BIT) & 1;
+        panel.is_control_expected = false;
+    }
+    else
+    {
+        if (panel.is_RAM_data)
+        {
+            panel.ram[panel.page][panel.column] = data;
+            panel.column = (panel.column + 1) % PANEL_COLUMNS;
+            statistics.ram_writes++;
+        }
+        else if (data <= COMMAND_COLUMN_LOWER_LAST)
+            panel.column = (panel.column & 0x70) | data;
+        else if (COMMAND_COLUMN_HIGHER_FIRST <= data && data <= COMMAND_COLUMN_HIGHER_LAST)
+            panel.column = (panel.column & 0x0F) | ((data & 0x07) << 4);
+        else if (COMMAND_PAGE_FIRST <= data && data <= COMMAND_PAGE_LAST)
+            panel.page = data & 0x0F;
+
+        panel.is_control_expected = !panel.is_data_stream;
+    }
+
+    if (is_stop)
+        panel.is_bus_idle = true;
+}
+
+/**
+ * @brief 疑似乱数取得
+ * @return 疑似乱数（xorshift32）
+ */
+static uint32_t get_random_value()
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}